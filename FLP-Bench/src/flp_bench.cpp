@@ -0,0 +1,500 @@
+#include <cstdio>     // printf, fputs
+#include <filesystem> // path, temp_directory_path
+#include <chrono>     // steady_clock
+#include <cstdint>    // uint64_t
+#include <cstring>    // memcpy
+#include <cwchar>     // wcstoull
+#include <limits>     // numeric_limits
+#include <algorithm>  // sort, max, min
+#include <string>     // string, u16string
+#include <string_view> // string_view
+#include <vector>     // vector
+#include <span>       // span
+
+#include "flp_stream.h"
+#include "flp_view_stream.h"
+#include "flp_out_stream.h"
+#include "flp_payload_arena.h"
+
+#include "argparse.h"
+#include "json.h"
+#include "cfile.h"
+#include "buffered_in_file.h"
+#include "sinks.h"
+#include "version.h"
+#include "wide_main.h"
+
+#include "synthetic_flp.h"
+
+
+using namespace Om;
+
+// printf format of std::filesystem::path::c_str()
+#ifdef _WIN32
+#define OM_PATH_FORMAT "%ls"
+#else
+#define OM_PATH_FORMAT "%s"
+#endif
+
+struct ProgramOptions {
+	std::filesystem::path input_path {};  // benchmark this file instead of a synthetic one
+	std::filesystem::path output_path {}; // only write the synthetic project
+	SyntheticFLPOptions synthetic {};
+	std::size_t n_iterations = 10;
+	std::string filter {};                // run only benchmarks whose name contains it
+};
+
+// FLPInStream stream type over memory, so that the reader is measured
+// without any file I/O
+class MemoryInFile {
+public:
+	explicit MemoryInFile(std::span<std::byte const> data) noexcept :
+		m_position { data.data() },
+		m_end { data.data() + data.size() } {
+	}
+
+	template<typename OutT>
+	bool read(OutT* target) noexcept {
+		return read(target, 1) == 1;
+	}
+
+	template<typename OutT>
+	std::size_t read(OutT target[], std::size_t num_elems) noexcept {
+		std::size_t const n = std::min(num_elems, available() / sizeof(OutT));
+		std::memcpy(target, m_position, n * sizeof(OutT));
+		m_position += n * sizeof(OutT);
+		return n;
+	}
+
+	bool skip(std::size_t size) noexcept {
+		if(size > available())
+			return false;
+		m_position += size;
+		return true;
+	}
+
+	bool error() const noexcept {
+		return false;
+	}
+
+	static char const* errmsg(bool) noexcept {
+		return "Unexpected end of file!";
+	}
+
+private:
+	std::size_t available() const noexcept {
+		return static_cast<std::size_t>(m_end - m_position);
+	}
+
+	std::byte const* m_position;
+	std::byte const* m_end;
+};
+
+// output stream for JSONOutStream that only counts, so that serializing is
+// measured without writing
+class CountingSink {
+public:
+	void write(char const*, std::size_t size) noexcept {
+		m_size += size;
+	}
+
+	std::uint64_t size() const noexcept {
+		return m_size;
+	}
+
+private:
+	std::uint64_t m_size = 0;
+};
+
+// what one run of a benchmark processed
+struct BenchWork {
+	std::uint64_t bytes = 0;
+	std::uint64_t events = 0;
+	std::uint64_t check = 0; // derived from the results so that nothing is optimized away
+};
+
+// Runs every benchmark once to warm up and then n_iterations times. The
+// best run decides the throughput, it is the least disturbed by the rest
+// of the system, the median shows how stable the results are.
+class BenchRunner {
+public:
+	BenchRunner(std::size_t n_iterations, std::string filter) :
+		m_n_iterations { std::max<std::size_t>(n_iterations, 1) },
+		m_filter { std::move(filter) } {
+		std::printf("%-28s %10s %10s %10s %10s\n", "benchmark", "best ms", "median ms", "MB/s", "Mevents/s");
+	}
+
+	template<typename F>
+	void run(std::string_view name, F const& f) {
+		if(name.find(m_filter) == std::string_view::npos)
+			return;
+		using clock = std::chrono::steady_clock;
+
+		BenchWork work = f();
+		m_check += work.check;
+		std::vector<double> seconds;
+		for(std::size_t i = 0; i < m_n_iterations; ++i) {
+			auto const begin_time = clock::now();
+			work = f();
+			auto const end_time = clock::now();
+			m_check += work.check;
+			seconds.push_back(std::chrono::duration<double>(end_time - begin_time).count());
+		}
+		std::sort(seconds.begin(), seconds.end());
+		double const best = seconds.front();
+		double const median = seconds[seconds.size() / 2];
+		std::printf("%-28.*s %10.3f %10.3f %10.1f %10.2f\n",
+		            static_cast<int>(name.size()), name.data(),
+		            best * 1e3, median * 1e3,
+		            best > 0 ? static_cast<double>(work.bytes) / (1024.0 * 1024.0) / best : 0.0,
+		            best > 0 ? static_cast<double>(work.events) / 1e6 / best : 0.0);
+	}
+
+	std::uint64_t check() const noexcept {
+		return m_check;
+	}
+
+private:
+	std::size_t m_n_iterations;
+	std::string m_filter;
+	std::uint64_t m_check = 0;
+};
+
+template<typename FLPStreamT>
+static BenchWork read_events(FLPStreamT& flp, std::size_t file_size) {
+	BenchWork work { file_size, 0, 0 };
+	for(; flp.has_event(); ++flp) {
+		FLPEventView const& e = flp->view();
+		++work.events;
+		work.check += static_cast<std::uint8_t>(e.type) + e.data.size();
+	}
+	return work;
+}
+
+// the same document flp_to_json writes
+template<typename FormatT, typename FLPStreamT, typename SinkT>
+static std::uint64_t convert_to_json(FLPStreamT& flp, SinkT& sink) {
+	std::uint64_t n_events = 0;
+	JSONOutStream<SinkT, FormatT> json_stream(sink);
+	json_stream.begin_object();
+	json_stream.key("header");
+	stream_flp_header(json_stream, flp.file_header());
+	json_stream.key("events");
+	json_stream.begin_array();
+	bool is_unicode = false;
+	for(; flp.has_event(); ++flp) {
+		FLPEventView const& event = flp->view();
+		stream_flp_event<false>(json_stream, event);
+		++n_events;
+		if(event.type == FLPEventType::FLP_Version) {
+			is_unicode = Version(reinterpret_cast<char const*>(event.data.data())) >= "12.0.0";
+			++flp;
+			break;
+		}
+	}
+	for(; flp.has_event(); ++flp) {
+		if(is_unicode)
+			stream_flp_event<true>(json_stream, flp->view());
+		else
+			stream_flp_event<false>(json_stream, flp->view());
+		++n_events;
+	}
+	json_stream.end_array();
+	json_stream.end_object();
+	json_stream.flush();
+	return n_events;
+}
+
+// payloads of the events the serializer benchmarks work on
+struct EventSets {
+	std::vector<FLPEventView> all;
+	std::vector<FLPEventView> bytes;
+	std::vector<FLPEventView> notes;
+	std::vector<std::string> utf8_strings;
+	std::vector<std::u16string> utf16_strings;
+};
+
+static EventSets collect_events(std::span<std::byte const> file_data) {
+	EventSets sets;
+	bool is_unicode = false;
+	for(FLPViewInStream flp(file_data); flp.has_event(); ++flp) {
+		FLPEventView const& e = *flp;
+		sets.all.push_back(e);
+		switch(detail::payload_kind(e.type)) {
+		case detail::PayloadKind::ansi_string:
+			if(e.type == FLPEventType::FLP_Version && !e.data.empty() && e.data.back() == std::byte { 0 })
+				is_unicode = Version(reinterpret_cast<char const*>(e.data.data())) >= "12.0.0";
+			break;
+		case detail::PayloadKind::string:
+		{
+			if(!is_unicode) {
+				sets.utf8_strings.emplace_back(reinterpret_cast<char const*>(e.data.data()), e.data.size());
+				break;
+			}
+			std::u16string text(e.data.size() / sizeof(char16_t), u'\0');
+			std::memcpy(text.data(), e.data.data(), text.size() * sizeof(char16_t));
+			if(!text.empty() && text.back() == u'\0')
+				text.pop_back();
+			std::string utf8;
+			if(!utf16_to_utf8(text, &utf8))
+				sets.utf8_strings.push_back(std::move(utf8));
+			sets.utf16_strings.push_back(std::move(text));
+			break;
+		}
+		case detail::PayloadKind::pattern_notes:
+			sets.notes.push_back(e);
+			break;
+		case detail::PayloadKind::bytes:
+			if(static_cast<std::uint8_t>(e.type) / 64 == 3)
+				sets.bytes.push_back(e);
+			break;
+		default:
+			break;
+		}
+	}
+	return sets;
+}
+
+template<typename T>
+static std::uint64_t total_payload_size(std::vector<T> const& items) {
+	std::uint64_t size = 0;
+	for(T const& item : items) {
+		if constexpr(std::is_same_v<T, FLPEventView>)
+			size += item.data.size();
+		else
+			size += item.size() * sizeof(typename T::value_type);
+	}
+	return size;
+}
+
+template<typename F>
+static BenchWork bench_events(std::vector<FLPEventView> const& events, F const& stream_event) {
+	CountingSink sink;
+	{
+		JSONOutStream<CountingSink, JSONCompactFormat> json_stream(sink);
+		json_stream.begin_array();
+		for(FLPEventView const& e : events) {
+			json_stream.begin_object();
+			stream_event(json_stream, e);
+			json_stream.end_object();
+		}
+		json_stream.end_array();
+		json_stream.flush();
+	}
+	return { total_payload_size(events), events.size(), sink.size() };
+}
+
+// strings are short, they are repeated up to about 1 MB per run
+template<typename StringT>
+static BenchWork bench_strings(std::vector<StringT> const& strings) {
+	std::uint64_t const size = total_payload_size(strings);
+	std::size_t const n_repeats = size == 0 ? 1 : static_cast<std::size_t>(std::max<std::uint64_t>(1, (1 << 20) / size));
+	CountingSink sink;
+	{
+		JSONOutStream<CountingSink, JSONCompactFormat> json_stream(sink);
+		json_stream.begin_array();
+		for(std::size_t i = 0; i < n_repeats; ++i) {
+			for(StringT const& s : strings) {
+				json_stream.value(std::basic_string_view<typename StringT::value_type>(s));
+			}
+		}
+		json_stream.end_array();
+		json_stream.flush();
+	}
+	return { size * n_repeats, strings.size() * n_repeats, sink.size() };
+}
+
+static void run_benchmarks(std::span<std::byte const> file_data, ProgramOptions const& program_args) {
+	namespace fs = std::filesystem;
+
+	// the file backends read a copy in the temp directory
+	fs::path const flp_path = fs::temp_directory_path() / "flp-bench.flp";
+	fs::path const json_path = fs::temp_directory_path() / "flp-bench.flp.json";
+	{
+		Om::CFile out(Om::open_file(flp_path, "wb"));
+		if(!out.is_open() || out.write(file_data.data(), file_data.size()) != file_data.size())
+			throw std::runtime_error("could not write the temporary file");
+	}
+
+	EventSets const sets = collect_events(file_data);
+	std::printf("%zu events, %.1f MB, %zu byte events, %zu pattern events, %zu strings\n\n",
+	            sets.all.size(), static_cast<double>(file_data.size()) / (1024.0 * 1024.0),
+	            sets.bytes.size(), sets.notes.size(), sets.utf8_strings.size());
+
+	BenchRunner runner(program_args.n_iterations, program_args.filter);
+
+	// stream backends
+	runner.run("read/memory", [&] {
+		FLPInStream<MemoryInFile> flp(file_data);
+		return read_events(flp, file_data.size());
+	});
+	runner.run("read/memory-arena", [&] {
+		FLPInStream<MemoryInFile> flp(file_data);
+		FLPPayloadArena arena;
+		flp.use_payload_arena(&arena);
+		return read_events(flp, file_data.size());
+	});
+	runner.run("read/buffered-file", [&] {
+		FLPInStream<Om::BufferedInFile> flp(Om::open_file(flp_path, "rb"));
+		FLPPayloadArena arena;
+		flp.use_payload_arena(&arena);
+		return read_events(flp, file_data.size());
+	});
+	runner.run("read/view", [&] {
+		FLPViewInStream flp(file_data);
+		return read_events(flp, file_data.size());
+	});
+	runner.run("read/mapped-file", [&] {
+		FLPMappedInStream flp(flp_path);
+		return read_events(flp, file_data.size());
+	});
+
+	// serializers
+	for(FLPDataEncoding encoding : { FLPDataEncoding::hex, FLPDataEncoding::base64 }) {
+		FLPStreamOptions const options { encoding, nullptr, FLPRecordLayout::rows };
+		runner.run(std::string("stream_bytes/") + data_encoding_name(encoding), [&] {
+			return bench_events(sets.bytes, [&](auto& json_stream, FLPEventView const& e) {
+				detail::stream_bytes(json_stream, e, options);
+			});
+		});
+	}
+	runner.run("json_escape/utf8", [&] {
+		return bench_strings(sets.utf8_strings);
+	});
+	runner.run("json_escape/utf16", [&] {
+		return bench_strings(sets.utf16_strings);
+	});
+	for(FLPRecordLayout layout : { FLPRecordLayout::rows, FLPRecordLayout::columns }) {
+		runner.run(std::string("stream_pattern_notes/") + record_layout_name(layout), [&] {
+			return bench_events(sets.notes, [&](auto& json_stream, FLPEventView const& e) {
+				detail::stream_pattern_notes(json_stream, e, layout);
+			});
+		});
+	}
+
+	// end to end
+	runner.run("convert/pretty", [&] {
+		FLPViewInStream flp(file_data);
+		CountingSink sink;
+		std::uint64_t const n_events = convert_to_json<JSONPrettyFormat>(flp, sink);
+		return BenchWork { file_data.size(), n_events, sink.size() };
+	});
+	runner.run("convert/compact", [&] {
+		FLPViewInStream flp(file_data);
+		CountingSink sink;
+		std::uint64_t const n_events = convert_to_json<JSONCompactFormat>(flp, sink);
+		return BenchWork { file_data.size(), n_events, sink.size() };
+	});
+	runner.run("convert/file", [&] {
+		FLPMappedInStream flp(flp_path);
+		Om::FdSink out = Om::FdSink::open(json_path);
+		if(!out.is_open())
+			throw std::runtime_error("could not open the temporary json file");
+		std::uint64_t const n_events = convert_to_json<JSONPrettyFormat>(flp, out);
+		return BenchWork { file_data.size(), n_events, n_events };
+	});
+
+	std::error_code err;
+	fs::remove(flp_path, err);
+	fs::remove(json_path, err);
+	std::printf("\ncheck: %016llx\n", static_cast<unsigned long long>(runner.check()));
+}
+
+static void print_usage() {
+	std::fputs(
+		"FLP-Bench [--channels <n>] [--patterns <n>] [--notes <n>] [--clips <n>] [--blob-size <bytes>] [--seed <n>]\n"
+		"          [-n <iterations>] [--filter <text>] [-o <synthetic.flp> | <file.flp>]\n",
+		stderr);
+}
+
+static ProgramOptions get_program_options(int argc, wchar_t* argv[]) {
+	auto write_path_arg = [](std::filesystem::path& p) -> std::function<void(wchar_t const*)> {
+		return [&p] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			p = arg;
+		};
+	};
+
+	auto write_number_arg = []<typename T>(T& n) -> std::function<void(wchar_t const*)> {
+		return [&n] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			wchar_t* end;
+			unsigned long long const value = std::wcstoull(arg, &end, 10);
+			if(*end != L'\0' || value > std::numeric_limits<T>::max())
+				throw std::runtime_error("invalid number argument");
+			n = static_cast<T>(value);
+		};
+	};
+
+	ProgramOptions program_args {};
+	Om::ArgHandlerMap<wchar_t> const arg_handlers = {
+		{L"o",           write_path_arg(program_args.output_path)},
+		{L"channels",    write_number_arg(program_args.synthetic.n_channels)},
+		{L"patterns",    write_number_arg(program_args.synthetic.n_patterns)},
+		{L"notes",       write_number_arg(program_args.synthetic.n_notes)},
+		{L"clips",       write_number_arg(program_args.synthetic.n_clips)},
+		{L"blob-size",   write_number_arg(program_args.synthetic.plugin_blob_size)},
+		{L"seed",        write_number_arg(program_args.synthetic.seed)},
+		{L"n",           write_number_arg(program_args.n_iterations)},
+		{L"filter",      [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			std::u8string const filter = std::filesystem::path(arg).u8string();
+			program_args.filter.assign(filter.begin(), filter.end());
+		}},
+		{L"",            write_path_arg(program_args.input_path) }
+	};
+
+	Om::parse_args<wchar_t>(argc, argv, arg_handlers);
+	return program_args;
+}
+
+int wmain(int argc, wchar_t* argv[]) {
+	ProgramOptions program_args;
+	try {
+		program_args = get_program_options(argc, argv);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, "Invalid arguments: %s\n", e.what());
+		print_usage();
+		return EXIT_FAILURE;
+	}
+
+	if(!program_args.output_path.empty()) {
+		FLPOutStream<Om::CFile> flp(Om::open_file(program_args.output_path, "wb"));
+		if(!flp.stream().is_open()) {
+			std::fputs("Could not open output file! - Exiting\n", stderr);
+			return EXIT_FAILURE;
+		}
+		write_synthetic_flp(flp, program_args.synthetic);
+		std::printf("Output file: " OM_PATH_FORMAT "\n", program_args.output_path.c_str());
+		return EXIT_SUCCESS;
+	}
+
+	if(!program_args.input_path.empty()) {
+		Om::MappedFile input;
+		if(std::error_code err = input.open(program_args.input_path)) {
+			std::fprintf(stderr, "Could not open input file: %s\n", err.message().c_str());
+			return EXIT_FAILURE;
+		}
+		std::printf("Input file: " OM_PATH_FORMAT "\n", program_args.input_path.c_str());
+		run_benchmarks(input.data(), program_args);
+		return EXIT_SUCCESS;
+	}
+
+	FLPOutStream<MemoryOutFile> flp;
+	write_synthetic_flp(flp, program_args.synthetic);
+	SyntheticFLPOptions const& synthetic = program_args.synthetic;
+	std::printf("Synthetic project: %u channels, %u patterns of %u notes, %u clips, %u byte plugin states, seed %llu\n",
+	            synthetic.n_channels, synthetic.n_patterns, synthetic.n_notes, synthetic.n_clips,
+	            synthetic.plugin_blob_size, static_cast<unsigned long long>(synthetic.seed));
+	run_benchmarks(flp.stream().data(), program_args);
+	return EXIT_SUCCESS;
+}
+
+#ifndef _WIN32
+int main(int argc, char* argv[]) {
+	return Om::call_wmain(argc, argv, wmain);
+}
+#endif
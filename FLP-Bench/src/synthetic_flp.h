@@ -0,0 +1,211 @@
+#pragma once
+
+#include "flp_out_stream.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace Om {
+
+// Shape of a generated project. The defaults are a mid-sized song of
+// about 2.5 MB.
+struct SyntheticFLPOptions {
+	std::uint32_t n_channels = 64;
+	std::uint32_t n_patterns = 200;
+	std::uint32_t n_notes = 256;              // per pattern
+	std::uint32_t n_clips = 2000;             // in the playlist
+	std::uint32_t plugin_blob_size = 16384;   // plugin state of every channel
+	std::uint64_t seed = 1;
+};
+
+// SplitMix64, unlike the std distributions it gives the same numbers on
+// every platform, so a seed always results in the same file.
+class SyntheticRandom {
+public:
+	explicit SyntheticRandom(std::uint64_t seed) noexcept :
+		m_state { seed } {
+	}
+
+	std::uint64_t next() noexcept {
+		std::uint64_t z = (m_state += 0x9E3779B97F4A7C15U);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9U;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBU;
+		return z ^ (z >> 31);
+	}
+
+	// in [0, n), the bias of the modulo doesn't matter here
+	std::uint32_t below(std::uint32_t n) noexcept {
+		return static_cast<std::uint32_t>(next() % n);
+	}
+
+private:
+	std::uint64_t m_state;
+};
+
+// Output stream for FLPOutStream that keeps the file in memory.
+class MemoryOutFile {
+public:
+	template<typename InT>
+	std::size_t write(InT const data[], std::size_t num_elems) {
+		static_assert(std::is_trivially_copyable<InT>::value, "InT must be trivially copyable!");
+		std::size_t const size = sizeof(InT) * num_elems;
+		if(m_position + size > m_data.size())
+			m_data.resize(m_position + size);
+		std::memcpy(m_data.data() + m_position, data, size);
+		m_position += size;
+		return num_elems;
+	}
+
+	std::int64_t tell() const noexcept {
+		return static_cast<std::int64_t>(m_position);
+	}
+
+	bool seek(std::int64_t pos) noexcept {
+		if(pos < 0 || static_cast<std::uint64_t>(pos) > m_data.size())
+			return false;
+		m_position = static_cast<std::size_t>(pos);
+		return true;
+	}
+
+	std::span<std::byte const> data() const noexcept {
+		return m_data;
+	}
+
+private:
+	std::vector<std::byte> m_data;
+	std::size_t m_position = 0;
+};
+
+namespace detail {
+
+	template<typename StreamT, typename T>
+	void write_synthetic_value(FLPOutStream<StreamT>& flp, FLPEventType type, T value) {
+		FLPEventView e {};
+		e.type = type;
+		if constexpr(sizeof(T) == 1)
+			e.u8 = static_cast<std::uint8_t>(value);
+		else if constexpr(sizeof(T) == 2)
+			e.i16 = static_cast<std::int16_t>(value);
+		else
+			e.i32 = static_cast<std::int32_t>(value);
+		flp.write_event(e);
+	}
+
+	template<typename StreamT>
+	void write_synthetic_data(FLPOutStream<StreamT>& flp, FLPEventType type, std::span<std::byte const> data) {
+		FLPEventView e {};
+		e.type = type;
+		e.data = data;
+		flp.write_event(e);
+	}
+
+	// zero terminated UTF-16, the string encoding since FL 12
+	template<typename StreamT>
+	void write_synthetic_text(FLPOutStream<StreamT>& flp, FLPEventType type, std::u16string_view text) {
+		std::vector<std::byte> data((text.size() + 1) * sizeof(char16_t));
+		std::memcpy(data.data(), text.data(), text.size() * sizeof(char16_t));
+		write_synthetic_data(flp, type, data);
+	}
+
+	inline std::u16string synthetic_number(std::uint32_t n) {
+		std::string const s = std::to_string(n);
+		return std::u16string(s.begin(), s.end());
+	}
+}
+
+// Writes a project made of the events that dominate real ones: channels
+// with plugin states and sample paths, patterns with notes and a playlist.
+// Names contain quotes, backslashes and non-ASCII characters so that
+// escaping and transcoding are exercised too.
+template<typename StreamT>
+void write_synthetic_flp(FLPOutStream<StreamT>& flp, SyntheticFLPOptions const& options) {
+	using detail::write_synthetic_value;
+	using detail::write_synthetic_data;
+	using detail::write_synthetic_text;
+	using detail::synthetic_number;
+
+	SyntheticRandom random(options.seed);
+
+	FLPFileHeader header {};
+	header.Format = FLPFormat::FLP_Format_Song;
+	header.nChannels = static_cast<std::uint16_t>(options.n_channels);
+	header.BeatDiv = 96;
+	flp.write_headers(header);
+
+	constexpr std::string_view version = "20.8.4.2576";
+	write_synthetic_data(flp, FLPEventType::FLP_Version,
+		std::as_bytes(std::span(version.data(), version.size() + 1)));
+	write_synthetic_text(flp, FLPEventType::FLP_Text_Title, u"Synthetic \"benchmark\" song");
+	write_synthetic_text(flp, FLPEventType::FLP_Text_Author, u"Ren\u00E9e M\u00FCller \u266A");
+	write_synthetic_value(flp, FLPEventType::FLP_FineTempo, std::int32_t(140000));
+
+	std::vector<std::byte> plugin(52);
+	std::vector<std::byte> blob(options.plugin_blob_size);
+	for(std::uint32_t channel = 0; channel < options.n_channels; ++channel) {
+		write_synthetic_value(flp, FLPEventType::FLP_NewChan, static_cast<std::uint16_t>(channel));
+		write_synthetic_value(flp, FLPEventType::FLP_ChanType, std::uint8_t(channel % 4));
+		write_synthetic_text(flp, FLPEventType::FLP_Text_PluginName, u"Sampler #" + synthetic_number(channel));
+		for(std::byte& b : plugin) {
+			b = static_cast<std::byte>(random.next());
+		}
+		write_synthetic_data(flp, FLPEventType::FLP_NewPlugin, plugin);
+		// plugin states are parameter floats between runs of zeros
+		for(std::size_t i = 0; i < blob.size(); ++i) {
+			blob[i] = (i / 64) % 3 == 0 ? std::byte { 0 } : static_cast<std::byte>(random.next());
+		}
+		write_synthetic_data(flp, FLPEventType::FLP_PluginParams, blob);
+		write_synthetic_text(flp, FLPEventType::FLP_Text_SampleFileName,
+			u"C:\\Users\\Producer\\Samples\\Dr\u00FCms\\kick_" + synthetic_number(channel) + u".wav");
+	}
+
+	std::vector<FLPPatternNoteRecord> notes(options.n_notes);
+	for(std::uint32_t pattern = 0; pattern < options.n_patterns; ++pattern) {
+		write_synthetic_value(flp, FLPEventType::FLP_NewPat, static_cast<std::uint16_t>(pattern + 1));
+		write_synthetic_text(flp, FLPEventType::FLP_Text_PatName, u"Pattern " + synthetic_number(pattern + 1));
+		std::uint32_t position = 0;
+		for(FLPPatternNoteRecord& note : notes) {
+			position += random.below(48);
+			note = {};
+			note.position = position;
+			note.rack_channel = static_cast<std::uint16_t>(random.below(options.n_channels == 0 ? 1 : options.n_channels));
+			note.length = 12 + random.below(96);
+			note.key = static_cast<std::uint8_t>(36 + random.below(48));
+			note.fine_pitch = 120;
+			note.release = 64;
+			note.pan = 64;
+			note.velocity = static_cast<std::uint8_t>(64 + random.below(65));
+			note.mod_x = 128;
+			note.mod_y = 128;
+		}
+		write_synthetic_data(flp, FLPEventType::FLP_PatNoteRecChan, std::as_bytes(std::span(notes)));
+	}
+
+	std::vector<FLPPlaylistClipRecord> clips(options.n_clips);
+	std::uint32_t position = 0;
+	for(FLPPlaylistClipRecord& clip : clips) {
+		position += random.below(96);
+		clip = {};
+		clip.position = position;
+		// FL stores the pattern base in data0, patterns are 1-based above it
+		clip.data0 = 0x5000;
+		clip.source_index = static_cast<std::uint16_t>(clip.data0 + 1 + random.below(options.n_patterns == 0 ? 1 : options.n_patterns));
+		clip.duration = 384;
+		clip.lane_index = static_cast<std::uint16_t>(499 - random.below(32));
+		clip.data1[1] = std::byte { 0x78 };
+		clip.data1[3] = std::byte { 0x40 };
+		clip.window_start = -1;
+		clip.window_end = -1;
+	}
+	write_synthetic_data(flp, FLPEventType::FLP_PLRecChan, std::as_bytes(std::span(clips)));
+
+	flp.finish();
+}
+
+} // namespace Om
@@ -0,0 +1,434 @@
+#include <cstdio>     // printf, fprintf, tmpfile, fwrite, rewind
+#include <cstdlib>    // EXIT_SUCCESS, EXIT_FAILURE
+#include <cstddef>    // byte, size_t, ptrdiff_t
+#include <cstdint>    // uint8_t, uint32_t
+#include <algorithm>  // copy_n, equal, min
+#include <exception>  // exception
+#include <optional>   // optional
+#include <span>       // span
+#include <string>     // string, u16string
+#include <string_view> // string_view
+#include <system_error> // error_code
+#include <vector>     // vector
+
+#include "flp_stream.h"
+#include "flp_view_stream.h"
+#include "flp_out_stream.h"
+#include "flp_project.h"
+#include "flp_cpu_features.h"
+#include "flp_hex.h"
+#include "flp_utf_conversions.h"
+#include "flp_hash.h"
+#include "flp_inflate.h"
+#include "flp_zip.h"
+
+#include "cfile.h"
+#include "json.h"
+#include "json_reader.h"
+#include "json_to_flp.h"
+#include "sinks.h"
+#include "version.h"
+
+#include "synthetic_flp.h"
+#include "reference_zip.h"
+
+
+using namespace Om;
+
+// Regression checks of the parts of FLP-Tools that have fast paths which
+// the tools only ever run on one machine. Every failed check is printed,
+// the exit code tells whether all passed.
+
+static std::size_t n_failures = 0;
+
+// a failed check is reported and counted, the remaining ones still run
+#define OM_CHECK(condition) \
+	do { \
+		if(!(condition)) { \
+			std::fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++n_failures; \
+		} \
+	} while(false)
+
+// small enough to be generated in no time
+static SyntheticFLPOptions small_synthetic_options() {
+	SyntheticFLPOptions options;
+	options.n_channels = 16;
+	options.n_patterns = 40;
+	options.n_notes = 64;
+	options.n_clips = 300;
+	options.plugin_blob_size = 1024;
+	options.seed = 7;
+	return options;
+}
+
+static std::vector<std::byte> synthetic_flp(SyntheticFLPOptions const& options) {
+	FLPOutStream<MemoryOutFile> flp;
+	write_synthetic_flp(flp, options);
+	std::span<std::byte const> const data = flp.stream().data();
+	return { data.begin(), data.end() };
+}
+
+// every channel, pattern, note and clip of a synthetic project has to be in
+// the model, with all references between them resolved
+static void check_project_model() {
+	SyntheticFLPOptions const options = small_synthetic_options();
+	std::vector<std::byte> const file = synthetic_flp(options);
+	FLPViewInStream in(file);
+	FLPProject const project = read_flp_project(in);
+
+	OM_CHECK(project.channels.size() == options.n_channels);
+	OM_CHECK(project.patterns.size() == options.n_patterns);
+	OM_CHECK(project.notes.size() == std::size_t(options.n_patterns) * options.n_notes);
+	OM_CHECK(project.playlist.size() == options.n_clips);
+
+	for(std::size_t i = 0; i < project.channels.size(); ++i) {
+		OM_CHECK(project.channels.index[i] == i);
+	}
+	std::size_t n_notes = 0;
+	for(std::size_t i = 0; i < project.patterns.size(); ++i) {
+		OM_CHECK(project.patterns.id[i] == i + 1);
+		OM_CHECK(project.patterns.n_notes[i] == options.n_notes);
+		n_notes += project.patterns.n_notes[i];
+	}
+	OM_CHECK(n_notes == project.notes.size());
+	for(std::size_t i = 0; i < project.notes.size(); ++i) {
+		OM_CHECK(project.notes.pattern[i] < project.patterns.size());
+		OM_CHECK(project.notes.channel[i] < project.channels.size());
+	}
+	for(std::size_t i = 0; i < project.playlist.size(); ++i) {
+		OM_CHECK(project.playlist.source_kind[i] == FLPPlaylistSource::pattern);
+		OM_CHECK(project.playlist.source[i] < project.patterns.size());
+	}
+}
+
+// the kernel choices this CPU can run, scalar first
+static std::vector<CPUFeatures> supported_kernel_features() {
+	std::vector<CPUFeatures> features { CPUFeatures {} };
+	if(cpu_features().ssse3)
+		features.push_back({ true, false });
+	if(cpu_features().avx2)
+		features.push_back(cpu_features());
+	return features;
+}
+
+// every kernel has to give the scalar result, for whole payloads and for
+// pieces starting anywhere in a group
+static void check_hex_kernels() {
+	SyntheticRandom random(1);
+	std::vector<CPUFeatures> const kernels = supported_kernel_features();
+	std::vector<std::byte> buffer(301);
+	for(std::size_t n_bytes = 0; n_bytes < buffer.size(); ++n_bytes) {
+		for(std::byte& b : buffer) {
+			b = static_cast<std::byte>(random.next());
+		}
+		// unaligned, like the payloads in a file
+		std::span<std::byte const> const data = std::span<std::byte const>(buffer).subspan(1, n_bytes);
+		std::size_t const n_chars = hex_spaced_length(n_bytes);
+
+		std::string expected(n_chars, '\0');
+		for(std::size_t i = 0; i < n_bytes; ++i) {
+			constexpr char digits[] = "0123456789ABCDEF";
+			auto const b = static_cast<std::uint8_t>(data[i]);
+			expected[3 * i] = digits[b >> 4];
+			expected[3 * i + 1] = digits[b & 0x0F];
+			if(3 * i + 2 < n_chars)
+				expected[3 * i + 2] = ' ';
+		}
+
+		std::string chars(n_chars, '\0');
+		hex_encode_spaced(data, 0, n_chars, chars.data());
+		OM_CHECK(chars == expected);
+		for(CPUFeatures const& features : kernels) {
+			chars.assign(n_chars, '\0');
+			hex_encode_spaced(data, 0, n_chars, chars.data(), features);
+			OM_CHECK(chars == expected);
+
+			chars.assign(n_chars, '\0');
+			for(std::size_t first_char = 0; first_char < n_chars;) {
+				std::size_t const n = std::min<std::size_t>(1 + random.below(100), n_chars - first_char);
+				hex_encode_spaced(data, first_char, n, chars.data() + first_char, features);
+				first_char += n;
+			}
+			OM_CHECK(chars == expected);
+		}
+	}
+}
+
+// mostly ASCII with runs of longer sequences, like names in real projects
+static std::u16string random_utf16(SyntheticRandom& random, std::size_t length) {
+	std::u16string str;
+	bool const is_ascii = random.below(4) == 0;
+	while(str.size() < length) {
+		switch(is_ascii ? 0 : random.below(8)) {
+		case 1:
+			str += static_cast<char16_t>(0x80 + random.below(0x800 - 0x80));
+			break;
+		case 2:
+			str += static_cast<char16_t>(0x800 + random.below(0xD800 - 0x800));
+			break;
+		case 3:
+			str += static_cast<char16_t>(0xE000 + random.below(0x10000 - 0xE000));
+			break;
+		case 4:
+			str += static_cast<char16_t>(0xD800 + random.below(0x400));
+			str += static_cast<char16_t>(0xDC00 + random.below(0x400));
+			break;
+		default:
+			str += static_cast<char16_t>(random.below(0x80));
+			break;
+		}
+	}
+	return str;
+}
+
+struct UTF8Result {
+	std::error_code err;
+	std::string chars;
+};
+
+static UTF8Result to_utf8(std::u16string_view str16, CPUFeatures const* features) {
+	UTF8Result result;
+	result.chars.resize(utf8_max_length(str16.size()));
+	std::size_t n_written = 0;
+	result.err = features
+		? utf16_to_utf8(str16, result.chars.data(), &n_written, *features)
+		: utf16_to_utf8(str16, result.chars.data(), &n_written);
+	result.chars.resize(n_written);
+	return result;
+}
+
+// Every kernel has to give the same result, which has to convert back to
+// the input. An unpaired surrogate stops them all after the same chars.
+static void check_utf16_kernels() {
+	SyntheticRandom random(2);
+	std::vector<CPUFeatures> const kernels = supported_kernel_features();
+	for(std::size_t length = 0; length < 300; ++length) {
+		std::u16string str16 = random_utf16(random, length);
+		bool const is_valid = length == 0 || random.below(4) != 0;
+		if(!is_valid) {
+			// cut anywhere but inside a pair and add a surrogate without its partner
+			str16.resize(random.below(static_cast<std::uint32_t>(str16.size() + 1)));
+			if(!str16.empty() && is_utf16_high_surrogate(str16.back()))
+				str16.pop_back();
+			str16 += random.below(2) == 0 ? u'\xD800' : u'\xDC00';
+			str16 += u"tail";
+		}
+
+		UTF8Result const expected = to_utf8(str16, nullptr);
+		OM_CHECK(!expected.err == is_valid);
+		if(is_valid) {
+			std::u16string back;
+			OM_CHECK(!utf8_to_utf16(expected.chars, &back) && back == str16);
+		} else {
+			// the chars before the surrogate are written anyway
+			std::size_t const position = str16.size() - 5;
+			UTF8Result const prefix = to_utf8(std::u16string_view(str16).substr(0, position), nullptr);
+			OM_CHECK(!prefix.err && prefix.chars == expected.chars);
+		}
+		for(CPUFeatures const& features : kernels) {
+			UTF8Result const result = to_utf8(str16, &features);
+			OM_CHECK(result.err == expected.err && result.chars == expected.chars);
+		}
+	}
+}
+
+// input stream for JSONInStream that reads a document in memory
+class MemoryInStream {
+public:
+	explicit MemoryInStream(std::string_view data) noexcept :
+		m_data { data } {
+	}
+
+	std::size_t read(char target[], std::size_t num_elems) noexcept {
+		std::size_t const n = std::min(num_elems, m_data.size());
+		std::copy_n(m_data.data(), n, target);
+		m_data.remove_prefix(n);
+		return n;
+	}
+
+private:
+	std::string_view m_data;
+};
+
+struct JSONRoundTripOptions {
+	FLPDataEncoding data_encoding;
+	FLPRecordLayout record_layout;
+	bool compact;
+};
+
+// the same document flp_to_json writes, the sidecar payloads go to sidecar
+template<typename FormatT>
+static std::string flp_to_json(std::span<std::byte const> file, JSONRoundTripOptions const& options, MemorySink& sidecar) {
+	MemorySink sink;
+	SidecarSink<MemorySink> sidecar_writer(sidecar);
+	FLPStreamOptions const stream_options { options.data_encoding, &sidecar_writer, options.record_layout, nullptr };
+	FLPViewInStream flp(file);
+	JSONOutStream<MemorySink, FormatT> json_stream(sink);
+	json_stream.begin_object();
+	json_stream.key("header");
+	stream_flp_header(json_stream, flp.file_header());
+	if(options.data_encoding == FLPDataEncoding::sidecar) {
+		json_stream.key("sidecar");
+		json_stream.value(std::string_view("check.bin"));
+	}
+	json_stream.key("events");
+	json_stream.begin_array();
+	bool is_unicode = false;
+	for(; flp.has_event(); ++flp) {
+		FLPEventView const& event = flp->view();
+		if(is_unicode)
+			stream_flp_event<true>(json_stream, event, stream_options);
+		else
+			stream_flp_event<false>(json_stream, event, stream_options);
+		if(event.type == FLPEventType::FLP_Version)
+			is_unicode = Version(reinterpret_cast<char const*>(event.data.data())) >= "12.0.0";
+	}
+	json_stream.end_array();
+	json_stream.end_object();
+	json_stream.flush();
+	return std::string(sink.data());
+}
+
+static std::string flp_to_json(std::span<std::byte const> file, JSONRoundTripOptions const& options, MemorySink& sidecar) {
+	if(options.compact)
+		return flp_to_json<JSONCompactFormat>(file, options, sidecar);
+	return flp_to_json<JSONPrettyFormat>(file, options, sidecar);
+}
+
+static std::vector<std::byte> json_to_flp(std::string_view json, std::string_view sidecar) {
+	MemoryInStream in(json);
+	JSONInStream<MemoryInStream> json_stream(in);
+	FLPOutStream<MemoryOutFile> flp;
+	auto open_sidecar = [&](std::string_view) {
+		CFile file(std::tmpfile());
+		if(file.is_open()) {
+			std::fwrite(sidecar.data(), 1, sidecar.size(), file.fptr());
+			std::rewind(file.fptr());
+		}
+		return file;
+	};
+	Om::json_to_flp(json_stream, flp, open_sidecar);
+	std::span<std::byte const> const data = flp.stream().data();
+	return { data.begin(), data.end() };
+}
+
+// JSON -> FLP -> JSON with every payload encoding and record layout gives
+// the same JSON, and the FLP it went through is the original one
+static void check_json_round_trip() {
+	std::vector<std::byte> const file = synthetic_flp(small_synthetic_options());
+	constexpr JSONRoundTripOptions round_trips[] = {
+		{ FLPDataEncoding::hex, FLPRecordLayout::rows, false },
+		{ FLPDataEncoding::hex, FLPRecordLayout::columns, true },
+		{ FLPDataEncoding::base64, FLPRecordLayout::rows, true },
+		{ FLPDataEncoding::base64, FLPRecordLayout::columns, false },
+		{ FLPDataEncoding::sidecar, FLPRecordLayout::rows, true },
+	};
+	for(JSONRoundTripOptions const& options : round_trips) {
+		MemorySink sidecar;
+		std::string const json = flp_to_json(file, options, sidecar);
+		std::vector<std::byte> const flp = json_to_flp(json, sidecar.data());
+		OM_CHECK(flp == file);
+
+		MemorySink sidecar_again;
+		OM_CHECK(flp_to_json(flp, options, sidecar_again) == json);
+		OM_CHECK(sidecar_again.data() == sidecar.data());
+	}
+}
+
+// the contents of the entries of reference_zip
+static std::vector<std::byte> reference_zip_payload(std::string_view name) {
+	std::string payload;
+	if(name == "stored.bin") {
+		for(int i = 0; i < 200; ++i) {
+			payload += static_cast<char>((i * 7 + 3) & 0xFF);
+		}
+	} else if(name == "level0.txt" || name == "fixed.txt") {
+		for(int i = 0; i < 20; ++i) {
+			payload += "The quick brown fox jumps over the lazy dog. ";
+		}
+	} else {
+		std::string block;
+		for(int n = 0; n < 150; ++n) {
+			block += "payload line " + std::to_string(n) + "\n";
+		}
+		for(int copy = 0; copy < 40; ++copy) {
+			std::string changed = block;
+			changed[copy * 37] = static_cast<char>('A' + copy % 26);
+			payload += changed;
+		}
+	}
+	auto const bytes = std::as_bytes(std::span(payload));
+	return { bytes.begin(), bytes.end() };
+}
+
+// decodes all of data in pieces of piece_size, nullopt on an error
+static std::optional<std::vector<std::byte>> inflate(std::span<std::byte const> data, std::size_t piece_size) {
+	Inflater inflater(data);
+	std::vector<std::byte> out;
+	std::vector<std::byte> piece(piece_size);
+	while(std::size_t const n = inflater.read(piece)) {
+		out.insert(out.end(), piece.begin(), piece.begin() + static_cast<std::ptrdiff_t>(n));
+	}
+	if(inflater.error() || !inflater.finished())
+		return std::nullopt;
+	return out;
+}
+
+// every entry of the reference zip decodes to its content, read in small
+// and large pieces, and truncated data is an error
+static void check_inflate() {
+	std::span<std::byte const> const archive = std::as_bytes(std::span(reference_zip));
+	std::optional<std::vector<ZipEntry>> const entries = read_zip_directory(archive);
+	OM_CHECK(entries && entries->size() == 5);
+	if(!entries)
+		return;
+	for(ZipEntry const& entry : *entries) {
+		std::vector<std::byte> const expected = reference_zip_payload(entry.name);
+		OM_CHECK(entry.uncompressed_size == expected.size());
+		OM_CHECK(entry.crc32 == crc32(expected));
+		std::optional<std::span<std::byte const>> const data = zip_entry_data(archive, entry);
+		OM_CHECK(data && data->size() == entry.compressed_size);
+		if(!data)
+			continue;
+		if(entry.method == 0) {
+			OM_CHECK(std::equal(data->begin(), data->end(), expected.begin(), expected.end()));
+			continue;
+		}
+		for(std::size_t const piece_size : { std::size_t(1), std::size_t(1000), std::size_t(1) << 20 }) {
+			OM_CHECK(inflate(*data, piece_size) == expected);
+		}
+		OM_CHECK(!inflate(data->first(data->size() / 2), 4096));
+	}
+}
+
+struct Check {
+	char const* name;
+	void (*run)();
+};
+
+static constexpr Check checks[] = {
+	{ "project model", check_project_model },
+	{ "hex kernels", check_hex_kernels },
+	{ "utf-16 kernels", check_utf16_kernels },
+	{ "json round trip", check_json_round_trip },
+	{ "inflate", check_inflate },
+};
+
+int main() {
+	for(Check const& check : checks) {
+		std::size_t const n_failures_before = n_failures;
+		try {
+			check.run();
+		} catch(std::exception const& e) {
+			std::fprintf(stderr, "%s: %s\n", check.name, e.what());
+			++n_failures;
+		}
+		std::printf("%-24s %s\n", check.name, n_failures == n_failures_before ? "ok" : "FAILED");
+	}
+	if(n_failures > 0) {
+		std::fprintf(stderr, "%zu checks failed\n", n_failures);
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
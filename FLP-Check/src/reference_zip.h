@@ -0,0 +1,447 @@
+#pragma once
+
+// Zip archive the inflate check decodes, made with Python's zlib module so
+// that it doesn't come from the decoder under test:
+//   stored.bin   200 bytes, stored
+//   level0.txt   900 bytes of text in a stored deflate block
+//   fixed.txt    900 bytes of text, one block with the fixed Huffman code
+//   dynamic.bin  97600 bytes, dynamic Huffman code, more than the 64 KiB window
+//   blocks.bin   the same, with a full flush every 10000 bytes, which ends
+//                each dynamic block with an empty stored one
+// The check generates the contents again, see reference_zip_payload().
+static constexpr unsigned char reference_zip[] = {
+	0x50, 0x4B, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x03, 0x69,
+	0xF1, 0x0F, 0xC8, 0x00, 0x00, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x73, 0x74,
+	0x6F, 0x72, 0x65, 0x64, 0x2E, 0x62, 0x69, 0x6E, 0x03, 0x0A, 0x11, 0x18, 0x1F, 0x26, 0x2D, 0x34,
+	0x3B, 0x42, 0x49, 0x50, 0x57, 0x5E, 0x65, 0x6C, 0x73, 0x7A, 0x81, 0x88, 0x8F, 0x96, 0x9D, 0xA4,
+	0xAB, 0xB2, 0xB9, 0xC0, 0xC7, 0xCE, 0xD5, 0xDC, 0xE3, 0xEA, 0xF1, 0xF8, 0xFF, 0x06, 0x0D, 0x14,
+	0x1B, 0x22, 0x29, 0x30, 0x37, 0x3E, 0x45, 0x4C, 0x53, 0x5A, 0x61, 0x68, 0x6F, 0x76, 0x7D, 0x84,
+	0x8B, 0x92, 0x99, 0xA0, 0xA7, 0xAE, 0xB5, 0xBC, 0xC3, 0xCA, 0xD1, 0xD8, 0xDF, 0xE6, 0xED, 0xF4,
+	0xFB, 0x02, 0x09, 0x10, 0x17, 0x1E, 0x25, 0x2C, 0x33, 0x3A, 0x41, 0x48, 0x4F, 0x56, 0x5D, 0x64,
+	0x6B, 0x72, 0x79, 0x80, 0x87, 0x8E, 0x95, 0x9C, 0xA3, 0xAA, 0xB1, 0xB8, 0xBF, 0xC6, 0xCD, 0xD4,
+	0xDB, 0xE2, 0xE9, 0xF0, 0xF7, 0xFE, 0x05, 0x0C, 0x13, 0x1A, 0x21, 0x28, 0x2F, 0x36, 0x3D, 0x44,
+	0x4B, 0x52, 0x59, 0x60, 0x67, 0x6E, 0x75, 0x7C, 0x83, 0x8A, 0x91, 0x98, 0x9F, 0xA6, 0xAD, 0xB4,
+	0xBB, 0xC2, 0xC9, 0xD0, 0xD7, 0xDE, 0xE5, 0xEC, 0xF3, 0xFA, 0x01, 0x08, 0x0F, 0x16, 0x1D, 0x24,
+	0x2B, 0x32, 0x39, 0x40, 0x47, 0x4E, 0x55, 0x5C, 0x63, 0x6A, 0x71, 0x78, 0x7F, 0x86, 0x8D, 0x94,
+	0x9B, 0xA2, 0xA9, 0xB0, 0xB7, 0xBE, 0xC5, 0xCC, 0xD3, 0xDA, 0xE1, 0xE8, 0xEF, 0xF6, 0xFD, 0x04,
+	0x0B, 0x12, 0x19, 0x20, 0x27, 0x2E, 0x35, 0x3C, 0x43, 0x4A, 0x51, 0x58, 0x5F, 0x66, 0x6D, 0x74,
+	0x50, 0x4B, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0xE6, 0x4A,
+	0x66, 0xB0, 0x89, 0x03, 0x00, 0x00, 0x84, 0x03, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x6C, 0x65,
+	0x76, 0x65, 0x6C, 0x30, 0x2E, 0x74, 0x78, 0x74, 0x01, 0x84, 0x03, 0x7B, 0xFC, 0x54, 0x68, 0x65,
+	0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78,
+	0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75,
+	0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75,
+	0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A,
+	0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B,
+	0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73,
+	0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64,
+	0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72,
+	0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76,
+	0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E,
+	0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E,
+	0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20,
+	0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68,
+	0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F,
+	0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65,
+	0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71,
+	0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A,
+	0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61,
+	0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63,
+	0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70,
+	0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20,
+	0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62,
+	0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F,
+	0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67,
+	0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77,
+	0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72,
+	0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54,
+	0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66,
+	0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68,
+	0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20,
+	0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20,
+	0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C,
+	0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69,
+	0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D,
+	0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79,
+	0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20,
+	0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20,
+	0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F,
+	0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F,
+	0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65,
+	0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20,
+	0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20,
+	0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74,
+	0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65,
+	0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78,
+	0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+	0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75,
+	0x69, 0x63, 0x6B, 0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75,
+	0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A,
+	0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B,
+	0x20, 0x62, 0x72, 0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73,
+	0x20, 0x6F, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64,
+	0x6F, 0x67, 0x2E, 0x20, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6B, 0x20, 0x62, 0x72,
+	0x6F, 0x77, 0x6E, 0x20, 0x66, 0x6F, 0x78, 0x20, 0x6A, 0x75, 0x6D, 0x70, 0x73, 0x20, 0x6F, 0x76,
+	0x65, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6C, 0x61, 0x7A, 0x79, 0x20, 0x64, 0x6F, 0x67, 0x2E,
+	0x20, 0x50, 0x4B, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0xE6,
+	0x4A, 0x66, 0xB0, 0x37, 0x00, 0x00, 0x00, 0x84, 0x03, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x66,
+	0x69, 0x78, 0x65, 0x64, 0x2E, 0x74, 0x78, 0x74, 0x0B, 0xC9, 0x48, 0x55, 0x28, 0x2C, 0xCD, 0x4C,
+	0xCE, 0x56, 0x48, 0x2A, 0xCA, 0x2F, 0xCF, 0x53, 0x48, 0xCB, 0xAF, 0x50, 0xC8, 0x2A, 0xCD, 0x2D,
+	0x28, 0x56, 0xC8, 0x2F, 0x4B, 0x2D, 0x52, 0x28, 0x01, 0x4A, 0xE7, 0x24, 0x56, 0x55, 0x2A, 0xA4,
+	0xE4, 0xA7, 0xEB, 0x29, 0x84, 0x8C, 0x2A, 0x1E, 0x55, 0x3C, 0xAA, 0x98, 0xDA, 0x8A, 0x01, 0x50,
+	0x4B, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0xDD, 0x59, 0x38,
+	0x15, 0x5F, 0x04, 0x00, 0x00, 0x40, 0x7D, 0x01, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x64, 0x79, 0x6E,
+	0x61, 0x6D, 0x69, 0x63, 0x2E, 0x62, 0x69, 0x6E, 0xED, 0xDA, 0xBB, 0x6E, 0x16, 0x67, 0x14, 0x85,
+	0xE1, 0x9E, 0xAB, 0xE0, 0x12, 0x66, 0xCF, 0x79, 0x4A, 0x0E, 0x36, 0xE0, 0x03, 0xE1, 0x90, 0x40,
+	0x92, 0x0E, 0x29, 0x14, 0x48, 0x28, 0x49, 0x9B, 0xBB, 0x4F, 0x9B, 0x7F, 0x8D, 0x22, 0xB9, 0xF3,
+	0x16, 0x7A, 0xCA, 0xE9, 0x5E, 0x61, 0xFC, 0xED, 0x47, 0xD6, 0x7A, 0xF6, 0xE5, 0x9F, 0xEF, 0x7F,
+	0x7D, 0xF9, 0xE3, 0xE9, 0xF7, 0x6F, 0x7F, 0x7E, 0x7D, 0x3A, 0x3C, 0xF9, 0xFB, 0xBF, 0x9F, 0x75,
+	0xF9, 0x39, 0x5E, 0x7E, 0x4E, 0x97, 0x9F, 0xF3, 0xE5, 0xE7, 0x72, 0xF9, 0xB9, 0x5E, 0x7E, 0x6E,
+	0x97, 0x9F, 0xFB, 0xE5, 0xE7, 0x11, 0x19, 0x99, 0x15, 0x5D, 0x15, 0x61, 0x15, 0x65, 0x15, 0x69,
+	0x15, 0x6D, 0x15, 0x71, 0x15, 0x75, 0x15, 0x79, 0x15, 0x7D, 0x63, 0xF4, 0x8D, 0xF9, 0xEF, 0x16,
+	0x7D, 0x63, 0xF4, 0x8D, 0xD1, 0x37, 0x46, 0xDF, 0x18, 0x7D, 0x63, 0xF4, 0x8D, 0xD1, 0x37, 0x46,
+	0xDF, 0x14, 0x7D, 0x53, 0xF4, 0x4D, 0xF9, 0x83, 0x8D, 0xBE, 0x29, 0xFA, 0xA6, 0xE8, 0x9B, 0xA2,
+	0x6F, 0x8A, 0xBE, 0x29, 0xFA, 0xA6, 0xE8, 0x9B, 0xA3, 0x6F, 0x8E, 0xBE, 0x39, 0xFA, 0xE6, 0xFC,
+	0x9F, 0x17, 0x7D, 0x73, 0xF4, 0xCD, 0xD1, 0x37, 0x47, 0xDF, 0x1C, 0x7D, 0x73, 0xF4, 0x2D, 0xD1,
+	0xB7, 0x44, 0xDF, 0x12, 0x7D, 0x4B, 0xF4, 0x2D, 0xF9, 0xAB, 0x11, 0x7D, 0x4B, 0xF4, 0x2D, 0xD1,
+	0xB7, 0x44, 0xDF, 0x12, 0x7D, 0x6B, 0xF4, 0xAD, 0xD1, 0xB7, 0x46, 0xDF, 0x1A, 0x7D, 0x6B, 0xF4,
+	0xAD, 0xF9, 0xBB, 0x1B, 0x7D, 0x6B, 0xF4, 0xAD, 0xD1, 0xB7, 0x46, 0xDF, 0x16, 0x7D, 0x5B, 0xF4,
+	0x6D, 0xD1, 0xB7, 0x45, 0xDF, 0x16, 0x7D, 0x5B, 0xF4, 0x6D, 0xF9, 0xB8, 0x44, 0xDF, 0x16, 0x7D,
+	0x5B, 0xF4, 0xED, 0xD1, 0xB7, 0x47, 0xDF, 0x1E, 0x7D, 0x7B, 0xF4, 0xED, 0xD1, 0xB7, 0x47, 0xDF,
+	0x1E, 0x7D, 0x7B, 0xBE, 0x7E, 0xD1, 0xB7, 0x47, 0xDF, 0x11, 0x7D, 0x47, 0xF4, 0x1D, 0xD1, 0x77,
+	0x44, 0xDF, 0x11, 0x7D, 0x47, 0xF4, 0x1D, 0xD1, 0x77, 0x44, 0xDF, 0x91, 0xCF, 0xF3, 0xE9, 0x7D,
+	0xCE, 0x07, 0x7A, 0xC8, 0x17, 0x7A, 0xC8, 0x27, 0x7A, 0xC8, 0x37, 0x7A, 0xC8, 0x47, 0x7A, 0xC8,
+	0x57, 0x7A, 0xC8, 0x67, 0x7A, 0xC8, 0x77, 0x7A, 0xC8, 0x87, 0x7A, 0xC8, 0xD2, 0xF3, 0x29, 0xC9,
+	0xD2, 0xD3, 0x31, 0x39, 0x5D, 0x93, 0xD3, 0x39, 0x39, 0xDD, 0x93, 0xD3, 0x41, 0x39, 0x5D, 0x94,
+	0xD3, 0x49, 0xC9, 0x9B, 0x52, 0x79, 0x54, 0x6A, 0x3C, 0x5D, 0xBD, 0x2C, 0xCD, 0xBB, 0x52, 0x79,
+	0x58, 0x2A, 0x2F, 0x4B, 0xE5, 0x69, 0xA9, 0xBC, 0x2D, 0x95, 0xC7, 0xA5, 0xF2, 0xBA, 0x54, 0x9E,
+	0x97, 0xCA, 0xFB, 0x52, 0xD3, 0xE9, 0x40, 0x67, 0x69, 0x9E, 0x98, 0xCA, 0x1B, 0x53, 0x79, 0x64,
+	0x2A, 0xAF, 0x4C, 0xE5, 0x99, 0xA9, 0xBC, 0x33, 0x95, 0x87, 0xA6, 0xF2, 0xD2, 0x54, 0x9E, 0x9A,
+	0x9A, 0x4F, 0x96, 0xC8, 0xD2, 0xBC, 0x36, 0x95, 0xE7, 0xA6, 0xF2, 0xDE, 0x54, 0x1E, 0x9C, 0xCA,
+	0x8B, 0xF3, 0x7F, 0x0E, 0x7B, 0xCE, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61,
+	0x1C, 0xC6, 0x61, 0x8F, 0xE2, 0xB0, 0x07, 0xFD, 0x3D, 0xEC, 0x05, 0x87, 0x71, 0x18, 0x87, 0x71,
+	0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0x3D, 0x8A, 0xC3, 0x1E, 0xF4, 0xF7, 0xB0, 0x97,
+	0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xF6, 0x28, 0x0E,
+	0x7B, 0xD0, 0xDF, 0xC3, 0xAE, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C,
+	0xC3, 0x38, 0xAC, 0xEF, 0x4E, 0xFF, 0x9A, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C,
+	0xC3, 0x38, 0x8C, 0xC3, 0xFA, 0xEE, 0xF4, 0x5F, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18,
+	0x87, 0x71, 0x18, 0x87, 0x71, 0x58, 0xDF, 0x9D, 0xFE, 0x6B, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30,
+	0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xEB, 0xBB, 0xD3, 0x7F, 0xC3, 0x61, 0x1C, 0xC6, 0x61,
+	0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x7D, 0x77, 0xFA, 0x37, 0x1C, 0xC6, 0x61,
+	0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xD6, 0x77, 0xA7, 0x7F, 0xCB, 0x61,
+	0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x7D, 0x77, 0xFA, 0x77,
+	0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xD6, 0x77, 0xA7,
+	0x7F, 0xCF, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x7D,
+	0x77, 0xFA, 0x6F, 0x39, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38,
+	0xAC, 0xEF, 0x4E, 0xFF, 0x27, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3,
+	0x30, 0x0E, 0xEB, 0xBB, 0xD3, 0x7F, 0xC7, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6,
+	0x61, 0x1C, 0xC6, 0x61, 0x7D, 0x77, 0xFA, 0xEF, 0x39, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C,
+	0xC3, 0x38, 0x8C, 0xC3, 0x38, 0xAC, 0xEF, 0x4E, 0xFF, 0x03, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18,
+	0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0xF5, 0xDD, 0xE9, 0x7F, 0xE4, 0x30, 0x0E, 0xE3, 0x30,
+	0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0xB0, 0xBE, 0x3B, 0xFD, 0x9F, 0x39, 0x8C, 0xC3,
+	0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0xAC, 0xEF, 0x4E, 0xFF, 0x17, 0x0E,
+	0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xEB, 0xBB, 0xD3, 0xFF,
+	0xC4, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x7D, 0x77,
+	0xFA, 0x9F, 0x39, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0xAC,
+	0xEF, 0x4E, 0xFF, 0x57, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30,
+	0x0E, 0xEB, 0xBB, 0xD3, 0xFF, 0x8D, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3,
+	0x38, 0x8C, 0xC3, 0xFA, 0xEE, 0xF4, 0x7F, 0xE7, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E,
+	0xE3, 0x30, 0x0E, 0xE3, 0xB0, 0xBE, 0x3B, 0xFD, 0x67, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C,
+	0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xD6, 0x77, 0xA7, 0xFF, 0x9C, 0xC3, 0x38, 0x8C, 0xC3, 0x38,
+	0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0xFA, 0xEE, 0xF4, 0x5F, 0x70, 0x18, 0x87, 0x71,
+	0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x58, 0xDF, 0x9D, 0xFE, 0x4B, 0x0E, 0xE3,
+	0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xEB, 0xBB, 0xD3, 0xBF, 0xE2,
+	0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0xB0, 0xBE, 0x3B, 0xFD,
+	0x6B, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xE3, 0x30, 0x0E, 0xEB, 0xBB,
+	0xD3, 0x7F, 0xC5, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61, 0x1C, 0xC6, 0x61,
+	0x7D, 0x77, 0xFA, 0xAF, 0x39, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3, 0x38, 0x8C, 0xC3,
+	0x38, 0xAC, 0xEF, 0x4E, 0xFF, 0x0D, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87,
+	0x71, 0x18, 0x87, 0xF5, 0xDD, 0xE9, 0xDF, 0x70, 0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87,
+	0x71, 0x18, 0x87, 0x71, 0x58, 0xDF, 0x9D, 0xFE, 0x2D, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87,
+	0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0xF5, 0xDD, 0xE9, 0xDF, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87,
+	0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x58, 0xDF, 0x9D, 0xFE, 0x3D, 0x87, 0x71, 0x18, 0x87,
+	0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0x71, 0x18, 0x87, 0xF5, 0xDD, 0xE9, 0xBF, 0xE5, 0x30, 0x0E,
+	0xE3, 0xB0, 0x1F, 0xDB, 0x61, 0xFF, 0x02, 0x50, 0x4B, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08,
+	0x00, 0x00, 0x00, 0x21, 0x00, 0xDD, 0x59, 0x38, 0x15, 0x34, 0x10, 0x00, 0x00, 0x40, 0x7D, 0x01,
+	0x00, 0x0A, 0x00, 0x00, 0x00, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x73, 0x2E, 0x62, 0x69, 0x6E, 0xEC,
+	0xD8, 0x3D, 0x6E, 0x54, 0x41, 0x10, 0x85, 0xD1, 0x9C, 0x55, 0x78, 0x09, 0xAF, 0xFA, 0xBF, 0x43,
+	0xC0, 0x2C, 0xC4, 0x12, 0x04, 0x48, 0x16, 0x90, 0xB2, 0x7B, 0x52, 0xDE, 0x69, 0x21, 0x4D, 0x82,
+	0x26, 0xA9, 0xB0, 0xB3, 0x23, 0x8F, 0xA7, 0xBE, 0xAB, 0xF9, 0xF8, 0xF6, 0xFB, 0xFD, 0xE7, 0xDB,
+	0xD7, 0x97, 0xF7, 0xEF, 0x3F, 0xBE, 0xBD, 0x5C, 0x1F, 0x7E, 0xFD, 0xFD, 0x8C, 0xFB, 0xB3, 0xDC,
+	0x9F, 0xF5, 0xFE, 0x6C, 0xF7, 0x67, 0xBF, 0x3F, 0xC7, 0xFD, 0x39, 0xEF, 0xCF, 0x75, 0x7F, 0x6E,
+	0x18, 0xB2, 0x70, 0x05, 0xB0, 0x40, 0x16, 0xD0, 0x02, 0x5B, 0x80, 0x0B, 0x74, 0x01, 0x2F, 0xF0,
+	0x15, 0x7C, 0xC5, 0xBF, 0x1B, 0xBE, 0x82, 0xAF, 0xE0, 0x2B, 0xF8, 0x0A, 0xBE, 0x82, 0xAF, 0xE0,
+	0x2B, 0xF8, 0x2A, 0xBE, 0x8A, 0xAF, 0xFA, 0xC1, 0xE2, 0xAB, 0xF8, 0x2A, 0xBE, 0x8A, 0xAF, 0xE2,
+	0xAB, 0xF8, 0x2A, 0xBE, 0x86, 0xAF, 0xE1, 0x6B, 0xF8, 0x9A, 0xFF, 0x79, 0xF8, 0x1A, 0xBE, 0x86,
+	0xAF, 0xE1, 0x6B, 0xF8, 0x1A, 0xBE, 0x8E, 0xAF, 0xE3, 0xEB, 0xF8, 0x3A, 0xBE, 0xEE, 0x57, 0x03,
+	0x5F, 0xC7, 0xD7, 0xF1, 0x75, 0x7C, 0x1D, 0xDF, 0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0x03, 0xDF, 0xC0,
+	0x37, 0xFC, 0xEE, 0xE2, 0x1B, 0xF8, 0x06, 0xBE, 0x81, 0x6F, 0xE2, 0x9B, 0xF8, 0x26, 0xBE, 0x89,
+	0x6F, 0xE2, 0x9B, 0xF8, 0xA6, 0xC7, 0x05, 0xDF, 0xC4, 0x37, 0xF1, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2,
+	0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xBC, 0x7E, 0xF8, 0x16, 0xBE, 0x8D, 0x6F, 0xE3,
+	0xDB, 0xF8, 0x36, 0xBE, 0x8D, 0x6F, 0xE3, 0xDB, 0xF8, 0x36, 0xBE, 0xED, 0x79, 0x3E, 0xEE, 0xB3,
+	0x07, 0xFA, 0xF2, 0x42, 0x5F, 0x9E, 0xE8, 0xCB, 0x1B, 0x7D, 0x79, 0xA4, 0x2F, 0xAF, 0xF4, 0xE5,
+	0x99, 0xBE, 0xBC, 0xD3, 0x97, 0x87, 0xFA, 0x52, 0x7A, 0xA6, 0x44, 0xE9, 0x11, 0x93, 0xA3, 0x26,
+	0x47, 0x4E, 0x8E, 0x9E, 0x1C, 0x41, 0x39, 0x8A, 0x72, 0x24, 0xC5, 0xA6, 0x84, 0x51, 0x89, 0x72,
+	0x54, 0x4F, 0xA9, 0x5D, 0x09, 0xC3, 0x12, 0x96, 0x25, 0x4C, 0x4B, 0xD8, 0x96, 0x30, 0x2E, 0x61,
+	0x5D, 0xC2, 0xBC, 0x84, 0x7D, 0x89, 0x7A, 0x04, 0x5A, 0xA9, 0x89, 0x09, 0x1B, 0x13, 0x46, 0x26,
+	0xAC, 0x4C, 0x98, 0x99, 0xB0, 0x33, 0x61, 0x68, 0xC2, 0xD2, 0x84, 0xA9, 0x89, 0x76, 0x6C, 0x09,
+	0xA5, 0xD6, 0x26, 0xCC, 0x4D, 0xD8, 0x9B, 0x30, 0x38, 0x61, 0x71, 0xFE, 0xB5, 0xC3, 0x3E, 0xE5,
+	0x0E, 0xCB, 0x1D, 0x96, 0x3B, 0x2C, 0x77, 0x58, 0xEE, 0xB0, 0xDC, 0x61, 0xB9, 0xC3, 0x72, 0x87,
+	0xE5, 0x0E, 0x7B, 0xCA, 0x0E, 0x7B, 0xE8, 0xF7, 0xB0, 0xCF, 0xB9, 0xC3, 0x72, 0x87, 0xE5, 0x0E,
+	0xCB, 0x1D, 0x96, 0x3B, 0x2C, 0x77, 0x58, 0xEE, 0xB0, 0xDC, 0x61, 0xB9, 0xC3, 0x9E, 0xB2, 0xC3,
+	0x1E, 0xFA, 0x3D, 0xEC, 0x35, 0x77, 0x58, 0xEE, 0xB0, 0xDC, 0x61, 0xB9, 0xC3, 0x72, 0x87, 0xE5,
+	0x0E, 0xCB, 0x1D, 0x96, 0x3B, 0x2C, 0x77, 0xD8, 0x53, 0x76, 0xD8, 0x43, 0xBF, 0x87, 0x7D, 0xF9,
+	0x8F, 0x3B, 0xEC, 0x0F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8, 0x3D, 0x6E, 0x54, 0x31, 0x18,
+	0x85, 0xE1, 0x9E, 0x55, 0x64, 0x09, 0xF7, 0x5C, 0xDB, 0xD7, 0xF6, 0x06, 0xF8, 0x59, 0x46, 0x24,
+	0x52, 0x44, 0x1A, 0x05, 0x5A, 0x76, 0x0F, 0x74, 0xF0, 0x4C, 0x33, 0x12, 0x45, 0x84, 0xF4, 0x95,
+	0x76, 0xF5, 0x44, 0x99, 0xF1, 0x7B, 0x34, 0x6F, 0x2F, 0x4F, 0x19, 0x1F, 0xBE, 0x3F, 0xFF, 0xB8,
+	0x7D, 0x7B, 0xFE, 0xFA, 0x74, 0x7B, 0x7D, 0xFB, 0x75, 0xBE, 0x38, 0x4F, 0xCE, 0x8B, 0xF3, 0xFE,
+	0xFB, 0x7C, 0x1E, 0x9C, 0xC3, 0xF9, 0xE4, 0xDC, 0x38, 0x77, 0xCE, 0xF8, 0x4E, 0x7C, 0x27, 0xBE,
+	0x13, 0xDF, 0x89, 0xAF, 0xE1, 0x6B, 0xF8, 0x1A, 0xBE, 0x86, 0xAF, 0xE1, 0x6B, 0xF8, 0x1A, 0xBE,
+	0x86, 0xAF, 0xE1, 0x6B, 0xF8, 0x3A, 0xBE, 0x8E, 0xAF, 0xE3, 0xEB, 0xF8, 0x3A, 0xBE, 0x8E, 0xAF,
+	0xE3, 0xEB, 0xF8, 0x3A, 0xBE, 0x8E, 0x6F, 0xE0, 0x1B, 0xF8, 0x06, 0xBE, 0x81, 0x6F, 0xE0, 0x1B,
+	0xF8, 0x06, 0xBE, 0x81, 0x6F, 0xE0, 0x1B, 0xF8, 0x2E, 0x7C, 0x17, 0xBE, 0x0B, 0xDF, 0x85, 0xEF,
+	0xC2, 0x77, 0xE1, 0xBB, 0xF0, 0x5D, 0xF8, 0x2E, 0x7C, 0x17, 0xBE, 0x89, 0x6F, 0xE2, 0x9B, 0xF8,
+	0x26, 0xBE, 0x89, 0x6F, 0xE2, 0x9B, 0xF8, 0x26, 0xBE, 0x89, 0x6F, 0xE2, 0x5B, 0xF8, 0x16, 0xBE,
+	0x85, 0x6F, 0xE1, 0x5B, 0xF8, 0x16, 0xBE, 0x85, 0x6F, 0xE1, 0x5B, 0xF8, 0x16, 0xBE, 0x8D, 0x6F,
+	0xE3, 0xDB, 0xF8, 0x36, 0xBE, 0x8D, 0x6F, 0xE3, 0xDB, 0xF8, 0x36, 0xBE, 0x8D, 0x6F, 0xE3, 0xCB,
+	0x71, 0x78, 0x11, 0x2F, 0x4E, 0x2F, 0x9A, 0x17, 0xDD, 0x0B, 0x5F, 0xE9, 0xC3, 0x67, 0xFA, 0xF0,
+	0x9D, 0x3E, 0x7C, 0xA8, 0x0F, 0xA5, 0x51, 0x1A, 0xA5, 0x51, 0x1A, 0xA5, 0x51, 0x7A, 0xD7, 0x93,
+	0xBB, 0xA0, 0xDC, 0x15, 0xE5, 0x2E, 0x29, 0x36, 0x25, 0x46, 0x25, 0x56, 0x25, 0x66, 0x25, 0x76,
+	0x25, 0x86, 0x25, 0x96, 0x25, 0xA6, 0x25, 0xB6, 0x25, 0xC6, 0x25, 0xD6, 0x25, 0xE6, 0x25, 0xF6,
+	0x25, 0x06, 0x26, 0x16, 0x26, 0x26, 0x26, 0x36, 0x26, 0x46, 0x26, 0x56, 0x26, 0x66, 0x26, 0x76,
+	0x26, 0x86, 0x26, 0x96, 0x26, 0xA6, 0x26, 0xB6, 0x26, 0xC6, 0x26, 0xD6, 0x26, 0xE6, 0x26, 0xF6,
+	0x26, 0x06, 0x27, 0x16, 0x47, 0x27, 0x7D, 0x27, 0xA7, 0xD4, 0x8B, 0x58, 0xF0, 0x36, 0xF3, 0x14,
+	0xF2, 0xF2, 0xF0, 0x45, 0xF7, 0xEB, 0xE4, 0x87, 0xF6, 0xF7, 0xF9, 0xE3, 0x1F, 0x1F, 0x0D, 0xFF,
+	0x01, 0xFE, 0x99, 0x9C, 0x6B, 0x87, 0xD5, 0x0E, 0xAB, 0x1D, 0x56, 0x3B, 0xAC, 0x76, 0x58, 0xED,
+	0xB0, 0xDA, 0x61, 0xB5, 0xC3, 0x6A, 0x87, 0xFD, 0xC3, 0x0E, 0xBB, 0x3D, 0xB2, 0xC3, 0x3E, 0xD5,
+	0x0E, 0xAB, 0x1D, 0x56, 0x3B, 0xAC, 0x76, 0x58, 0xED, 0xB0, 0xDA, 0x61, 0xB5, 0xC3, 0x6A, 0x87,
+	0xD5, 0x0E, 0x7B, 0x97, 0x1D, 0xF6, 0xD0, 0xEF, 0x61, 0x9F, 0x6B, 0x87, 0xD5, 0x0E, 0xAB, 0x1D,
+	0x56, 0x3B, 0xAC, 0x76, 0x58, 0xED, 0xB0, 0xDA, 0x61, 0xB5, 0xC3, 0x6A, 0x87, 0xBD, 0xCB, 0x0E,
+	0x7B, 0xE8, 0xF7, 0xB0, 0x2F, 0xFF, 0xE9, 0x0E, 0xFB, 0x09, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8,
+	0x3B, 0x6E, 0x1B, 0x41, 0x10, 0x04, 0xD0, 0xDC, 0xA7, 0xE0, 0x11, 0x58, 0xC3, 0xF9, 0x5E, 0x41,
+	0xB6, 0x0E, 0x21, 0x40, 0x0E, 0x0C, 0x08, 0xB2, 0x53, 0xDF, 0xDE, 0x06, 0x14, 0x18, 0x7A, 0x4E,
+	0x98, 0x09, 0x10, 0x3A, 0xEC, 0x89, 0x1E, 0x87, 0xDB, 0x5B, 0x85, 0x7D, 0xFD, 0x7E, 0xB9, 0x5D,
+	0xBF, 0xFC, 0x7A, 0xFA, 0xFD, 0xF2, 0xF3, 0xE9, 0xF9, 0xF2, 0xF2, 0xE3, 0xF5, 0xEF, 0x1C, 0xE6,
+	0xC6, 0x7C, 0x63, 0xEE, 0xCC, 0x83, 0x79, 0x32, 0x2F, 0xE6, 0xCD, 0x7C, 0xDE, 0xCF, 0x1D, 0x5F,
+	0xC7, 0xD7, 0xF1, 0x75, 0x7C, 0x1D, 0x5F, 0xC7, 0xD7, 0xF1, 0x75, 0x7C, 0x1D, 0x5F, 0xC7, 0x37,
+	0xF0, 0x0D, 0x7C, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D,
+	0x7C, 0x13, 0xDF, 0xC4, 0x37, 0xF1, 0x4D, 0x7C, 0x13, 0xDF, 0xC4, 0x37, 0xF1, 0x4D, 0x7C, 0x13,
+	0xDF, 0xC4, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2,
+	0xB7, 0xF0, 0x2D, 0x7C, 0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0x6D, 0x7C, 0x1B, 0xDF, 0xC6, 0xB7, 0xF1,
+	0x6D, 0x7C, 0x1B, 0xDF, 0xC6, 0x77, 0xF0, 0x1D, 0x7C, 0x07, 0xDF, 0xC1, 0x77, 0xF0, 0x1D, 0x7C,
+	0x07, 0xDF, 0xC1, 0x77, 0xF0, 0x1D, 0x7C, 0xB9, 0x5E, 0x3D, 0x88, 0x07, 0xCD, 0x83, 0x9B, 0x07,
+	0xDD, 0x83, 0xE1, 0xC1, 0xF4, 0x60, 0x79, 0xB0, 0x3D, 0x50, 0x1A, 0xA5, 0x51, 0x1A, 0xA5, 0x51,
+	0x1A, 0xA5, 0x51, 0x1A, 0xA5, 0x51, 0x1A, 0xA5, 0x51, 0xDA, 0x94, 0x36, 0xA5, 0x4D, 0x69, 0x53,
+	0xDA, 0x94, 0x36, 0xA5, 0x4D, 0x69, 0x53, 0xDA, 0x94, 0x36, 0xA5, 0xC6, 0x4B, 0xCC, 0x97, 0x18,
+	0x30, 0x31, 0x61, 0x62, 0xC4, 0xC4, 0x8C, 0x89, 0x21, 0x13, 0x53, 0x26, 0xC6, 0x4C, 0xCC, 0x99,
+	0x18, 0x34, 0x31, 0x69, 0x62, 0xD4, 0xC4, 0xAC, 0x89, 0x61, 0x13, 0xD3, 0x26, 0xC6, 0x4D, 0xCC,
+	0x9B, 0x18, 0x38, 0x31, 0x71, 0x74, 0xBE, 0x1F, 0x8D, 0x6B, 0xD2, 0x8B, 0xB0, 0xE0, 0xDD, 0xCC,
+	0xAB, 0x90, 0x37, 0x0F, 0x8B, 0xEE, 0x3A, 0xF9, 0xD0, 0xFA, 0x68, 0xF8, 0x07, 0xF8, 0x33, 0x99,
+	0xBD, 0x39, 0x2F, 0xCE, 0x7B, 0xF3, 0xDA, 0xF0, 0xFD, 0x5B, 0x99, 0x87, 0xB7, 0xD9, 0x7B, 0xC3,
+	0xE7, 0xBE, 0xB8, 0x2E, 0x6E, 0x8B, 0xCB, 0xE2, 0xAE, 0xB8, 0x2A, 0x6E, 0x4A, 0xF5, 0xB0, 0xEA,
+	0x61, 0xD5, 0xC3, 0xAA, 0x87, 0x55, 0x0F, 0xAB, 0x1E, 0x56, 0x3D, 0xAC, 0x7A, 0xD8, 0xE7, 0xEF,
+	0x61, 0x97, 0x7B, 0x7A, 0xD8, 0xD7, 0xEA, 0x61, 0xD5, 0xC3, 0xAA, 0x87, 0x55, 0x0F, 0xAB, 0x1E,
+	0x56, 0x3D, 0xAC, 0x7A, 0x58, 0xF5, 0xB0, 0xEA, 0x61, 0x1F, 0xD2, 0xC3, 0xEE, 0xFA, 0x1E, 0xF6,
+	0xAD, 0x7A, 0x58, 0xF5, 0xB0, 0xEA, 0x61, 0xD5, 0xC3, 0xAA, 0x87, 0x55, 0x0F, 0xAB, 0x1E, 0x56,
+	0x3D, 0xAC, 0x7A, 0xD8, 0x87, 0xF4, 0xB0, 0xBB, 0xBE, 0x87, 0x3D, 0x56, 0x0F, 0xFB, 0xAF, 0x87,
+	0xFD, 0x01, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8, 0x39, 0x4E, 0x03, 0x41, 0x10, 0x05, 0xD0, 0x9C,
+	0x53, 0xF8, 0x08, 0xAE, 0xDE, 0xFB, 0x12, 0x2C, 0x47, 0xB0, 0x84, 0x03, 0x24, 0xCB, 0x90, 0x72,
+	0x7B, 0x48, 0xFD, 0x22, 0x47, 0x98, 0xA0, 0xC2, 0xAA, 0xE8, 0xB9, 0x3D, 0x7F, 0xFA, 0x6B, 0xAE,
+	0xE7, 0x43, 0xEB, 0x4F, 0x5F, 0xA7, 0xEF, 0xCB, 0xE7, 0xE9, 0xFD, 0x70, 0xF9, 0xB8, 0xFE, 0xCE,
+	0x83, 0x79, 0x32, 0x2F, 0xE6, 0x7D, 0x3B, 0xF7, 0x23, 0x73, 0x30, 0x17, 0xE6, 0xCA, 0xDC, 0x98,
+	0xF1, 0x75, 0x7C, 0x1D, 0x5F, 0xC7, 0xD7, 0xF1, 0x0D, 0x7C, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D,
+	0x7C, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0x03, 0xDF, 0xC4, 0x37, 0xF1, 0x4D, 0x7C, 0x13,
+	0xDF, 0xC4, 0x37, 0xF1, 0x4D, 0x7C, 0x13, 0xDF, 0xC4, 0x37, 0xF1, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2,
+	0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC6, 0xB7, 0xF1,
+	0x6D, 0x7C, 0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0x6D, 0x7C, 0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0xC5, 0xF1,
+	0xE8, 0x22, 0x5C, 0x14, 0x17, 0xD5, 0x45, 0x73, 0xD1, 0x5D, 0x0C, 0x17, 0xD3, 0xC5, 0x72, 0xA1,
+	0x34, 0x94, 0x86, 0xD2, 0x50, 0x1A, 0x4A, 0x43, 0x69, 0x28, 0x0D, 0xA5, 0xA1, 0x34, 0x94, 0x86,
+	0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x8B, 0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x8B, 0xD2, 0xA2,
+	0xB4, 0x28, 0xAD, 0x4A, 0xAB, 0xD2, 0xAA, 0xB4, 0x2A, 0xAD, 0x4A, 0xAB, 0xD2, 0xAA, 0xB4, 0x2A,
+	0xAD, 0x4A, 0xAB, 0xD2, 0xA6, 0xB4, 0x29, 0x6D, 0x4A, 0x9B, 0xD2, 0xA6, 0xD4, 0xDB, 0x26, 0xBC,
+	0x6E, 0xC2, 0xFB, 0x26, 0xBC, 0x70, 0xC2, 0x1B, 0x47, 0xE7, 0xED, 0x88, 0x11, 0xA1, 0x97, 0x0D,
+	0xEF, 0x66, 0x5E, 0x85, 0xBC, 0x79, 0x08, 0xBA, 0x71, 0xF2, 0xA1, 0xF5, 0xD1, 0xF0, 0x0F, 0xF0,
+	0x67, 0x32, 0x7B, 0x72, 0x1E, 0x9C, 0xE7, 0xE6, 0xB1, 0xE1, 0x33, 0x32, 0x26, 0xC6, 0xC0, 0x98,
+	0x17, 0xE3, 0x62, 0x5A, 0x0C, 0x8B, 0x59, 0x31, 0x2A, 0xB7, 0x49, 0x79, 0x3E, 0x18, 0x14, 0x73,
+	0x62, 0x4C, 0x4C, 0x89, 0x21, 0x31, 0x23, 0x46, 0xC4, 0x84, 0x18, 0x10, 0xF3, 0x61, 0x3C, 0x4C,
+	0x87, 0xE1, 0x30, 0x1B, 0x46, 0x23, 0x7B, 0x58, 0xF6, 0xB0, 0xEC, 0x61, 0xD9, 0xC3, 0xB2, 0x87,
+	0x65, 0x0F, 0xCB, 0x1E, 0x96, 0x3D, 0xEC, 0x7F, 0xF4, 0xB0, 0xF3, 0x3D, 0x3D, 0xEC, 0x25, 0x7B,
+	0x58, 0xF6, 0xB0, 0xEC, 0x61, 0xD9, 0xC3, 0xB2, 0x87, 0x65, 0x0F, 0xCB, 0x1E, 0x96, 0x3D, 0x2C,
+	0x7B, 0xD8, 0x43, 0x7A, 0xD8, 0x5D, 0xDF, 0xC3, 0x5E, 0xB3, 0x87, 0x65, 0x0F, 0xCB, 0x1E, 0x96,
+	0x3D, 0x2C, 0x7B, 0x58, 0xF6, 0xB0, 0xEC, 0x61, 0xD9, 0xC3, 0xB2, 0x87, 0x3D, 0xA4, 0x87, 0xDD,
+	0xF5, 0x3D, 0xEC, 0x2D, 0x7B, 0xD8, 0x9F, 0xF6, 0xB0, 0x1F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xEC,
+	0xD8, 0x3B, 0x4E, 0x43, 0x31, 0x14, 0x04, 0xD0, 0x9E, 0x55, 0x64, 0x09, 0xF1, 0x2F, 0xB6, 0xB7,
+	0xC1, 0x67, 0x01, 0x91, 0xA0, 0x40, 0x8A, 0x02, 0x2D, 0xBB, 0x87, 0x36, 0xA7, 0x4A, 0x17, 0x09,
+	0x4D, 0x79, 0x6F, 0x75, 0xE2, 0x78, 0xAC, 0xD1, 0xBB, 0x7E, 0x1C, 0x4E, 0xC7, 0xA7, 0xEF, 0xF3,
+	0xCF, 0xE5, 0xEB, 0xFC, 0x7E, 0xB8, 0x7C, 0x5E, 0xFF, 0xE6, 0xC2, 0x5C, 0x99, 0x1B, 0x73, 0x67,
+	0x1E, 0xCC, 0x27, 0xE6, 0xC9, 0xBC, 0x98, 0xF7, 0xED, 0x3C, 0xF1, 0x4D, 0x7C, 0x13, 0xDF, 0xC4,
+	0x37, 0xF1, 0x4D, 0x7C, 0x13, 0xDF, 0xC4, 0x37, 0xF1, 0x4D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF0,
+	0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF1, 0x6D, 0x7C,
+	0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0x6D, 0x7C, 0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0x6D, 0x7C, 0xE5, 0x78,
+	0x74, 0x51, 0x5C, 0x54, 0x17, 0xCD, 0x45, 0x77, 0x31, 0x5C, 0x9C, 0x5C, 0x4C, 0x17, 0xCB, 0x85,
+	0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x8B, 0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x8B, 0xD2, 0xA2,
+	0xB4, 0x28, 0xAD, 0x4A, 0xAB, 0xD2, 0xAA, 0xB4, 0x2A, 0xAD, 0x4A, 0xAB, 0xD2, 0xAA, 0xB4, 0x2A,
+	0xAD, 0x4A, 0xAB, 0xD2, 0xA6, 0xB4, 0x29, 0x6D, 0x4A, 0x9B, 0xD2, 0xA6, 0xB4, 0x29, 0x6D, 0x4A,
+	0x9B, 0xD2, 0xA6, 0xB4, 0x29, 0xED, 0x4A, 0xBB, 0xD2, 0xAE, 0xB4, 0x2B, 0xED, 0x4A, 0xBB, 0xD2,
+	0xAE, 0xB4, 0x2B, 0xED, 0x4A, 0x3B, 0x52, 0x9D, 0xB7, 0x23, 0x46, 0x84, 0xF8, 0x7C, 0xCB, 0x79,
+	0x0A, 0x79, 0x79, 0x08, 0xBA, 0x71, 0xF2, 0xD2, 0x7A, 0x35, 0xFC, 0x03, 0xFC, 0x99, 0xCC, 0x9E,
+	0x9C, 0x07, 0xE7, 0xB9, 0x79, 0x6C, 0xF8, 0x8C, 0x8C, 0x89, 0x31, 0x30, 0xE6, 0xC5, 0xB8, 0x98,
+	0x16, 0xC3, 0x62, 0x56, 0x8C, 0x8A, 0x49, 0x31, 0x28, 0xE6, 0xC4, 0x98, 0x98, 0x12, 0x43, 0x62,
+	0x46, 0x8C, 0x88, 0x09, 0x31, 0x20, 0x6D, 0x3F, 0xDF, 0xDE, 0x1C, 0x7C, 0xA6, 0xC3, 0x70, 0x98,
+	0x0D, 0xA3, 0x61, 0x32, 0x0C, 0x86, 0xB9, 0x30, 0x16, 0xA6, 0x62, 0xE0, 0x1B, 0xF8, 0x06, 0xBE,
+	0x81, 0x6F, 0x18, 0x0D, 0x7C, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0xE9, 0x61, 0xE9, 0x61,
+	0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xF7, 0xF7, 0xB0, 0xA7,
+	0x7B, 0x7A, 0xD8, 0x4B, 0x7A, 0x58, 0x7A, 0x58, 0x7A, 0x58, 0x7A, 0x58, 0x7A, 0x58, 0x7A, 0x58,
+	0x7A, 0x58, 0x7A, 0x58, 0x7A, 0xD8, 0x43, 0x7A, 0xD8, 0x5D, 0xDF, 0xC3, 0x5E, 0xD3, 0xC3, 0xD2,
+	0xC3, 0xD2, 0xC3, 0xD2, 0xC3, 0xD2, 0xC3, 0xD2, 0xC3, 0xD2, 0xC3, 0xD2, 0xC3, 0xD2, 0xC3, 0x1E,
+	0xD2, 0xC3, 0xEE, 0xFA, 0x1E, 0xF6, 0x96, 0x1E, 0xF6, 0x6F, 0x7A, 0xD8, 0x2F, 0x00, 0x00, 0x00,
+	0xFF, 0xFF, 0xEC, 0xD8, 0x3B, 0x4E, 0xC3, 0x50, 0x10, 0x05, 0xD0, 0x9E, 0x55, 0x64, 0x09, 0x99,
+	0xF7, 0xF5, 0xDB, 0x08, 0x9F, 0x32, 0x12, 0x14, 0x48, 0x56, 0xA0, 0x65, 0xF7, 0x20, 0x51, 0xA0,
+	0x9C, 0xCA, 0x5D, 0x24, 0x34, 0xE5, 0x4C, 0x75, 0x32, 0xF1, 0xB5, 0xAE, 0x7C, 0x7D, 0x3B, 0xCD,
+	0xFE, 0xF0, 0x79, 0xF9, 0xDA, 0x3F, 0x2E, 0xAF, 0xA7, 0xFD, 0xFD, 0xFA, 0x33, 0x0F, 0xE6, 0xC9,
+	0xBC, 0x31, 0xAF, 0xDB, 0x79, 0x3B, 0x33, 0x07, 0x73, 0x61, 0xAE, 0xCC, 0x8D, 0x19, 0xDF, 0x86,
+	0x6F, 0xC3, 0xB7, 0xE1, 0xDB, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B,
+	0xDF, 0xC2, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0x5F, 0x9C, 0xCF, 0x2E, 0xC2, 0x45, 0x71, 0x51, 0x5D,
+	0x34, 0x17, 0xDD, 0xC5, 0x70, 0x31, 0x5D, 0x6C, 0x2E, 0x94, 0x86, 0xD2, 0x50, 0x1A, 0x4A, 0x43,
+	0x69, 0x28, 0x0D, 0xA5, 0xA1, 0x34, 0x94, 0x86, 0xD2, 0x50, 0x5A, 0x94, 0x16, 0xA5, 0x45, 0x69,
+	0x51, 0x5A, 0x94, 0x16, 0xA5, 0x45, 0x69, 0x51, 0x5A, 0x94, 0x16, 0xA5, 0x55, 0x69, 0x55, 0x5A,
+	0x95, 0x56, 0xA5, 0x55, 0x69, 0x55, 0x5A, 0x95, 0x56, 0xA5, 0x55, 0x69, 0x55, 0xDA, 0x94, 0x36,
+	0xA5, 0x4D, 0x69, 0x53, 0xDA, 0x94, 0x36, 0xA5, 0x4D, 0x69, 0x53, 0xDA, 0x94, 0x36, 0xA4, 0x3A,
+	0x6F, 0x47, 0x8C, 0x08, 0xF1, 0xA1, 0xF3, 0x55, 0xC9, 0x9B, 0x87, 0xA0, 0x1B, 0x27, 0x1F, 0x5A,
+	0x1F, 0x0D, 0xFF, 0x00, 0x7F, 0x26, 0xB3, 0x97, 0xF3, 0x70, 0xDE, 0xCD, 0xB3, 0xE1, 0x33, 0x32,
+	0x26, 0xC6, 0xC0, 0x98, 0x17, 0xE3, 0x62, 0x5A, 0x0C, 0x8B, 0x59, 0x31, 0x2A, 0x26, 0xC5, 0xA0,
+	0x98, 0x13, 0x63, 0x62, 0x4A, 0x0C, 0x89, 0x19, 0x31, 0x22, 0x26, 0xC4, 0x80, 0x98, 0x0F, 0xE3,
+	0x61, 0x3A, 0x0C, 0x87, 0xD9, 0x30, 0x1A, 0x26, 0xC3, 0x60, 0x98, 0x8B, 0xDF, 0x58, 0x3C, 0xFE,
+	0xCD, 0xF8, 0x3A, 0xBE, 0x8E, 0xAF, 0xE3, 0xEB, 0xF8, 0xBA, 0xD1, 0xC0, 0xD7, 0xF1, 0x75, 0x7C,
+	0x9D, 0xFB, 0x75, 0x7C, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0x03, 0xDF, 0x30, 0xBB, 0xF8,
+	0x06, 0xBE, 0x81, 0x6F, 0xE0, 0x9B, 0xF8, 0x26, 0xBE, 0x89, 0x6F, 0xE2, 0x9B, 0xF8, 0xB2, 0x87,
+	0x65, 0x0F, 0xCB, 0x1E, 0x96, 0x3D, 0x2C, 0x7B, 0x58, 0xF6, 0xB0, 0xEC, 0x61, 0xFF, 0xAD, 0x87,
+	0xED, 0x47, 0x7A, 0xD8, 0x53, 0xF6, 0xB0, 0xEC, 0x61, 0xD9, 0xC3, 0xB2, 0x87, 0x65, 0x0F, 0xCB,
+	0x1E, 0x96, 0x3D, 0x2C, 0x7B, 0x58, 0xF6, 0xB0, 0xBB, 0xF4, 0xB0, 0x43, 0xDF, 0xC3, 0x9E, 0xB3,
+	0x87, 0x65, 0x0F, 0xCB, 0x1E, 0x96, 0x3D, 0x2C, 0x7B, 0x58, 0xF6, 0xB0, 0xEC, 0x61, 0xD9, 0xC3,
+	0xB2, 0x87, 0xDD, 0xA5, 0x87, 0x1D, 0xFA, 0x1E, 0xF6, 0x92, 0x3D, 0x2C, 0x7B, 0xD8, 0x81, 0x1E,
+	0xF6, 0x0D, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8, 0x3B, 0x4A, 0x43, 0x51, 0x14, 0x05, 0xD0, 0xDE,
+	0x51, 0x64, 0x08, 0xB9, 0xFF, 0x9B, 0x52, 0x9D, 0x85, 0x5D, 0x40, 0x0B, 0x21, 0x44, 0x5B, 0x67,
+	0xAF, 0x20, 0x08, 0xAE, 0x2A, 0x5D, 0x9A, 0x5D, 0x9E, 0x53, 0xAD, 0x9C, 0xBC, 0xFD, 0xD8, 0xBC,
+	0xEB, 0xDB, 0xE1, 0x74, 0x7C, 0xF8, 0x3C, 0x7F, 0x5D, 0x3E, 0xCE, 0xAF, 0x87, 0xCB, 0xFB, 0xF5,
+	0x67, 0x2E, 0xCC, 0x95, 0xB9, 0x31, 0x77, 0xE6, 0xC1, 0x3C, 0x99, 0x17, 0xF3, 0x66, 0x3E, 0xFD,
+	0x9F, 0xCB, 0xF1, 0xE8, 0xA2, 0xB8, 0xA8, 0x2E, 0x9A, 0x8B, 0xEE, 0x62, 0xB8, 0x98, 0x2E, 0x96,
+	0x8B, 0xED, 0x42, 0x69, 0x51, 0x5A, 0x94, 0x16, 0xA5, 0x45, 0x69, 0x51, 0x5A, 0x94, 0x16, 0xA5,
+	0x45, 0x69, 0x51, 0x5A, 0x94, 0x56, 0xA5, 0x55, 0x69, 0x55, 0x5A, 0x95, 0x56, 0xA5, 0x55, 0x69,
+	0x55, 0x5A, 0x95, 0x56, 0xA5, 0x55, 0x69, 0x53, 0xDA, 0x94, 0x36, 0xA5, 0x4D, 0x69, 0x53, 0xDA,
+	0x94, 0x36, 0xA5, 0x4D, 0x69, 0x53, 0xDA, 0x94, 0x76, 0xA5, 0x5D, 0x69, 0x57, 0xDA, 0x95, 0x76,
+	0xA5, 0x5D, 0x69, 0x57, 0xDA, 0x95, 0x76, 0xA5, 0x1D, 0xA9, 0xCE, 0xFF, 0x23, 0x46, 0x84, 0xF8,
+	0xD0, 0x61, 0x43, 0x66, 0xD0, 0x8D, 0x93, 0x0F, 0xAD, 0x8F, 0x86, 0x7F, 0x80, 0x3F, 0x93, 0xD9,
+	0xCB, 0x79, 0x38, 0xEF, 0xE6, 0xD9, 0xF0, 0x19, 0x19, 0x13, 0x63, 0x60, 0xCC, 0x8B, 0x71, 0x31,
+	0x2D, 0x86, 0xC5, 0xAC, 0x18, 0x15, 0x93, 0x62, 0x50, 0xCC, 0x89, 0x31, 0x31, 0x25, 0x86, 0xC4,
+	0x8C, 0x18, 0x11, 0x13, 0x62, 0x40, 0xCC, 0x87, 0xF1, 0x30, 0x1D, 0x86, 0xC3, 0x6C, 0x18, 0x0D,
+	0x93, 0x61, 0x30, 0xCC, 0x85, 0xB1, 0x30, 0x15, 0x03, 0xDF, 0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0xC3,
+	0x68, 0xE0, 0x1B, 0xF8, 0xC6, 0x9F, 0xEF, 0xE5, 0x77, 0xC6, 0x37, 0xF0, 0x4D, 0x7C, 0x13, 0xDF,
+	0xC4, 0x37, 0xF1, 0x4D, 0x7C, 0xD3, 0xEC, 0xE2, 0x9B, 0xDC, 0x6F, 0xE2, 0x9B, 0xF8, 0x16, 0xBE,
+	0x85, 0x6F, 0xE1, 0x5B, 0xF8, 0x16, 0xBE, 0x85, 0x6F, 0xF9, 0x72, 0xC1, 0xB7, 0xF0, 0x2D, 0x7C,
+	0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0x6D, 0x7C, 0x1B, 0xDF, 0xC6, 0xB7, 0xF1, 0x6D, 0xDF, 0x7E, 0xF8,
+	0x36, 0xBE, 0xF4, 0xB0, 0xF4, 0xB0, 0xF4, 0xB0, 0xF4, 0xB0, 0xF4, 0xB0, 0xF4, 0xB0, 0xF4, 0xB0,
+	0x7B, 0xF4, 0xB0, 0xC3, 0x2D, 0x3D, 0xEC, 0x31, 0x3D, 0x2C, 0x3D, 0x2C, 0x3D, 0x2C, 0x3D, 0x2C,
+	0x3D, 0x2C, 0x3D, 0x2C, 0x3D, 0x2C, 0x3D, 0x2C, 0x3D, 0xEC, 0x2E, 0x3D, 0xEC, 0xA6, 0xEF, 0x61,
+	0x4F, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9, 0x61, 0xE9,
+	0x61, 0xE9, 0x61, 0x77, 0xE9, 0x61, 0x37, 0x7D, 0x0F, 0x7B, 0x4E, 0x0F, 0x4B, 0x0F, 0xBB, 0x73,
+	0x0F, 0xFB, 0x06, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8, 0x3B, 0x4E, 0x03, 0x31, 0x18, 0x85, 0xD1,
+	0x9E, 0x55, 0xCC, 0x12, 0xC6, 0x6F, 0xBB, 0xE7, 0xB1, 0x8E, 0x91, 0x48, 0x81, 0x14, 0x01, 0x2D,
+	0xBB, 0xA7, 0x43, 0xCA, 0x99, 0x26, 0x5D, 0x24, 0xF4, 0x97, 0x71, 0x75, 0x62, 0xF8, 0xAC, 0xAB,
+	0x1C, 0xEF, 0xDB, 0xF5, 0xE3, 0xF3, 0xB2, 0xA5, 0xBD, 0x3D, 0x7D, 0x1F, 0x3F, 0xD7, 0xAF, 0xE3,
+	0xEF, 0xA0, 0x7B, 0x30, 0x3C, 0x98, 0x1E, 0x2C, 0x0E, 0xD2, 0xEE, 0x41, 0xF2, 0x20, 0x7B, 0x50,
+	0x3C, 0xA8, 0x1E, 0x28, 0x4D, 0x4A, 0x93, 0xD2, 0xA4, 0x34, 0x29, 0xCD, 0x4A, 0xB3, 0xD2, 0xAC,
+	0x34, 0x2B, 0xCD, 0x4A, 0xB3, 0xD2, 0xAC, 0x34, 0x2B, 0xCD, 0x4A, 0xB3, 0xD2, 0xA2, 0xB4, 0x28,
+	0x2D, 0x4A, 0x8B, 0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x8B, 0xD2, 0xA2, 0xB4, 0x28, 0xAD, 0x4A,
+	0xAB, 0xD2, 0xAA, 0xB4, 0x2A, 0xAD, 0x4A, 0xAB, 0xD2, 0xAA, 0xB4, 0x2A, 0xAD, 0x4A, 0x2B, 0x52,
+	0x9D, 0xB7, 0x1F, 0x31, 0x22, 0xC4, 0x87, 0x0E, 0x1B, 0x32, 0x5C, 0xDE, 0xDF, 0x29, 0x1E, 0xFF,
+	0x35, 0xFC, 0x03, 0xF8, 0x35, 0xF9, 0xEC, 0xCD, 0x79, 0x71, 0xDE, 0x9B, 0xD7, 0x86, 0xCF, 0x64,
+	0x2C, 0xC6, 0x60, 0xEC, 0xC5, 0x5C, 0xAC, 0xC5, 0x58, 0x6C, 0xC5, 0x54, 0x2C, 0xC5, 0x50, 0xEC,
+	0xC4, 0x4C, 0xAC, 0xC4, 0x48, 0x6C, 0xC4, 0x44, 0x2C, 0xC4, 0x40, 0xEC, 0xC3, 0x3C, 0xAC, 0xC3,
+	0x38, 0x6C, 0xC3, 0x34, 0x2C, 0xC3, 0x30, 0xEC, 0xC2, 0x2C, 0xAC, 0xA2, 0xE1, 0x6B, 0xF8, 0x1A,
+	0xBE, 0x86, 0xAF, 0x99, 0x06, 0xBE, 0x86, 0xAF, 0xE1, 0x6B, 0xF8, 0x1A, 0xBE, 0x8E, 0xAF, 0xE3,
+	0xEB, 0xF8, 0x3A, 0xBE, 0x8E, 0xAF, 0xDB, 0xEE, 0x8D, 0xEF, 0x79, 0xEB, 0xF8, 0x3A, 0xBE, 0x8E,
+	0x6F, 0xE0, 0x1B, 0xF8, 0x06, 0xBE, 0x81, 0x6F, 0xE0, 0x1B, 0xF8, 0x86, 0x8F, 0x0B, 0xBE, 0x81,
+	0x6F, 0xE0, 0x9B, 0xF8, 0x26, 0xBE, 0x89, 0x6F, 0xE2, 0x9B, 0xF8, 0x26, 0xBE, 0x89, 0x6F, 0xFA,
+	0xFA, 0xE1, 0x9B, 0xF8, 0x16, 0xBE, 0x85, 0x6F, 0xE1, 0x5B, 0xF8, 0x16, 0xBE, 0x85, 0x6F, 0xE1,
+	0x5B, 0xF8, 0x96, 0xCF, 0xF3, 0xE9, 0x7D, 0xF6, 0x81, 0xDE, 0x7D, 0xA1, 0x77, 0x9F, 0xE8, 0xDD,
+	0x37, 0x7A, 0xF7, 0x91, 0x8E, 0x1D, 0x16, 0x3B, 0x2C, 0x76, 0x58, 0xEC, 0xB0, 0xD8, 0x61, 0xB1,
+	0xC3, 0x62, 0x87, 0x9D, 0x77, 0xD8, 0xE5, 0x9E, 0x1D, 0xF6, 0x12, 0x3B, 0x2C, 0x76, 0x58, 0xEC,
+	0xB0, 0xD8, 0x61, 0xB1, 0xC3, 0x62, 0x87, 0xC5, 0x0E, 0x8B, 0x1D, 0x16, 0x3B, 0xEC, 0x21, 0x3B,
+	0xEC, 0xAE, 0xDF, 0xC3, 0x5E, 0x63, 0x87, 0xC5, 0x0E, 0x8B, 0x1D, 0x16, 0x3B, 0x2C, 0x76, 0x58,
+	0xEC, 0xB0, 0xD8, 0x61, 0xB1, 0xC3, 0x62, 0x87, 0x3D, 0x64, 0x87, 0xDD, 0xF5, 0x7B, 0xD8, 0x5B,
+	0xEC, 0xB0, 0xD8, 0x61, 0xFF, 0x78, 0x87, 0xFD, 0x02, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8, 0x3B,
+	0x4E, 0xC3, 0x40, 0x14, 0x05, 0xD0, 0x3E, 0xAB, 0xF0, 0x12, 0xC6, 0x99, 0xFF, 0x0E, 0x80, 0xAC,
+	0x22, 0x12, 0x14, 0x48, 0x11, 0xD0, 0xB2, 0x7B, 0x0A, 0xAA, 0x9C, 0x69, 0x2C, 0x9A, 0x08, 0xE9,
+	0x95, 0x7E, 0xD5, 0xF1, 0x24, 0xF7, 0xCD, 0x95, 0xB7, 0xDB, 0xFB, 0xC7, 0xDB, 0xB6, 0xEF, 0xF3,
+	0xF4, 0x75, 0xFD, 0xBE, 0x7D, 0x5E, 0x5F, 0xB7, 0xDF, 0xC1, 0x39, 0x39, 0xD8, 0x1D, 0x9C, 0x1D,
+	0x64, 0x07, 0xC5, 0x41, 0x75, 0xD0, 0x1C, 0x74, 0x07, 0xC3, 0x81, 0xD2, 0xAC, 0x34, 0x2B, 0xCD,
+	0x4A, 0xB3, 0xD2, 0xAC, 0x34, 0x2B, 0xCD, 0x4A, 0xB3, 0xD2, 0xAC, 0x34, 0x2B, 0x2D, 0x4A, 0x8B,
+	0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x8B, 0xD2, 0xA2, 0xB4, 0x28, 0x2D, 0x4A, 0x0B, 0x52, 0x9D,
+	0xF7, 0x8F, 0x18, 0x11, 0xE2, 0x43, 0x87, 0x0D, 0x19, 0x2E, 0xCF, 0x4F, 0xD6, 0xF2, 0x8F, 0xF4,
+	0x07, 0xF0, 0x35, 0x79, 0xF6, 0xE4, 0x3C, 0x38, 0xCF, 0xCD, 0x63, 0xC3, 0x67, 0x64, 0x4C, 0x8C,
+	0x81, 0x31, 0x2F, 0xC6, 0xC5, 0xB4, 0x18, 0x16, 0xB3, 0x62, 0x54, 0x4C, 0x8A, 0x41, 0x31, 0x27,
+	0xC6, 0xC4, 0x94, 0x18, 0x12, 0x33, 0x62, 0x44, 0x4C, 0x88, 0x01, 0x31, 0x1F, 0xC6, 0xC3, 0x74,
+	0x18, 0x0E, 0xB3, 0x61, 0x34, 0x4C, 0x86, 0xC1, 0x30, 0x17, 0xC6, 0xC2, 0x54, 0x54, 0x7C, 0x15,
+	0x5F, 0xC5, 0x57, 0xF1, 0x55, 0xA3, 0x81, 0xAF, 0xE2, 0xAB, 0xF8, 0x2A, 0xBE, 0x8A, 0xAF, 0xE1,
+	0x6B, 0xF8, 0x1A, 0xBE, 0x86, 0xAF, 0xE1, 0x6B, 0x66, 0x17, 0x5F, 0xC3, 0xD7, 0xF0, 0x35, 0x7C,
+	0x1D, 0x5F, 0xC7, 0xD7, 0xF1, 0x75, 0x7C, 0x1D, 0x5F, 0xC7, 0xD7, 0xDB, 0xD3, 0xFD, 0x33, 0xBE,
+	0x8E, 0xAF, 0xE3, 0x1B, 0xF8, 0x06, 0xBE, 0x81, 0x6F, 0xE0, 0x1B, 0xF8, 0x06, 0xBE, 0xC1, 0xF9,
+	0x0D, 0xB7, 0x1F, 0xBE, 0x81, 0x6F, 0xE2, 0x9B, 0xF8, 0x26, 0xBE, 0x89, 0x6F, 0xE2, 0x9B, 0xF8,
+	0x26, 0xBE, 0x89, 0x6F, 0xBA, 0x9E, 0x97, 0xFD, 0xEC, 0x82, 0x4E, 0x6E, 0xE8, 0xE4, 0x8A, 0x4E,
+	0xEE, 0xE8, 0xE4, 0x92, 0x4E, 0x6E, 0xE9, 0xE4, 0x9A, 0x4E, 0xEE, 0xE9, 0xE4, 0xA2, 0x4E, 0x4A,
+	0xD7, 0xAB, 0x44, 0xE9, 0x72, 0x99, 0x2C, 0xB7, 0xC9, 0x72, 0x9D, 0x2C, 0xF7, 0xC9, 0x72, 0xA1,
+	0x2C, 0x37, 0xCA, 0x72, 0xA5, 0x44, 0x0F, 0x8B, 0x1E, 0x16, 0x3D, 0x2C, 0x7A, 0x58, 0xF4, 0xB0,
+	0xE8, 0x61, 0xFF, 0xB7, 0x87, 0x9D, 0x8E, 0xF4, 0xB0, 0xE7, 0xE8, 0x61, 0xD1, 0xC3, 0xA2, 0x87,
+	0x45, 0x0F, 0x8B, 0x1E, 0x16, 0x3D, 0x2C, 0x7A, 0x58, 0xF4, 0xB0, 0xE8, 0x61, 0x0F, 0xE9, 0x61,
+	0x87, 0xBE, 0x87, 0xBD, 0x44, 0x0F, 0x8B, 0x1E, 0x16, 0x3D, 0x2C, 0x7A, 0x58, 0xF4, 0xB0, 0xE8,
+	0x61, 0xD1, 0xC3, 0xA2, 0x87, 0x45, 0x0F, 0x7B, 0x48, 0x0F, 0x3B, 0xF4, 0x3D, 0xEC, 0x12, 0x3D,
+	0x2C, 0x7A, 0x58, 0xF4, 0xB0, 0x3F, 0xF5, 0xB0, 0x1F, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xEC, 0xD8,
+	0x3D, 0x4A, 0x43, 0x41, 0x14, 0x06, 0xD0, 0xDE, 0x55, 0x64, 0x09, 0x33, 0xF3, 0xE6, 0x77, 0x0F,
+	0xEA, 0x1E, 0x02, 0x5A, 0x04, 0x82, 0xDA, 0xBA, 0x7B, 0x21, 0x8D, 0x78, 0xA6, 0x49, 0x23, 0x82,
+	0xDC, 0xF2, 0x4D, 0x75, 0xB8, 0xE1, 0xDE, 0xEF, 0x23, 0x97, 0xB7, 0xD7, 0x53, 0x3E, 0x8E, 0x87,
+	0x8F, 0xF3, 0xE7, 0xF5, 0xFD, 0xFC, 0x72, 0xBA, 0x5E, 0x6E, 0x0F, 0xD5, 0x87, 0xE6, 0x43, 0xF7,
+	0x61, 0xF8, 0x30, 0x7D, 0x58, 0x3C, 0xD4, 0xE4, 0x43, 0xF6, 0xA1, 0xF8, 0xA0, 0xB4, 0x2A, 0xAD,
+	0x4A, 0xAB, 0xD2, 0xAA, 0xB4, 0x2A, 0xAD, 0x48, 0x75, 0xFE, 0xFC, 0xC4, 0x88, 0x10, 0x1F, 0x3A,
+	0x6C, 0xC8, 0x70, 0x39, 0x3F, 0x59, 0x4E, 0xCF, 0xE1, 0x6D, 0xB3, 0xE3, 0xDB, 0xC9, 0x39, 0x38,
+	0xE7, 0xE6, 0xD8, 0xF0, 0x15, 0x7C, 0xC5, 0xB9, 0xE1, 0x2B, 0xF8, 0x0A, 0xBE, 0x82, 0xAF, 0xE0,
+	0x2B, 0xF8, 0x0A, 0xBE, 0x82, 0xEF, 0xC0, 0x77, 0xE0, 0x3B, 0xFC, 0x61, 0xF1, 0xB9, 0x24, 0xEE,
+	0x88, 0x2B, 0xE2, 0x86, 0xB8, 0x20, 0xEE, 0x87, 0xEB, 0xE1, 0x76, 0xB8, 0x1C, 0xEE, 0x86, 0xAB,
+	0xE1, 0x66, 0xB8, 0x18, 0xEE, 0x85, 0x6B, 0xE1, 0x56, 0x34, 0x7C, 0x0D, 0x5F, 0xC3, 0xD7, 0xF0,
+	0x35, 0x57, 0x03, 0x5F, 0xC3, 0xD7, 0xF0, 0x35, 0x7C, 0x0D, 0x5F, 0xC7, 0xD7, 0xF1, 0x75, 0x7C,
+	0x1D, 0x5F, 0xC7, 0xD7, 0xDD, 0x5D, 0x7C, 0x1D, 0x5F, 0xC7, 0xD7, 0xF1, 0x0D, 0x7C, 0x03, 0xDF,
+	0xC0, 0x37, 0xF0, 0x0D, 0x7C, 0x03, 0xDF, 0xF0, 0xB8, 0xE0, 0x1B, 0xF8, 0x06, 0xBE, 0x89, 0x6F,
+	0xE2, 0x9B, 0xF8, 0x26, 0xBE, 0x89, 0x6F, 0xDE, 0x7C, 0x8F, 0xDF, 0xDF, 0xF8, 0xA6, 0xD7, 0x0F,
+	0xDF, 0xC4, 0xB7, 0xF0, 0x2D, 0x7C, 0x0B, 0xDF, 0xC2, 0xB7, 0xF0, 0x2D, 0xE6, 0xB7, 0xF0, 0x2D,
+	0x7C, 0xCB, 0xF3, 0xBC, 0xDD, 0x67, 0x0F, 0x74, 0xF2, 0x42, 0x27, 0x4F, 0x74, 0xF2, 0x46, 0x27,
+	0x8F, 0x74, 0xF2, 0x4A, 0x27, 0xCF, 0x74, 0xF2, 0x4E, 0x27, 0x0F, 0x75, 0x52, 0xBA, 0x47, 0x89,
+	0xD2, 0x2D, 0x4C, 0xB6, 0x34, 0xD9, 0xE2, 0x64, 0xCB, 0x93, 0x2D, 0x50, 0xB6, 0x44, 0xD9, 0x22,
+	0xC5, 0x4C, 0xC9, 0x86, 0x4A, 0x2E, 0x5B, 0xEA, 0x29, 0x35, 0x57, 0xB2, 0xC1, 0x92, 0x4D, 0x96,
+	0x6C, 0xB4, 0x64, 0xB3, 0x25, 0x1B, 0x2E, 0xD9, 0x74, 0xC9, 0xC6, 0x4B, 0x36, 0x5F, 0xF2, 0xB1,
+	0x05, 0x74, 0xF4, 0xB0, 0xE8, 0x61, 0xD1, 0xC3, 0xA2, 0x87, 0x45, 0x0F, 0x8B, 0x1E, 0xF6, 0xCB,
+	0x3D, 0xEC, 0x7A, 0x4F, 0x0F, 0x7B, 0x8A, 0x1E, 0x16, 0x3D, 0x2C, 0x7A, 0x58, 0xF4, 0xB0, 0xE8,
+	0x61, 0xD1, 0xC3, 0xA2, 0x87, 0x45, 0x0F, 0x8B, 0x1E, 0xF6, 0x27, 0x3D, 0xEC, 0xAE, 0xFF, 0xC3,
+	0x9E, 0xA3, 0x87, 0x45, 0x0F, 0x8B, 0x1E, 0xF6, 0xBF, 0x7B, 0xD8, 0x17, 0x00, 0x00, 0x00, 0xFF,
+	0xFF, 0x03, 0x00, 0x50, 0x4B, 0x01, 0x02, 0x14, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x21, 0x00, 0x03, 0x69, 0xF1, 0x0F, 0xC8, 0x00, 0x00, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x0A,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x73, 0x74, 0x6F, 0x72, 0x65, 0x64, 0x2E, 0x62, 0x69, 0x6E, 0x50, 0x4B, 0x01, 0x02, 0x14,
+	0x00, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0xE6, 0x4A, 0x66, 0xB0, 0x89,
+	0x03, 0x00, 0x00, 0x84, 0x03, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x6C, 0x65, 0x76, 0x65, 0x6C, 0x30, 0x2E,
+	0x74, 0x78, 0x74, 0x50, 0x4B, 0x01, 0x02, 0x14, 0x00, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x21, 0x00, 0xE6, 0x4A, 0x66, 0xB0, 0x37, 0x00, 0x00, 0x00, 0x84, 0x03, 0x00, 0x00, 0x09,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA1, 0x04, 0x00,
+	0x00, 0x66, 0x69, 0x78, 0x65, 0x64, 0x2E, 0x74, 0x78, 0x74, 0x50, 0x4B, 0x01, 0x02, 0x14, 0x00,
+	0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x21, 0x00, 0xDD, 0x59, 0x38, 0x15, 0x5F, 0x04,
+	0x00, 0x00, 0x40, 0x7D, 0x01, 0x00, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xFF, 0x04, 0x00, 0x00, 0x64, 0x79, 0x6E, 0x61, 0x6D, 0x69, 0x63, 0x2E,
+	0x62, 0x69, 0x6E, 0x50, 0x4B, 0x01, 0x02, 0x14, 0x00, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+	0x00, 0x21, 0x00, 0xDD, 0x59, 0x38, 0x15, 0x34, 0x10, 0x00, 0x00, 0x40, 0x7D, 0x01, 0x00, 0x0A,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x87, 0x09, 0x00,
+	0x00, 0x62, 0x6C, 0x6F, 0x63, 0x6B, 0x73, 0x2E, 0x62, 0x69, 0x6E, 0x50, 0x4B, 0x05, 0x06, 0x00,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x05, 0x00, 0x18, 0x01, 0x00, 0x00, 0xE3, 0x19, 0x00, 0x00, 0x00,
+	0x00,
+};
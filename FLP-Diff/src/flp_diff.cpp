@@ -0,0 +1,306 @@
+#include <cstdio>     // printf, fprintf
+#include <filesystem> // path
+#include <chrono>     // high_resolution_clock
+#include <cstddef>    // offsetof
+#include <cstdint>    // uint32_t, int64_t
+#include <cstring>    // memcpy
+#include <charconv>   // from_chars
+#include <string>     // string
+#include <string_view> // string_view, u16string_view
+#include <vector>     // vector
+#include <optional>   // optional
+#include <span>       // span
+
+#include "flp_view_stream.h"
+#include "flp_diff.h"
+#include "flp_utf_conversions.h"
+
+#include "wide_main.h"
+
+
+using namespace Om;
+
+// printf format of std::filesystem::path::c_str()
+#ifdef _WIN32
+#define OM_PATH_FORMAT "%ls"
+#else
+#define OM_PATH_FORMAT "%s"
+#endif
+
+// longer strings are cut in the output
+constexpr std::size_t max_string_length = 120;
+
+// the events of one file, payloads point into its mapping
+struct EventList {
+	explicit EventList(std::filesystem::path const& path) :
+		flp { path } {
+		for(; flp.has_event(); ++flp) {
+			events.push_back(*flp);
+			if(flp->type == FLPEventType::FLP_Version) {
+				auto const* str = reinterpret_cast<char const*>(flp->data.data());
+				std::from_chars(str, str + flp->data.size(), major_version);
+			}
+		}
+	}
+
+	FLPMappedInStream flp;
+	std::vector<FLPEventView> events;
+	int major_version = 0;
+};
+
+struct RecordField {
+	char const* name;
+	std::size_t offset;
+	std::size_t size;
+	bool is_signed;
+};
+
+constexpr RecordField note_fields[] = {
+	{ "position",     offsetof(FLPPatternNoteRecord, position),     4, false },
+	{ "length",       offsetof(FLPPatternNoteRecord, length),       4, false },
+	{ "key",          offsetof(FLPPatternNoteRecord, key),          1, false },
+	{ "velocity",     offsetof(FLPPatternNoteRecord, velocity),     1, false },
+	{ "channel",      offsetof(FLPPatternNoteRecord, rack_channel), 2, false },
+	{ "pan",          offsetof(FLPPatternNoteRecord, pan),          1, false },
+	{ "fine_pitch",   offsetof(FLPPatternNoteRecord, fine_pitch),   1, false },
+	{ "release",      offsetof(FLPPatternNoteRecord, release),      1, false },
+	{ "mod_x",        offsetof(FLPPatternNoteRecord, mod_x),        1, false },
+	{ "mod_y",        offsetof(FLPPatternNoteRecord, mod_y),        1, false },
+	{ "flags",        offsetof(FLPPatternNoteRecord, flags),        2, false },
+	{ "midi_channel", offsetof(FLPPatternNoteRecord, midi_channel), 1, false },
+	{ "group_id",     offsetof(FLPPatternNoteRecord, group_id),     1, false },
+};
+
+constexpr RecordField clip_fields[] = {
+	{ "position",     offsetof(FLPPlaylistClipRecord, position),     4, false },
+	{ "duration",     offsetof(FLPPlaylistClipRecord, duration),     4, false },
+	{ "source_index", offsetof(FLPPlaylistClipRecord, source_index), 2, false },
+	{ "lane_index",   offsetof(FLPPlaylistClipRecord, lane_index),   2, false },
+	{ "flags",        offsetof(FLPPlaylistClipRecord, flags),        1, false },
+	{ "group",        offsetof(FLPPlaylistClipRecord, group),        1, false },
+	{ "window_start", offsetof(FLPPlaylistClipRecord, window_start), 4, true },
+	{ "window_end",   offsetof(FLPPlaylistClipRecord, window_end),   4, true },
+};
+
+// number of fields printed for inserted and removed records
+constexpr std::size_t n_main_note_fields = 5;
+constexpr std::size_t n_main_clip_fields = 4;
+
+static long long read_field(std::byte const* record, RecordField const& field) {
+	std::uint32_t u = 0;
+	std::memcpy(&u, record + field.offset, field.size); // little endian
+	if(field.is_signed)
+		return static_cast<std::int32_t>(u);
+	return u;
+}
+
+// the event's payload as UTF-8 text without the terminating zero
+static std::string event_text(FLPEventView const& e, int major_version) {
+	std::string text;
+	if(detail::payload_kind(e.type) == detail::PayloadKind::string && major_version >= 12) {
+		auto const* str = reinterpret_cast<char16_t const*>(e.data.data());
+		std::size_t len = e.data.size() / 2;
+		if(len > 0 && load_utf16_unit(str + len - 1) == u'\0')
+			--len;
+		if(utf16_to_utf8(std::u16string_view(str, len), &text))
+			text = "<invalid UTF-16>";
+	} else {
+		text.assign(reinterpret_cast<char const*>(e.data.data()), e.data.size());
+		if(!text.empty() && text.back() == '\0')
+			text.pop_back();
+	}
+	if(text.size() > max_string_length) {
+		// don't cut a UTF-8 sequence
+		std::size_t n = max_string_length;
+		while(n > 0 && (static_cast<unsigned char>(text[n]) & 0xC0) == 0x80) {
+			--n;
+		}
+		text.resize(n);
+		text += "...";
+	}
+	for(char& c : text) {
+		if(static_cast<unsigned char>(c) < 0x20)
+			c = ' ';
+	}
+	return text;
+}
+
+static std::size_t record_size(FLPEventType type) {
+	return type == FLPEventType::FLP_PatNoteRecChan ? sizeof(FLPPatternNoteRecord) : sizeof(FLPPlaylistClipRecord);
+}
+
+static bool has_records(FLPEventType type) {
+	return type == FLPEventType::FLP_PatNoteRecChan || type == FLPEventType::FLP_PLRecChan;
+}
+
+static void print_value(FLPEventView const& e, int major_version) {
+	switch(static_cast<std::uint8_t>(e.type) / 64) {
+	case 0:
+		std::printf("%u", e.u8);
+		return;
+	case 1:
+		std::printf("%d", e.i16);
+		return;
+	case 2:
+		std::printf("%d", e.i32);
+		return;
+	}
+	switch(detail::payload_kind(e.type)) {
+	case detail::PayloadKind::ansi_string:
+	case detail::PayloadKind::string:
+	{
+		std::string const text = event_text(e, major_version);
+		std::printf("\"%s\"", text.c_str());
+		return;
+	}
+	case detail::PayloadKind::pattern_notes:
+		std::printf("%zu notes", e.data.size() / sizeof(FLPPatternNoteRecord));
+		return;
+	case detail::PayloadKind::playlist_clips:
+		std::printf("%zu clips", e.data.size() / sizeof(FLPPlaylistClipRecord));
+		return;
+	default:
+		std::printf("%zu bytes", e.data.size());
+		return;
+	}
+}
+
+// flp_event_name has no name for some ids
+static char const* event_name(FLPEventType type) noexcept {
+	char const* const name = flp_event_name(type);
+	return (name ? name : "Unknown");
+}
+
+static void print_event(char sign, std::uint32_t index, FLPEventView const& e, int major_version) {
+	std::printf("%c [%u] %s ", sign, index, event_name(e.type));
+	print_value(e, major_version);
+	std::putchar('\n');
+}
+
+static void print_record(char sign, std::uint32_t index, std::byte const* record, std::span<RecordField const> fields) {
+	std::printf("    %c %u:", sign, index);
+	char const* separator = " ";
+	for(RecordField const& field : fields) {
+		std::printf("%s%s %lld", separator, field.name, read_field(record, field));
+		separator = ", ";
+	}
+	std::putchar('\n');
+}
+
+static void print_record_change(std::uint32_t a_index, std::byte const* a, std::uint32_t b_index, std::byte const* b,
+                                std::span<RecordField const> fields) {
+	std::printf("    ~ %u -> %u:", a_index, b_index);
+	char const* separator = " ";
+	for(RecordField const& field : fields) {
+		long long const old_value = read_field(a, field);
+		long long const new_value = read_field(b, field);
+		if(old_value != new_value) {
+			std::printf("%s%s %lld -> %lld", separator, field.name, old_value, new_value);
+			separator = ", ";
+		}
+	}
+	// only bytes without a known meaning differ
+	if(*separator == ' ')
+		std::fputs(" unknown bytes", stdout);
+	std::putchar('\n');
+}
+
+static void print_changed_event(FLPEventDiff const& diff, EventList const& a, EventList const& b) {
+	FLPEventView const& old_event = a.events[diff.a_index];
+	FLPEventView const& new_event = b.events[diff.b_index];
+	std::printf("~ [%u -> %u] %s ", diff.a_index, diff.b_index, event_name(old_event.type));
+	print_value(old_event, a.major_version);
+	std::fputs(" -> ", stdout);
+	print_value(new_event, b.major_version);
+	std::putchar('\n');
+
+	if(!has_records(old_event.type))
+		return;
+	bool const is_note = old_event.type == FLPEventType::FLP_PatNoteRecChan;
+	std::span<RecordField const> const fields = is_note ? std::span<RecordField const>(note_fields) : std::span<RecordField const>(clip_fields);
+	std::span<RecordField const> const main_fields = fields.first(is_note ? n_main_note_fields : n_main_clip_fields);
+	std::size_t const size = record_size(old_event.type);
+	for(FLPRecordDiff const& record : diff.records) {
+		// a partial record at the end is only counted
+		bool const a_complete = (std::size_t(record.a_index) + 1) * size <= old_event.data.size();
+		bool const b_complete = (std::size_t(record.b_index) + 1) * size <= new_event.data.size();
+		std::byte const* const a_record = old_event.data.data() + std::size_t(record.a_index) * size;
+		std::byte const* const b_record = new_event.data.data() + std::size_t(record.b_index) * size;
+		switch(record.kind) {
+		case FLPDiffKind::removed:
+			if(a_complete)
+				print_record('-', record.a_index, a_record, main_fields);
+			break;
+		case FLPDiffKind::inserted:
+			if(b_complete)
+				print_record('+', record.b_index, b_record, main_fields);
+			break;
+		case FLPDiffKind::changed:
+			if(a_complete && b_complete)
+				print_record_change(record.a_index, a_record, record.b_index, b_record, fields);
+			break;
+		}
+	}
+}
+
+int wmain(int argc, wchar_t* argv[]) {
+	if(argc != 3) {
+		std::fputs("usage: FLP-Diff <old.flp> <new.flp>\n", stderr);
+		return 2;
+	}
+
+	using namespace std::chrono;
+	using clock = high_resolution_clock;
+
+	auto const begin_time = clock::now();
+
+	std::filesystem::path const a_path = argv[1];
+	std::filesystem::path const b_path = argv[2];
+	std::optional<EventList> a;
+	std::optional<EventList> b;
+	try {
+		a.emplace(a_path);
+		b.emplace(b_path);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, OM_PATH_FORMAT ": %s\n", (a ? b_path : a_path).c_str(), e.what());
+		return 2;
+	}
+
+	std::vector<FLPEventDiff> const diffs = diff_events(a->events, b->events);
+
+	std::printf("--- " OM_PATH_FORMAT ": %zu events\n", a_path.c_str(), a->events.size());
+	std::printf("+++ " OM_PATH_FORMAT ": %zu events\n", b_path.c_str(), b->events.size());
+	std::size_t n_removed = 0;
+	std::size_t n_inserted = 0;
+	std::size_t n_changed = 0;
+	for(FLPEventDiff const& diff : diffs) {
+		switch(diff.kind) {
+		case FLPDiffKind::removed:
+			print_event('-', diff.a_index, a->events[diff.a_index], a->major_version);
+			++n_removed;
+			break;
+		case FLPDiffKind::inserted:
+			print_event('+', diff.b_index, b->events[diff.b_index], b->major_version);
+			++n_inserted;
+			break;
+		case FLPDiffKind::changed:
+			print_changed_event(diff, *a, *b);
+			++n_changed;
+			break;
+		}
+	}
+
+	auto const end_time = clock::now();
+	std::fprintf(stderr, "%zu removed, %zu inserted, %zu changed in %lldus\n",
+	             n_removed, n_inserted, n_changed,
+	             static_cast<long long>(duration_cast<microseconds>(end_time - begin_time).count()));
+
+	// like diff, 1 if the files differ
+	return diffs.empty() ? 0 : 1;
+}
+
+#ifndef _WIN32
+int main(int argc, char* argv[]) {
+	return Om::call_wmain(argc, argv, wmain);
+}
+#endif
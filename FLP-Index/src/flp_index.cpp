@@ -0,0 +1,414 @@
+#include <cstdio>     // fputs, fprintf, fwrite
+#include <filesystem> // path, recursive_directory_iterator
+#include <chrono>     // high_resolution_clock
+#include <cstdint>    // uint32_t
+#include <cerrno>     // errno, ERANGE
+#include <cwchar>     // wcstoull
+#include <cwctype>    // towlower
+#include <thread>     // hardware_concurrency
+#include <atomic>     // atomic
+#include <vector>     // vector
+#include <algorithm>  // max, sort, unique, set_intersection
+#include <string>     // string, getline
+#include <fstream>    // ifstream
+#include <optional>   // optional
+
+#include "flp_view_stream.h"
+#include "flp_index.h"
+#include "flp_batch_loader.h"
+
+#include "argparse.h"
+#include "cfile.h"
+#include "thread_pool.h"
+#include "wide_main.h"
+
+
+using namespace Om;
+
+// printf format of std::filesystem::path::c_str()
+#ifdef _WIN32
+#define OM_PATH_FORMAT "%ls"
+#else
+#define OM_PATH_FORMAT "%s"
+#endif
+
+// more than enough for any machine, every thread gets a queue
+constexpr std::size_t max_threads = 1024;
+
+struct ProgramOptions {
+	std::filesystem::path input_path {};  // directory with the flp files
+	std::filesystem::path list_path {};   // file with one input path per line
+	std::filesystem::path output_path {}; // index to build
+	std::filesystem::path index_path {};  // index to query
+	std::vector<std::wstring> queries {}; // "field=text", "field=prefix*"
+	std::wstring terms_field {};          // field whose terms are listed
+	std::size_t n_threads = 0;            // 0 if not set
+	// files are read ahead by a BatchFileLoader if set, else mapped one by one
+	std::optional<FileLoaderBackend> loader {};
+};
+
+static std::string to_utf8(std::wstring_view s) {
+	std::u8string const u8 = std::filesystem::path(s).u8string();
+	return std::string(u8.begin(), u8.end());
+}
+
+static bool has_flp_extension(std::filesystem::path const& p) {
+	std::wstring ext = p.extension().wstring();
+	for(auto& c : ext) {
+		c = static_cast<wchar_t>(std::towlower(c));
+	}
+	return ext == L".flp";
+}
+
+static std::vector<std::filesystem::path> collect_inputs(ProgramOptions const& program_args) {
+	namespace fs = std::filesystem;
+
+	std::vector<fs::path> inputs;
+	if(!program_args.input_path.empty()) {
+		for(auto const& entry : fs::recursive_directory_iterator(program_args.input_path, fs::directory_options::skip_permission_denied)) {
+			if(entry.is_regular_file() && has_flp_extension(entry.path()))
+				inputs.push_back(entry.path());
+		}
+	}
+
+	if(!program_args.list_path.empty()) {
+		std::ifstream list(program_args.list_path);
+		if(!list)
+			throw std::runtime_error("could not open list file");
+		std::string line;
+		while(std::getline(list, line)) {
+			if(!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if(!line.empty())
+				inputs.emplace_back(std::u8string(line.begin(), line.end()));
+		}
+	}
+
+	// document ids follow the path order, so rebuilding gives the same index
+	std::sort(inputs.begin(), inputs.end());
+	inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+	return inputs;
+}
+
+static void print_usage() {
+	std::fputs(
+		"build: FLP-Index -o <index> [-j <threads>] [--loader mmap|auto|io_uring|pread] [--list <file>] [<directory>]\n"
+		"query: FLP-Index -i <index> -q <field>=<text>[*] [-q ...]\n"
+		"       FLP-Index -i <index> --terms <field>\n"
+		"fields: plugin, plugin_name, sample, sample_path, author, genre, version\n",
+		stderr);
+}
+
+// Larger files are mapped even with a loader, most of their bytes are in
+// events the index skips, which a whole-file read would still read.
+constexpr std::size_t max_loaded_file_size = 1024 * 1024;
+
+static bool build_index(ProgramOptions const& program_args) {
+	using namespace std::chrono;
+	using clock = high_resolution_clock;
+
+	auto const begin_time = clock::now();
+
+	std::vector<std::filesystem::path> inputs;
+	try {
+		inputs = collect_inputs(program_args);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, "Could not collect the inputs: %s\n", e.what());
+		return false;
+	}
+
+	// only the text events are decoded, the rest of each file is skipped
+	std::vector<std::optional<std::vector<FLPIndexTerm>>> terms(inputs.size());
+	std::atomic<std::size_t> n_failed { 0 };
+	auto const index_input = [&](std::size_t i, auto const& open_stream) {
+		try {
+			auto flp = open_stream();
+			terms[i] = collect_index_terms(flp);
+		} catch(std::exception const& e) {
+			std::fprintf(stderr, OM_PATH_FORMAT ": %s\n", inputs[i].c_str(), e.what());
+			++n_failed;
+		}
+	};
+	std::string_view read_with = "mmap";
+	if(program_args.loader) {
+		// many files are read at once while the threads parse the ones that
+		// arrived, which matters for corpora of small files on slow disks
+		Om::BatchFileLoaderOptions loader_options;
+		loader_options.backend = *program_args.loader;
+		loader_options.max_file_size = max_loaded_file_size;
+		Om::BatchFileLoader loader(inputs, loader_options);
+		read_with = file_loader_backend_name(loader.backend());
+		Om::WorkStealingPool pool(program_args.n_threads);
+		for(std::size_t t = 0; t < program_args.n_threads; ++t) {
+			pool.submit([&] {
+				while(std::optional<LoadedFile> file = loader.next()) {
+					if(file->error == std::errc::file_too_large) {
+						index_input(file->index, [&] { return FLPMappedInStream(inputs[file->index]); });
+						continue;
+					}
+					if(file->error) {
+						std::fprintf(stderr, OM_PATH_FORMAT ": %s\n", inputs[file->index].c_str(), file->error.message().c_str());
+						++n_failed;
+						continue;
+					}
+					index_input(file->index, [&] { return FLPViewInStream(file->bytes()); });
+				}
+			});
+		}
+		pool.wait();
+	} else {
+		Om::WorkStealingPool pool(program_args.n_threads);
+		for(std::size_t i = 0; i < inputs.size(); ++i) {
+			pool.submit([&, i] {
+				index_input(i, [&] { return FLPMappedInStream(inputs[i]); });
+			});
+		}
+		pool.wait();
+	}
+
+	FLPIndexWriter writer;
+	for(std::size_t i = 0; i < inputs.size(); ++i) {
+		if(terms[i]) {
+			std::u8string const path = inputs[i].u8string();
+			writer.add_document(std::string_view(reinterpret_cast<char const*>(path.data()), path.size()), *terms[i]);
+		}
+	}
+	std::vector<std::byte> const index = writer.serialize();
+
+	Om::CFile out(Om::open_file(program_args.output_path, "wb"));
+	if(!out.is_open()) {
+		std::fputs("Could not open output file! - Exiting\n", stderr);
+		return false;
+	}
+	if(out.write(index.data(), index.size()) != index.size()) {
+		std::fputs("Could not write the index! - Exiting\n", stderr);
+		return false;
+	}
+
+	auto const end_time = clock::now();
+	std::printf("indexed: %zu, failed: %zu\n", inputs.size() - n_failed.load(), n_failed.load());
+	std::printf("%.1f KB index in %.3fs, read with %.*s\n",
+	            static_cast<double>(index.size()) / 1024.0,
+	            duration<double>(end_time - begin_time).count(),
+	            static_cast<int>(read_with.size()), read_with.data());
+	return true;
+}
+
+static std::optional<FLPIndexField> parse_field(std::wstring_view name) {
+	std::optional<FLPIndexField> const field = index_field_from_name(to_utf8(name));
+	if(!field)
+		std::fputs("Unknown field, valid are plugin, plugin_name, sample, sample_path, author, genre and version\n", stderr);
+	return field;
+}
+
+struct Query {
+	FLPIndexField field;
+	std::string text;
+	bool is_prefix;
+};
+
+// "field=text" or "field=prefix*", nullopt after printing why if invalid
+static std::optional<Query> parse_query(std::wstring_view query) {
+	std::size_t const equals = query.find(L'=');
+	if(equals == std::wstring_view::npos) {
+		std::fputs("A query must be field=text\n", stderr);
+		return std::nullopt;
+	}
+	std::optional<FLPIndexField> const field = parse_field(query.substr(0, equals));
+	if(!field)
+		return std::nullopt;
+	std::string text = to_utf8(query.substr(equals + 1));
+	bool const is_prefix = !text.empty() && text.back() == '*';
+	if(is_prefix)
+		text.pop_back();
+	return Query { *field, std::move(text), is_prefix };
+}
+
+// documents matching all queries, one query matches every term it names
+static std::vector<std::uint32_t> run_queries(FLPIndex const& index, std::vector<Query> const& queries) {
+	std::vector<std::uint32_t> result;
+	std::vector<std::uint32_t> matches;
+	std::vector<std::uint32_t> intersection;
+	for(std::size_t i = 0; i < queries.size(); ++i) {
+		auto const& [field, text, is_prefix] = queries[i];
+		matches.clear();
+		for(FLPIndexTermEntry const& term : index.find(field, text, is_prefix)) {
+			index.postings(term, &matches);
+		}
+		std::sort(matches.begin(), matches.end());
+		matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+		if(i == 0) {
+			result.swap(matches);
+		} else {
+			intersection.clear();
+			std::set_intersection(result.begin(), result.end(), matches.begin(), matches.end(), std::back_inserter(intersection));
+			result.swap(intersection);
+		}
+		if(result.empty())
+			break;
+	}
+	return result;
+}
+
+static bool query_index(ProgramOptions const& program_args) {
+	using namespace std::chrono;
+	using clock = high_resolution_clock;
+
+	auto const begin_time = clock::now();
+
+	// the arguments are checked before the index is opened
+	std::optional<FLPIndexField> terms_field;
+	if(!program_args.terms_field.empty()) {
+		terms_field = parse_field(program_args.terms_field);
+		if(!terms_field) {
+			print_usage();
+			return false;
+		}
+	}
+	std::vector<Query> queries;
+	for(std::wstring const& query : program_args.queries) {
+		std::optional<Query> parsed = parse_query(query);
+		if(!parsed) {
+			print_usage();
+			return false;
+		}
+		queries.push_back(std::move(*parsed));
+	}
+
+	FLPIndex index;
+	if(std::error_code err = index.open(program_args.index_path)) {
+		std::fprintf(stderr, "Could not open index file: %s\n", err.message().c_str());
+		return false;
+	}
+
+	std::size_t n_results = 0;
+	if(terms_field) {
+		// most used first
+		std::span<FLPIndexTermEntry const> const terms = index.terms(*terms_field);
+		std::vector<FLPIndexTermEntry const*> sorted;
+		for(FLPIndexTermEntry const& term : terms) {
+			sorted.push_back(&term);
+		}
+		std::stable_sort(sorted.begin(), sorted.end(), [](FLPIndexTermEntry const* a, FLPIndexTermEntry const* b) {
+			return a->n_documents > b->n_documents;
+		});
+		for(FLPIndexTermEntry const* term : sorted) {
+			std::string_view const text = index.text(*term);
+			std::printf("%u\t%.*s\n", term->n_documents, static_cast<int>(text.size()), text.data());
+		}
+		n_results = sorted.size();
+	} else {
+		std::vector<std::uint32_t> documents;
+		try {
+			documents = run_queries(index, queries);
+		} catch(std::exception const& e) {
+			std::fprintf(stderr, "Could not read index file: %s\n", e.what());
+			return false;
+		}
+		for(std::uint32_t document : documents) {
+			std::string_view const path = index.document_path(document);
+			std::fwrite(path.data(), 1, path.size(), stdout);
+			std::fputc('\n', stdout);
+		}
+		n_results = documents.size();
+	}
+
+	auto const end_time = clock::now();
+	std::fprintf(stderr, "%zu results of %u projects in %lldus\n",
+	             n_results, index.n_documents(),
+	             static_cast<long long>(duration_cast<microseconds>(end_time - begin_time).count()));
+	return true;
+}
+
+static ProgramOptions get_program_options(int argc, wchar_t* argv[]) {
+	auto write_path_arg = [](std::filesystem::path& p) -> std::function<void(wchar_t const*)> {
+		return [&p] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			p = arg;
+		};
+	};
+
+	ProgramOptions program_args {};
+	Om::ArgHandlerMap<wchar_t> const arg_handlers = {
+		{L"o",           write_path_arg(program_args.output_path)},
+		{L"i",           write_path_arg(program_args.index_path)},
+		{L"list",        write_path_arg(program_args.list_path)},
+		{L"j",           [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			wchar_t* end;
+			errno = 0;
+			unsigned long long const value = std::wcstoull(arg, &end, 10);
+			if(*end != L'\0' || errno == ERANGE || value > max_threads)
+				throw std::runtime_error("invalid number of threads");
+			program_args.n_threads = static_cast<std::size_t>(value);
+		}},
+		{L"q",           [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			program_args.queries.emplace_back(arg);
+		}},
+		{L"terms",       [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			program_args.terms_field = arg;
+		}},
+		{L"loader",      [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			if(std::wstring_view(arg) == L"mmap") {
+				program_args.loader.reset();
+				return;
+			}
+			for(FileLoaderBackend backend : { FileLoaderBackend::automatic, FileLoaderBackend::io_uring, FileLoaderBackend::pread }) {
+				std::string_view const name = file_loader_backend_name(backend);
+				if(std::wstring_view(arg) == std::wstring(name.begin(), name.end())) {
+					program_args.loader = backend;
+					return;
+				}
+			}
+			throw std::runtime_error("invalid loader, valid are mmap, auto, io_uring and pread");
+		}},
+		{L"",            write_path_arg(program_args.input_path) }
+	};
+
+	Om::parse_args<wchar_t>(argc, argv, arg_handlers);
+
+	// 0 uses all cores
+	if(program_args.n_threads == 0) {
+		program_args.n_threads = std::max(1U, std::thread::hardware_concurrency());
+	}
+
+	return program_args;
+}
+
+int wmain(int argc, wchar_t* argv[]) {
+	ProgramOptions program_args;
+	try {
+		program_args = get_program_options(argc, argv);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, "Invalid arguments: %s\n", e.what());
+		print_usage();
+		return EXIT_FAILURE;
+	}
+
+	bool const is_query = !program_args.index_path.empty()
+	                      && (!program_args.queries.empty() || !program_args.terms_field.empty());
+	bool const is_build = !program_args.output_path.empty()
+	                      && (!program_args.input_path.empty() || !program_args.list_path.empty());
+	if(is_query == is_build) {
+		print_usage();
+		return EXIT_FAILURE;
+	}
+
+	bool const success = is_query ? query_index(program_args) : build_index(program_args);
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#ifndef _WIN32
+int main(int argc, char* argv[]) {
+	return Om::call_wmain(argc, argv, wmain);
+}
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "cfile.h"
+#include "flp_trace.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+
+namespace Om {
+
+// Reads a file through one large buffer so that decoding single fields
+// is a bounds check and a memcpy instead of a locked fread call.
+// The buffer is only refilled when a read reaches its end, large reads
+// bypass the buffer. This works for pipes and other unmappable files too.
+class BufferedInFile {
+public:
+	static constexpr std::size_t default_buffer_size = std::size_t(1) << 20;
+
+	BufferedInFile(FILE* fp, std::size_t buffer_size = default_buffer_size) :
+		m_file { fp },
+		m_buffer { std::make_unique<std::byte[]>(buffer_size) },
+		m_buffer_size { buffer_size } {
+		assert(buffer_size >= 16);
+		if(m_file.is_open()) {
+			// the stdio buffer would only add another copy
+			std::setvbuf(m_file.fptr(), nullptr, _IONBF, 0);
+		}
+	}
+
+	BufferedInFile(BufferedInFile const&) = delete;
+	BufferedInFile& operator=(BufferedInFile const&) = delete;
+
+	template<typename OutT>
+	bool read(OutT* target) noexcept {
+		static_assert(std::is_trivially_copyable<OutT>::value, "OutT must be trivially copyable!");
+		if(available() < sizeof(OutT) && !refill(sizeof(OutT)))
+			return false;
+		std::memcpy(target, m_position, sizeof(OutT));
+		m_position += sizeof(OutT);
+		return true;
+	}
+
+	template<typename OutT>
+	std::size_t read(OutT target[], std::size_t num_elems) noexcept {
+		static_assert(std::is_trivially_copyable<OutT>::value, "OutT must be trivially copyable!");
+		std::size_t const size = sizeof(OutT) * num_elems;
+		auto* out = reinterpret_cast<std::byte*>(target);
+		std::size_t const buffered = available() < size ? available() : size;
+		std::memcpy(out, m_position, buffered);
+		m_position += buffered;
+		std::size_t done = buffered;
+		if(done < size) {
+			std::size_t const rest = size - done;
+			if(rest >= m_buffer_size) {
+				// too large for the buffer, read directly into the target
+				OM_TRACE_SPAN("read", "io");
+				done += std::fread(out + done, 1, rest, m_file.fptr());
+			} else if(refill(rest)) {
+				std::memcpy(out + done, m_position, rest);
+				m_position += rest;
+				done += rest;
+			}
+		}
+		return done / sizeof(OutT);
+	}
+
+	// Skips size bytes. Whatever isn't buffered yet is seeked over if the
+	// file supports it, otherwise it is read and discarded.
+	bool skip(std::size_t size) noexcept {
+		std::size_t const buffered = available() < size ? available() : size;
+		m_position += buffered;
+		std::size_t rest = size - buffered;
+		if(rest == 0)
+			return true;
+		if(rest < m_buffer_size) {
+			// close enough that reading ahead is as good as seeking
+			if(!refill(rest))
+				return false;
+			m_position += rest;
+			return true;
+		}
+		std::int64_t const pos = m_file.tell();
+		if(pos >= 0 && m_file.seek(pos + static_cast<std::int64_t>(rest)))
+			return true;
+		while(rest > 0) {
+			std::size_t const n = std::fread(m_buffer.get(), 1, rest < m_buffer_size ? rest : m_buffer_size, m_file.fptr());
+			if(n == 0)
+				return false;
+			rest -= n;
+		}
+		return true;
+	}
+
+	// decodes a 7-bit variable length integer as used for event sizes,
+	// returns the number of bytes consumed or 0 on failure
+	std::size_t read_varint(std::uint32_t* target) noexcept {
+		constexpr std::size_t max_varint_size = 5;
+		if(available() < max_varint_size)
+			refill(max_varint_size);
+		std::uint32_t value = 0;
+		std::uint32_t shift_by = 0;
+		for(std::byte* p = m_position; p < m_end && shift_by < 32; ++p) {
+			auto const current_byte = static_cast<std::uint8_t>(*p);
+			value |= std::uint32_t(current_byte & 0x7FU) << shift_by;
+			shift_by += 7;
+			if(!(current_byte & 0x80U)) {
+				std::size_t const n_bytes = static_cast<std::size_t>(p + 1 - m_position);
+				m_position = p + 1;
+				*target = value;
+				return n_bytes;
+			}
+		}
+		return 0;
+	}
+
+	bool error() const noexcept {
+		return m_file.error();
+	}
+
+	static char const* errmsg(bool is_error) noexcept {
+		return is_error ? "Error reading input file!" : "Unexpected end of file!";
+	}
+
+private:
+	std::size_t available() const noexcept {
+		return static_cast<std::size_t>(m_end - m_position);
+	}
+
+	// moves the unread rest to the front and fills the remaining buffer,
+	// returns whether at least min_size bytes are available afterwards
+	bool refill(std::size_t min_size) noexcept {
+		OM_TRACE_SPAN("read", "io");
+		assert(min_size <= m_buffer_size);
+		std::size_t const rest = available();
+		std::memmove(m_buffer.get(), m_position, rest);
+		m_position = m_buffer.get();
+		m_end = m_position + rest;
+		while(available() < min_size) {
+			std::size_t const n = std::fread(m_end, 1, m_buffer_size - available(), m_file.fptr());
+			if(n == 0)
+				return false;
+			m_end += n;
+		}
+		return true;
+	}
+
+	CFile m_file;
+	std::unique_ptr<std::byte[]> m_buffer;
+	std::size_t m_buffer_size;
+	std::byte* m_position = m_buffer.get();
+	std::byte* m_end = m_buffer.get();
+};
+
+} // namespace Om
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+#include "flp_hash.h"
+#include "flp_mapped_file.h"
+
+
+namespace Om {
+
+// What the cache knows about one converted input.
+struct ConversionCacheEntry {
+	std::uint64_t content_hash = 0;
+	std::uint64_t size = 0;
+	std::int64_t mtime = 0;  // ticks of std::filesystem::file_time_type
+	std::uint64_t output_size = 0;
+	std::uint64_t sidecar_size = 0;  // all 0 without a sidecar
+	std::int64_t sidecar_mtime = 0;
+	std::uint64_t sidecar_hash = 0;
+	std::string output_path; // UTF-8
+};
+
+// Manifest of earlier batch conversions, keyed by input path. An input is
+// up to date if its output is still there and either its size and mtime or
+// its content are unchanged, so only touched files are hashed again. The
+// same goes for a sidecar, which must still have the content it was
+// written with.
+//
+// The manifest is a text file, one tab separated entry per line:
+//   hash size mtime output_size sidecar_size sidecar_mtime sidecar_hash input_path output_path
+// Tabs, line breaks and backslashes in the paths are escaped as \t, \n, \r
+// and \\. It is only valid for the options it was written with, any other
+// options start from an empty cache.
+class ConversionCache {
+public:
+	static constexpr std::string_view format_line = "flp-json-conv cache 3";
+
+	explicit ConversionCache(std::string options_key) :
+		_options_key { std::move(options_key) } {
+	}
+
+	// a missing or unreadable manifest is an empty cache
+	void load(std::filesystem::path const& path) {
+		std::ifstream in(path, std::ios::binary);
+		std::string line;
+		if(!std::getline(in, line) || line != format_line)
+			return;
+		if(!std::getline(in, line) || line != "options " + _options_key)
+			return;
+		while(std::getline(in, line)) {
+			std::string_view fields[9];
+			std::size_t n_fields = 0;
+			for(std::string_view rest = line; n_fields < 9;) {
+				std::size_t const tab = rest.find('\t');
+				fields[n_fields++] = rest.substr(0, tab);
+				if(tab == std::string_view::npos)
+					break;
+				rest.remove_prefix(tab + 1);
+			}
+			ConversionCacheEntry entry;
+			std::string input;
+			if(n_fields != 9
+			   || !parse(fields[0], 16, &entry.content_hash)
+			   || !parse(fields[1], 10, &entry.size)
+			   || !parse(fields[2], 10, &entry.mtime)
+			   || !parse(fields[3], 10, &entry.output_size)
+			   || !parse(fields[4], 10, &entry.sidecar_size)
+			   || !parse(fields[5], 10, &entry.sidecar_mtime)
+			   || !parse(fields[6], 16, &entry.sidecar_hash)
+			   || !unescape(fields[7], &input)
+			   || !unescape(fields[8], &entry.output_path))
+				continue;
+			_entries.insert_or_assign(std::move(input), std::move(entry));
+		}
+	}
+
+	// writes to a temporary file first so an interrupted run keeps the old manifest
+	bool save(std::filesystem::path const& path) const {
+		std::filesystem::path tmp_path = path;
+		tmp_path += L".tmp";
+		{
+			std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+			out << format_line << '\n' << "options " << _options_key << '\n';
+			char hash[17];
+			char sidecar_hash[17];
+			for(auto const& [input, entry] : _entries) {
+				std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(entry.content_hash));
+				std::snprintf(sidecar_hash, sizeof(sidecar_hash), "%016llx", static_cast<unsigned long long>(entry.sidecar_hash));
+				out << hash << '\t' << entry.size << '\t' << entry.mtime << '\t' << entry.output_size
+				    << '\t' << entry.sidecar_size << '\t' << entry.sidecar_mtime << '\t' << sidecar_hash
+				    << '\t' << escape(input) << '\t' << escape(entry.output_path) << '\n';
+			}
+			if(!out.flush())
+				return false;
+		}
+		std::error_code err;
+		std::filesystem::rename(tmp_path, path, err);
+		return !err;
+	}
+
+	// Returns the entry to record for input if its output (and sidecar, if
+	// not empty) is up to date, the mtimes in it may be newer than the
+	// cached ones. Safe to call from several threads as long as nothing is
+	// changed.
+	std::optional<ConversionCacheEntry> up_to_date(std::filesystem::path const& input,
+	                                               std::filesystem::path const& output,
+	                                               std::filesystem::path const& sidecar) const {
+		auto const it = _entries.find(utf8(input));
+		if(it == _entries.end())
+			return std::nullopt;
+		ConversionCacheEntry entry = it->second;
+
+		std::error_code err;
+		if(entry.output_path != utf8(output)
+		   || std::filesystem::file_size(output, err) != entry.output_size || err)
+			return std::nullopt;
+		if(!sidecar.empty()
+		   && !is_unchanged(sidecar, entry.sidecar_size, entry.sidecar_hash, &entry.sidecar_mtime))
+			return std::nullopt;
+		if(!is_unchanged(input, entry.size, entry.content_hash, &entry.mtime))
+			return std::nullopt;
+		return entry;
+	}
+
+	// Size, mtime and hash of an input, taken before it is converted so that
+	// changes made during the conversion are seen by the next run.
+	static std::optional<ConversionCacheEntry> describe_input(std::filesystem::path const& input) {
+		ConversionCacheEntry entry;
+		std::error_code err;
+		entry.size = std::filesystem::file_size(input, err);
+		if(!err)
+			entry.mtime = modification_time(input, err);
+		if(err)
+			return std::nullopt;
+		std::optional<std::uint64_t> const hash = content_hash(input);
+		if(!hash)
+			return std::nullopt;
+		entry.content_hash = *hash;
+		return entry;
+	}
+
+	// completes an entry of describe_input() once the input was converted,
+	// sidecar is empty if there is none
+	static bool set_output(ConversionCacheEntry* entry, std::filesystem::path const& output,
+	                       std::filesystem::path const& sidecar) {
+		std::error_code err;
+		entry->output_size = std::filesystem::file_size(output, err);
+		entry->output_path = utf8(output);
+		if(err)
+			return false;
+		if(!sidecar.empty()) {
+			entry->sidecar_size = std::filesystem::file_size(sidecar, err);
+			if(!err)
+				entry->sidecar_mtime = modification_time(sidecar, err);
+			std::optional<std::uint64_t> const sidecar_hash = content_hash(sidecar);
+			if(err || !sidecar_hash)
+				return false;
+			entry->sidecar_hash = *sidecar_hash;
+		}
+		return true;
+	}
+
+	void insert(std::filesystem::path const& input, ConversionCacheEntry entry) {
+		_entries.insert_or_assign(utf8(input), std::move(entry));
+	}
+
+	void erase(std::filesystem::path const& input) {
+		_entries.erase(utf8(input));
+	}
+
+private:
+	static std::string utf8(std::filesystem::path const& p) {
+		std::u8string const s = p.u8string();
+		return std::string(s.begin(), s.end());
+	}
+
+	static std::int64_t modification_time(std::filesystem::path const& p, std::error_code& err) {
+		return static_cast<std::int64_t>(std::filesystem::last_write_time(p, err).time_since_epoch().count());
+	}
+
+	// A file is unchanged if it has the size and mtime it was recorded with,
+	// it is only hashed if it was touched. Updates *mtime if it was touched
+	// without being changed.
+	static bool is_unchanged(std::filesystem::path const& p, std::uint64_t size, std::uint64_t hash, std::int64_t* mtime) {
+		std::error_code err;
+		if(std::filesystem::file_size(p, err) != size || err)
+			return false;
+		std::int64_t const current_mtime = modification_time(p, err);
+		if(err)
+			return false;
+		if(current_mtime == *mtime)
+			return true;
+
+		// touched, but maybe not changed
+		std::optional<std::uint64_t> const current_hash = content_hash(p);
+		if(!current_hash || *current_hash != hash)
+			return false;
+		*mtime = current_mtime;
+		return true;
+	}
+
+	static std::optional<std::uint64_t> content_hash(std::filesystem::path const& p) {
+		Om::MappedFile file;
+		if(file.open(p))
+			return std::nullopt;
+		return Om::hash64(file.data());
+	}
+
+	// keeps a path on its line and in its field
+	static std::string escape(std::string_view s) {
+		std::string escaped;
+		escaped.reserve(s.size());
+		for(char const c : s) {
+			switch(c) {
+			case '\t': escaped += "\\t"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\r': escaped += "\\r"; break;
+			case '\\': escaped += "\\\\"; break;
+			default:   escaped += c; break;
+			}
+		}
+		return escaped;
+	}
+
+	static bool unescape(std::string_view s, std::string* unescaped) {
+		unescaped->clear();
+		unescaped->reserve(s.size());
+		for(std::size_t i = 0; i < s.size(); ++i) {
+			if(s[i] != '\\') {
+				*unescaped += s[i];
+				continue;
+			}
+			if(++i == s.size())
+				return false;
+			switch(s[i]) {
+			case 't':  *unescaped += '\t'; break;
+			case 'n':  *unescaped += '\n'; break;
+			case 'r':  *unescaped += '\r'; break;
+			case '\\': *unescaped += '\\'; break;
+			default:   return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename T>
+	static bool parse(std::string_view s, int base, T* value) {
+		auto const result = std::from_chars(s.data(), s.data() + s.size(), *value, base);
+		return result.ec == std::errc() && result.ptr == s.data() + s.size();
+	}
+
+	std::string _options_key;
+	std::unordered_map<std::string, ConversionCacheEntry> _entries;
+};
+
+} // namespace Om
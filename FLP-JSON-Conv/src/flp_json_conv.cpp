@@ -1,17 +1,60 @@
 ﻿#include <cstdio>     // fputs, fprintf
 #include <filesystem> // path
 #include <chrono>     // high_resolution_clock
+#include <cstdint>    // SIZE_MAX
+#include <cwchar>     // wcstoull
+#include <cerrno>     // errno, ERANGE
+#include <thread>     // thread, hardware_concurrency
+#include <atomic>     // atomic
+#include <vector>     // vector
+#include <algorithm>  // max, sort
+#include <cwctype>    // towlower
+#include <string>     // string, getline
+#include <fstream>    // ifstream
+#include <charconv>   // from_chars
+#include <optional>   // optional
+#include <cstring>    // memcpy
+#include <mutex>      // mutex, lock_guard, unique_lock
+#include <condition_variable> // condition_variable
+#include <deque>      // deque
+#include <memory>     // unique_ptr
 
 #include "flp_stream.h"
+#include "flp_view_stream.h"
+#include "flp_out_stream.h"
+#include "flp_zip.h"
 
 #include "argparse.h"
 #include "version.h"
 #include "json.h"
+#include "json_reader.h"
+#include "json_to_flp.h"
 #include "cfile.h"
+#include "buffered_in_file.h"
+#include "sinks.h"
+#include "thread_pool.h"
+#include "spsc_queue.h"
+#include "conversion_cache.h"
+#include "process_stats.h"
+#include "wide_main.h"
+
+#ifdef _WIN32
+#include <fcntl.h>    // _O_BINARY
+#include <io.h>       // _setmode, _dup
+#else
+#include <unistd.h>   // dup
+#endif
 
 
 using namespace Om;
 
+// printf format of std::filesystem::path::c_str()
+#ifdef _WIN32
+#define OM_PATH_FORMAT "%ls"
+#else
+#define OM_PATH_FORMAT "%s"
+#endif
+
 enum class Mode {
 	not_set,
 	flp_to_json,
@@ -21,43 +64,131 @@ enum class Mode {
 struct ProgramOptions {
 	std::filesystem::path input_path {};
 	std::filesystem::path output_path {};
+	std::filesystem::path list_path {}; // file with one input path per line
+	std::filesystem::path cache_path {}; // manifest of earlier batch runs
+	std::filesystem::path stats_path {}; // json statistics of the run
+	std::filesystem::path trace_path {}; // chrome trace of the run, needs OM_TRACE
 	Mode mode = Mode::not_set;
+	std::size_t read_buffer_size = Om::BufferedInFile::default_buffer_size;
+	std::size_t write_buffer_size = Om::JSONOutStream<Om::FdSink>::default_buffer_size;
+	std::size_t n_threads = 0; // 0 if not set
+	FLPDataEncoding data_encoding = FLPDataEncoding::hex;
+	FLPRecordLayout record_layout = FLPRecordLayout::rows;
+	FLPEventMask event_mask = FLPEventMask::all(); // events written to the json
+	bool compact = false; // no whitespace in the json output
+	bool pipeline = false; // decode, serialize and write on separate threads
+	bool is_batch = false;
 };
 
-struct CFileInStream : public Om::CFile {
-	CFileInStream(FILE* fptr) : Om::CFile(fptr) {}
+// "-" is stdin or stdout, so that conversions can be part of a pipeline
+static bool is_standard_stream(std::filesystem::path const& p) {
+	return p == L"-";
+}
+
+// stdin is switched to binary mode, so that Windows doesn't translate line ends
+static FILE* open_input_file(std::filesystem::path const& path) {
+	if(!is_standard_stream(path))
+		return Om::open_file(path, "rb");
+#ifdef _WIN32
+	::_setmode(::_fileno(stdin), _O_BINARY);
+#endif
+	return stdin;
+}
+
+// stdout is duplicated, so that closing the output doesn't close it
+static int dup_stdout() noexcept {
+	std::fflush(stdout);
+#ifdef _WIN32
+	::_setmode(::_fileno(stdout), _O_BINARY);
+	return ::_dup(::_fileno(stdout));
+#else
+	return ::dup(STDOUT_FILENO);
+#endif
+}
+
+static Om::FdSink open_output(std::filesystem::path const& path) {
+	if(!is_standard_stream(path))
+		return Om::FdSink::open(path);
+	return Om::FdSink(dup_stdout());
+}
+
+static FILE* open_output_file(std::filesystem::path const& path) {
+	if(!is_standard_stream(path))
+		return Om::open_file(path, "wb");
+	int const fd = dup_stdout();
+	if(fd < 0)
+		return nullptr;
+#ifdef _WIN32
+	FILE* const f = ::_fdopen(fd, "wb");
+	if(f == nullptr)
+		::_close(fd);
+#else
+	FILE* const f = ::fdopen(fd, "wb");
+	if(f == nullptr)
+		::close(fd);
+#endif
+	return f;
+}
+
+// "x.flp.json" has its payloads in "x.flp.bin"
+static std::filesystem::path sidecar_path(std::filesystem::path const& output_path) {
+	std::filesystem::path p = output_path;
+	if(p.extension() == L".json")
+		p.replace_extension(L".bin");
+	else
+		p += L".bin";
+	return p;
+}
 
-	static char const* errmsg(int er) {
-		return { std::strerror(er) };
+static Om::FdSink open_sidecar(ProgramOptions const& program_args) {
+	Om::FdSink sidecar_file;
+	if(program_args.data_encoding == FLPDataEncoding::sidecar) {
+		sidecar_file = Om::FdSink::open(sidecar_path(program_args.output_path));
+		if(!sidecar_file.is_open())
+			std::fputs("Could not open sidecar file! - Exiting\n", stderr);
 	}
-};
+	return sidecar_file;
+}
 
-static bool flp_to_json(ProgramOptions const& program_args) {
-	FILE* f = _wfopen(program_args.input_path.c_str(), L"rb");
-	if(f == nullptr) {
-		std::fputs("Could not open input file! - Exiting\n", stderr);
-		return false;
+template<typename JSONStreamT>
+static void write_document_head(JSONStreamT& json_stream, FLPFileHeader const& file_header, ProgramOptions const& program_args) {
+	json_stream.begin_object();
+	json_stream.key("header");
+	stream_flp_header(json_stream, file_header);
+	if(program_args.data_encoding == FLPDataEncoding::sidecar) {
+		// relative to the json file
+		std::u8string const name = sidecar_path(program_args.output_path).filename().u8string();
+		json_stream.key("sidecar");
+		json_stream.value(std::string_view(reinterpret_cast<char const*>(name.data()), name.size()));
 	}
-	FLPInStream<CFileInStream> flp(f);
+	json_stream.key("events");
+	json_stream.begin_array();
+}
 
-	Om::CFile outfile(_wfopen(program_args.output_path.c_str(), L"wb"));
+// stats is nullptr unless --stats is given
+template<typename FormatT, typename FLPStreamT>
+static bool flp_to_json(FLPStreamT& flp, ProgramOptions const& program_args, FLPStats* stats) {
+	Om::FdSink outfile = open_output(program_args.output_path);
 	if(!outfile.is_open()) {
 		std::fputs("Could not open output file! - Exiting\n", stderr);
 		return false;
 	}
-	Om::JSONOutStream<Om::CFile> json_stream(outfile);
+	Om::FdSink sidecar_file = open_sidecar(program_args);
+	if(program_args.data_encoding == FLPDataEncoding::sidecar && !sidecar_file.is_open())
+		return false;
+	Om::SidecarSink<Om::FdSink> sidecar(sidecar_file);
+	FLPStreamOptions const stream_options { program_args.data_encoding, &sidecar, program_args.record_layout, stats };
+	flp.set_stats(stats);
 
-	json_stream.begin_object();
-	json_stream.key("header");
-	stream_flp_header(json_stream, flp.file_header());
-	json_stream.key("events");
-	json_stream.begin_array();
+	Om::JSONOutStream<Om::FdSink, FormatT> json_stream(outfile, program_args.write_buffer_size);
+
+	write_document_head(json_stream, flp.file_header(), program_args);
 	bool is_unicode = false;
 	while(flp.has_event()) {
-		FLPEvent const& event = *flp;
-		stream_flp_event<false>(json_stream, event);
+		FLPEventView const& event = flp->view();
+		stream_flp_event<false>(json_stream, event, stream_options);
 		if(event.type == FLPEventType::FLP_Version) {
-			Version version(reinterpret_cast<char const*>(event.text_data.get()));
+			Version version(reinterpret_cast<char const*>(event.data.data()));
 			if(version >= "12.0.0") {
 				is_unicode = true;
 			}
@@ -68,18 +199,822 @@ static bool flp_to_json(ProgramOptions const& program_args) {
 	}
 	if(is_unicode) {
 		for(; flp.has_event(); ++flp)
-			stream_flp_event<true>(json_stream, *flp);
+			stream_flp_event<true>(json_stream, *flp, stream_options);
 	} else {
 		for(; flp.has_event(); ++flp)
-			stream_flp_event<false>(json_stream, *flp);
+			stream_flp_event<false>(json_stream, *flp, stream_options);
 	}
 
 	json_stream.end_array();
 	json_stream.end_object();
+	json_stream.flush();
+
+	return true;
+}
+
+// part of the event list that is converted on its own
+struct EventSegment {
+	std::size_t begin; // offsets in the data chunk
+	std::size_t end;
+	std::uint64_t sidecar_begin; // offset of the first payload in the sidecar file
+};
+
+// Output of a segment on its way from a worker to the writer, in the
+// pieces that the JSONOutStream and the sidecar write. The worker waits
+// while more than max_buffered bytes wait for the writer, which only
+// takes them once it got to the segment. So a segment with a huge event
+// doesn't end up in memory as a whole.
+class SegmentOutput {
+public:
+	static constexpr std::size_t max_buffered = 1024 * 1024;
+
+	// for the worker, throws once the writer gave up
+	void write(bool is_sidecar, char const* data, std::size_t size) {
+		std::unique_lock lock(m_mutex);
+		m_changed.wait(lock, [this] { return m_aborted || m_n_buffered < max_buffered; });
+		if(m_aborted)
+			throw std::runtime_error("Conversion was aborted!");
+		m_pieces.push_back({ is_sidecar, std::string(data, size) });
+		m_n_buffered += size;
+		lock.unlock();
+		m_changed.notify_all();
+	}
+
+	// for the worker once it is done, error is rethrown by drain()
+	void finish(std::exception_ptr error) {
+		{
+			std::lock_guard lock(m_mutex);
+			m_finished = true;
+			m_error = error;
+		}
+		m_changed.notify_all();
+	}
+
+	// for the writer when it fails, wakes a worker waiting in write()
+	void abort() {
+		{
+			std::lock_guard lock(m_mutex);
+			m_aborted = true;
+		}
+		m_changed.notify_all();
+	}
+
+	// for the writer, passes the pieces to write_piece until the worker
+	// is done
+	template<typename F>
+	void drain(F&& write_piece) {
+		std::deque<Piece> pieces;
+		for(;;) {
+			bool finished;
+			{
+				std::unique_lock lock(m_mutex);
+				m_changed.wait(lock, [this] { return m_finished || !m_pieces.empty(); });
+				pieces.swap(m_pieces);
+				m_n_buffered = 0;
+				finished = m_finished;
+			}
+			m_changed.notify_all();
+			for(Piece const& piece : pieces) {
+				write_piece(piece.is_sidecar, std::string_view(piece.data));
+			}
+			pieces.clear();
+			if(finished) {
+				if(m_error)
+					std::rethrow_exception(m_error);
+				return;
+			}
+		}
+	}
+
+private:
+	struct Piece {
+		bool is_sidecar;
+		std::string data;
+	};
+
+	std::mutex m_mutex;
+	std::condition_variable m_changed;
+	std::deque<Piece> m_pieces;
+	std::size_t m_n_buffered = 0;
+	bool m_finished = false;
+	bool m_aborted = false;
+	std::exception_ptr m_error;
+};
+
+// JSON or sidecar sink of a worker
+class SegmentSink {
+public:
+	SegmentSink(SegmentOutput& output, bool is_sidecar) noexcept :
+		m_output { output },
+		m_is_sidecar { is_sidecar } {
+	}
+
+	void write(char const* data, std::size_t size) {
+		m_output.write(m_is_sidecar, data, size);
+	}
+
+private:
+	SegmentOutput& m_output;
+	bool m_is_sidecar;
+};
+
+// Converts segments of the event list on several threads. Every segment is
+// written to its own buffer by a JSONOutStream that continues the events
+// array, so the buffers concatenated in order are the sequential output.
+// The same goes for the sidecar payloads. Workers stay at most two
+// segments per thread ahead of the writer and the output of a segment is
+// buffered up to SegmentOutput::max_buffered, so memory use doesn't grow
+// with the document. Every segment has its own stats, finding the
+// boundaries isn't counted.
+template<typename FormatT>
+static bool flp_to_json_parallel(FLPViewInStream& flp, ProgramOptions const& program_args, FLPStats* stats) {
+	Om::FdSink outfile = open_output(program_args.output_path);
+	if(!outfile.is_open()) {
+		std::fputs("Could not open output file! - Exiting\n", stderr);
+		return false;
+	}
+	Om::FdSink sidecar_file = open_sidecar(program_args);
+	bool const use_sidecar = program_args.data_encoding == FLPDataEncoding::sidecar;
+	if(use_sidecar && !sidecar_file.is_open())
+		return false;
+
+	std::size_t const n_threads = program_args.n_threads;
+	constexpr std::size_t min_segment_size = 256 * 1024;
+	std::size_t const segment_size =
+		std::max<std::size_t>(flp.data_header().Length / (n_threads * 4), min_segment_size);
+	std::size_t const max_segments_ahead = n_threads * 2;
+
+	// find the segment boundaries, this only decodes event ids and sizes
+	std::vector<EventSegment> segments;
+	std::size_t unicode_from = SIZE_MAX; // events ending after this offset have UTF-16 strings
+	bool found_version = false;
+	std::size_t segment_begin = 0;
+	std::uint64_t sidecar_size = 0;
+	std::uint64_t segment_sidecar_begin = 0;
+	for(; flp.has_event(); ++flp) {
+		std::size_t const event_end = flp.data_position();
+		if(use_sidecar && has_opaque_payload(flp->type))
+			sidecar_size += flp->data.size();
+		if(!found_version && flp->type == FLPEventType::FLP_Version) {
+			found_version = true;
+			Version version(reinterpret_cast<char const*>(flp->data.data()));
+			if(version >= "12.0.0") {
+				unicode_from = event_end;
+			}
+		}
+		if(event_end - segment_begin >= segment_size) {
+			segments.push_back({ segment_begin, event_end, segment_sidecar_begin });
+			segment_begin = event_end;
+			segment_sidecar_begin = sidecar_size;
+		}
+	}
+	if(segment_begin < flp.data_position()) {
+		segments.push_back({ segment_begin, flp.data_position(), segment_sidecar_begin });
+	}
+
+	{
+		Om::JSONOutStream<Om::FdSink, FormatT> json_stream(outfile, Om::JSONOutStream<Om::FdSink>::min_buffer_size);
+		write_document_head(json_stream, flp.file_header(), program_args);
+		json_stream.suspend_aggregate();
+		json_stream.suspend_aggregate();
+		json_stream.flush();
+	}
+
+	std::vector<SegmentOutput> outputs(segments.size());
+	std::vector<FLPStats> segment_stats(stats ? segments.size() : 0);
+	std::atomic<std::size_t> next_segment { 0 };
+	std::mutex written_mutex;
+	std::condition_variable segment_written;
+	std::size_t n_written = 0; // segments the writer is done with, all of them once it failed
+	auto convert_segments = [&] {
+		for(;;) {
+			std::size_t const i = next_segment.fetch_add(1);
+			if(i >= segments.size())
+				return;
+			{
+				std::unique_lock lock(written_mutex);
+				segment_written.wait(lock, [&] { return i < n_written + max_segments_ahead; });
+				if(n_written == segments.size())
+					return;
+			}
+			try {
+				OM_TRACE_SPAN("convert_segment", "convert");
+				{
+					FLPStats* const stats_i = stats ? &segment_stats[i] : nullptr;
+					SegmentSink json_sink(outputs[i], false);
+					SegmentSink sidecar_sink(outputs[i], true);
+					Om::SidecarSink<SegmentSink> sidecar(sidecar_sink, segments[i].sidecar_begin);
+					FLPStreamOptions const stream_options { program_args.data_encoding, &sidecar, program_args.record_layout, stats_i };
+					Om::JSONOutStream<SegmentSink, FormatT> json_stream(json_sink, program_args.write_buffer_size);
+					json_stream.resume_object(true);
+					json_stream.resume_array(i != 0);
+					FLPViewInStream segment = flp.segment(segments[i].begin, segments[i].end);
+					segment.set_stats(stats_i);
+					for(; segment.has_event(); ++segment) {
+						if(segment.data_position() > unicode_from)
+							stream_flp_event<true>(json_stream, *segment, stream_options);
+						else
+							stream_flp_event<false>(json_stream, *segment, stream_options);
+					}
+					json_stream.suspend_aggregate();
+					json_stream.suspend_aggregate();
+					json_stream.flush();
+				}
+				outputs[i].finish(nullptr);
+			} catch(...) {
+				outputs[i].finish(std::current_exception());
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for(std::size_t i = 0; i < std::min(n_threads, segments.size()); ++i) {
+		workers.emplace_back(convert_segments);
+	}
+
+	// write the segments in order while later ones are still converted
+	std::exception_ptr error;
+	for(SegmentOutput& output : outputs) {
+		try {
+			output.drain([&](bool is_sidecar, std::string_view piece) {
+				if(is_sidecar)
+					sidecar_file.write(piece.data(), piece.size());
+				else
+					outfile.write(piece.data(), piece.size());
+			});
+		} catch(...) {
+			error = std::current_exception();
+			next_segment = segments.size();
+			for(SegmentOutput& o : outputs) {
+				o.abort();
+			}
+		}
+		{
+			std::lock_guard lock(written_mutex);
+			n_written = error ? segments.size() : n_written + 1;
+		}
+		segment_written.notify_all();
+		if(error)
+			break;
+	}
+	for(auto& worker : workers) {
+		worker.join();
+	}
+	if(error) {
+		std::rethrow_exception(error);
+	}
+	for(FLPStats const& s : segment_stats) {
+		stats->merge(s);
+	}
+
+	{
+		Om::JSONOutStream<Om::FdSink, FormatT> json_stream(outfile, Om::JSONOutStream<Om::FdSink>::min_buffer_size);
+		json_stream.resume_object(true);
+		json_stream.resume_array(!segments.empty());
+		json_stream.end_array();
+		json_stream.end_object();
+		json_stream.flush();
+	}
+
+	return true;
+}
+
+// events decoded ahead by the reader thread of a pipelined conversion
+struct EventBatch {
+	std::vector<FLPEventView> events;
+	Om::FLPPayloadArena arena; // payloads of FLPInStream events, reset when the batch is reused
+};
+
+// Decodes on a reader thread, serializes on this one and writes on a writer
+// thread, so that waiting for the input or the output overlaps with
+// formatting. Batches of events are passed through bounded queues and
+// reused, the memory stays bounded by n_batches batches.
+template<typename FormatT, typename FLPStreamT>
+static bool flp_to_json_pipelined(FLPStreamT& flp, ProgramOptions const& program_args, FLPStats* stats) {
+	Om::FdSink outfile = open_output(program_args.output_path);
+	if(!outfile.is_open()) {
+		std::fputs("Could not open output file! - Exiting\n", stderr);
+		return false;
+	}
+	Om::FdSink sidecar_file = open_sidecar(program_args);
+	if(program_args.data_encoding == FLPDataEncoding::sidecar && !sidecar_file.is_open())
+		return false;
+	Om::SidecarSink<Om::FdSink> sidecar(sidecar_file);
+	FLPStreamOptions const stream_options { program_args.data_encoding, &sidecar, program_args.record_layout, stats };
+
+	constexpr std::size_t n_batches = 4;
+	constexpr std::size_t max_batch_events = 1024;
+	constexpr std::size_t max_batch_bytes = 256 * 1024;
+	std::vector<EventBatch> batches(n_batches);
+	Om::SPSCQueue<EventBatch*> free_batches(n_batches);
+	Om::SPSCQueue<EventBatch*> full_batches(n_batches);
+	for(EventBatch& batch : batches) {
+		free_batches.push(&batch);
+	}
+
+	// the reader decodes the payloads of a batch into its arena, views of a
+	// memory mapping stay valid anyway
+	auto take_batch = [&]() -> EventBatch* {
+		std::optional<EventBatch*> const batch = free_batches.pop();
+		if(!batch)
+			return nullptr;
+		(*batch)->events.clear();
+		(*batch)->arena.reset();
+		if constexpr(requires { flp.use_payload_arena(&(*batch)->arena, FLPArenaReset::per_batch); })
+			flp.use_payload_arena(&(*batch)->arena, FLPArenaReset::per_batch);
+		return *batch;
+	};
+
+	FLPStats reader_stats;
+	std::exception_ptr reader_error;
+	std::thread reader([&] {
+		OM_TRACE_SPAN("read_events", "convert");
+		try {
+			flp.set_stats(stats ? &reader_stats : nullptr);
+			EventBatch* batch = take_batch();
+			std::size_t batch_bytes = 0;
+			// The current event was decoded into the arena of batch, except
+			// for the first one. Its payload was read before the pipeline
+			// started and may be owned by the event, which frees it on ++flp.
+			bool is_first = true;
+			for(; batch && flp.has_event(); ++flp) {
+				FLPEventView e = flp->view();
+				if(is_first && !e.data.empty()) {
+					std::byte* const payload = batch->arena.allocate(e.data.size());
+					std::memcpy(payload, e.data.data(), e.data.size());
+					e.data = { payload, e.data.size() };
+				}
+				is_first = false;
+				batch->events.push_back(e);
+				batch_bytes += e.data.size();
+				if(batch->events.size() >= max_batch_events || batch_bytes >= max_batch_bytes) {
+					// the next events go to the next batch, this one is left alone
+					EventBatch* next_batch = take_batch();
+					if(!full_batches.push(batch))
+						next_batch = nullptr;
+					batch = next_batch;
+					batch_bytes = 0;
+				}
+			}
+			if(batch && !batch->events.empty())
+				full_batches.push(batch);
+		} catch(...) {
+			reader_error = std::current_exception();
+		}
+		full_batches.close();
+	});
+
+	try {
+		Om::WriterThreadSink<Om::FdSink> writer(outfile);
+		{
+			Om::JSONOutStream<Om::WriterThreadSink<Om::FdSink>, FormatT> json_stream(writer, program_args.write_buffer_size);
+			write_document_head(json_stream, flp.file_header(), program_args);
+			bool found_version = false;
+			bool is_unicode = false;
+			while(std::optional<EventBatch*> const batch = full_batches.pop()) {
+				for(FLPEventView const& e : (*batch)->events) {
+					if(is_unicode)
+						stream_flp_event<true>(json_stream, e, stream_options);
+					else
+						stream_flp_event<false>(json_stream, e, stream_options);
+					if(!found_version && e.type == FLPEventType::FLP_Version) {
+						found_version = true;
+						Version version(reinterpret_cast<char const*>(e.data.data()));
+						is_unicode = version >= "12.0.0";
+					}
+				}
+				free_batches.push(*batch);
+			}
+			reader.join();
+			if(reader_error)
+				std::rethrow_exception(reader_error);
+			json_stream.end_array();
+			json_stream.end_object();
+			json_stream.flush();
+		}
+		writer.finish();
+	} catch(...) {
+		// unblocks the reader if it waits for a batch
+		free_batches.close();
+		full_batches.close();
+		if(reader.joinable())
+			reader.join();
+		throw;
+	}
+
+	if(stats)
+		stats->merge(reader_stats);
+	return true;
+}
+
+static bool has_extension(std::filesystem::path const& p, std::wstring_view extension) {
+	std::wstring ext = p.extension().wstring();
+	for(auto& c : ext) {
+		c = static_cast<wchar_t>(std::towlower(c));
+	}
+	return ext == extension;
+}
+
+template<typename FormatT>
+static bool flp_to_json_formatted(ProgramOptions const& program_args, FLPStats* stats) {
+	// zipped loop packages are decompressed while they are read instead of
+	// being extracted first
+	if(has_extension(program_args.input_path, L".zip")) {
+		FLPInStream<Om::ZipInFile> flp(program_args.input_path, program_args.read_buffer_size);
+		Om::FLPPayloadArena arena;
+		flp.use_payload_arena(&arena);
+		flp.set_event_mask(program_args.event_mask);
+		if(program_args.pipeline)
+			return flp_to_json_pipelined<FormatT>(flp, program_args, stats);
+		return flp_to_json<FormatT>(flp, program_args, stats);
+	}
+
+	// decode straight from a memory mapping if possible, that way
+	// event payloads are neither allocated nor copied
+	Om::MappedFile mapped_file;
+	if(!is_standard_stream(program_args.input_path) && !mapped_file.open(program_args.input_path)) {
+		FLPViewInStream flp(mapped_file.data());
+		flp.set_event_mask(program_args.event_mask);
+		if(program_args.n_threads > 1)
+			return flp_to_json_parallel<FormatT>(flp, program_args, stats);
+		if(program_args.pipeline)
+			return flp_to_json_pipelined<FormatT>(flp, program_args, stats);
+		return flp_to_json<FormatT>(flp, program_args, stats);
+	}
 
+	FILE* f = open_input_file(program_args.input_path);
+	if(f == nullptr) {
+		std::fputs("Could not open input file! - Exiting\n", stderr);
+		return false;
+	}
+	FLPInStream<Om::BufferedInFile> flp(f, program_args.read_buffer_size);
+	// payloads are serialized right away, so one reused buffer is enough
+	Om::FLPPayloadArena arena;
+	flp.use_payload_arena(&arena);
+	// payloads of the other events are seeked over, or read and dropped
+	// if the input is a pipe
+	flp.set_event_mask(program_args.event_mask);
+	if(program_args.pipeline)
+		return flp_to_json_pipelined<FormatT>(flp, program_args, stats);
+	return flp_to_json<FormatT>(flp, program_args, stats);
+}
+
+// the formatting is a template parameter so that compact output doesn't
+// pay for indentation checks on every value
+static bool flp_to_json(ProgramOptions const& program_args, FLPStats* stats = nullptr) {
+	OM_TRACE_SPAN("flp_to_json", "convert");
+	if(program_args.compact)
+		return flp_to_json_formatted<Om::JSONCompactFormat>(program_args, stats);
+	return flp_to_json_formatted<Om::JSONPrettyFormat>(program_args, stats);
+}
+
+static bool json_to_flp(ProgramOptions const& program_args) {
+	OM_TRACE_SPAN("json_to_flp", "convert");
+	Om::CFile infile(open_input_file(program_args.input_path));
+	if(!infile.is_open()) {
+		std::fputs("Could not open input file! - Exiting\n", stderr);
+		return false;
+	}
+	FILE* out = open_output_file(program_args.output_path);
+	if(out == nullptr) {
+		std::fputs("Could not open output file! - Exiting\n", stderr);
+		return false;
+	}
+	Om::JSONInStream<Om::CFile> json_stream(infile);
+	FLPOutStream<Om::CFile> flp(out);
+	// the sidecar name is relative to the json file, or the working
+	// directory if it is read from stdin
+	auto open_sidecar = [&](std::string_view name) {
+		std::filesystem::path const p = program_args.input_path.parent_path()
+			/ std::filesystem::path(std::u8string(name.begin(), name.end()));
+		return Om::CFile(Om::open_file(p, "rb"));
+	};
+	Om::json_to_flp(json_stream, flp, open_sidecar);
+	return true;
+}
+
+// what --stats reports besides the events, summed over a batch
+struct RunStats {
+	std::size_t n_files = 0;
+	std::uintmax_t input_bytes = 0;
+	std::uintmax_t output_bytes = 0;
+	FLPStats events;
+};
+
+// after a failed conversion, so that no truncated file is left behind
+static void remove_output(ProgramOptions const& program_args) {
+	if(is_standard_stream(program_args.output_path))
+		return;
+	std::error_code err;
+	std::filesystem::remove(program_args.output_path, err);
+	if(program_args.mode == Mode::flp_to_json && program_args.data_encoding == FLPDataEncoding::sidecar)
+		std::filesystem::remove(sidecar_path(program_args.output_path), err);
+}
+
+// the json file and its sidecar, if any
+static std::uintmax_t output_size(ProgramOptions const& program_args) {
+	std::error_code err;
+	std::uintmax_t size = std::filesystem::file_size(program_args.output_path, err);
+	if(err)
+		size = 0;
+	if(program_args.mode == Mode::flp_to_json && program_args.data_encoding == FLPDataEncoding::sidecar) {
+		std::uintmax_t const sidecar_size = std::filesystem::file_size(sidecar_path(program_args.output_path), err);
+		if(!err)
+			size += sidecar_size;
+	}
+	return size;
+}
+
+static bool write_stats(ProgramOptions const& program_args, RunStats const& run_stats, double seconds) {
+	Om::FdSink stats_file = Om::FdSink::open(program_args.stats_path);
+	if(!stats_file.is_open()) {
+		std::fputs("Could not open stats file!\n", stderr);
+		return false;
+	}
+	Om::AllocationStats const allocations = Om::allocation_stats();
+	try {
+		Om::JSONOutStream<Om::FdSink, Om::JSONPrettyFormat> json_stream(stats_file);
+		json_stream.begin_object();
+		json_stream.key("mode");
+		json_stream.value_str_noescape(program_args.mode == Mode::json_to_flp ? "json_to_flp" : "flp_to_json");
+		json_stream.key("files");
+		json_stream.value(static_cast<std::uint64_t>(run_stats.n_files));
+		json_stream.key("input_bytes");
+		json_stream.value(static_cast<std::uint64_t>(run_stats.input_bytes));
+		json_stream.key("output_bytes");
+		json_stream.value(static_cast<std::uint64_t>(run_stats.output_bytes));
+		json_stream.key("total_seconds");
+		json_stream.value(seconds);
+		json_stream.key("allocations");
+		json_stream.value(allocations.count);
+		json_stream.key("allocated_bytes");
+		json_stream.value(allocations.bytes);
+		json_stream.key("peak_rss_bytes");
+		json_stream.value(Om::peak_rss_bytes());
+		stream_flp_stats(json_stream, run_stats.events);
+		json_stream.end_object();
+		json_stream.flush();
+	} catch(std::exception const&) {
+		std::fputs("Could not write stats file!\n", stderr);
+		return false;
+	}
 	return true;
 }
 
+// the spans of every thread, which must have been joined
+static bool write_trace([[maybe_unused]] ProgramOptions const& program_args) {
+#if OM_TRACE
+	Om::FdSink trace_file = Om::FdSink::open(program_args.trace_path);
+	if(!trace_file.is_open()) {
+		std::fputs("Could not open trace file!\n", stderr);
+		return false;
+	}
+	try {
+		Om::JSONOutStream<Om::FdSink, Om::JSONCompactFormat> json_stream(trace_file);
+		Om::stream_chrome_trace(json_stream);
+		json_stream.flush();
+	} catch(std::exception const&) {
+		std::fputs("Could not write trace file!\n", stderr);
+		return false;
+	}
+#else
+	std::fputs("Tracing isn't compiled in, build with OM_TRACE=1 for --trace\n", stderr);
+#endif
+	return true;
+}
+
+struct BatchInput {
+	std::filesystem::path input_path;
+	std::filesystem::path output_path;
+	std::uintmax_t size;
+};
+
+static std::vector<BatchInput> collect_batch_inputs(ProgramOptions const& program_args) {
+	namespace fs = std::filesystem;
+
+	// without an output directory the json is written next to the flp
+	auto output_for = [&](fs::path const& input, fs::path const& relative) {
+		fs::path out = program_args.output_path.empty() ? input : program_args.output_path / relative;
+		out.replace_filename(input.filename().wstring() + L".json");
+		return out;
+	};
+
+	std::vector<BatchInput> inputs;
+	auto add_input = [&](fs::path const& input, fs::path const& relative) {
+		std::error_code err;
+		std::uintmax_t const size = fs::file_size(input, err);
+		inputs.push_back({ input, output_for(input, relative), err ? 0 : size });
+	};
+
+	if(!program_args.input_path.empty()) {
+		fs::path const& dir = program_args.input_path;
+		for(auto const& entry : fs::recursive_directory_iterator(dir, fs::directory_options::skip_permission_denied)) {
+			if(entry.is_regular_file() && (has_extension(entry.path(), L".flp") || has_extension(entry.path(), L".zip"))) {
+				add_input(entry.path(), entry.path().lexically_relative(dir));
+			}
+		}
+	}
+
+	if(!program_args.list_path.empty()) {
+		std::ifstream list(program_args.list_path);
+		if(!list)
+			throw std::runtime_error("could not open list file");
+		std::string line;
+		while(std::getline(list, line)) {
+			if(!line.empty() && line.back() == '\r')
+				line.pop_back();
+			if(line.empty())
+				continue;
+			fs::path const input(std::u8string(line.begin(), line.end()));
+			// relative entries keep their directories in the output directory
+			fs::path relative = input.lexically_normal();
+			if(relative.has_root_path() || relative.empty() || *relative.begin() == "..")
+				relative = input.filename();
+			add_input(input, relative);
+		}
+	}
+
+	// an input that is listed twice is converted once
+	std::sort(inputs.begin(), inputs.end(), [](BatchInput const& a, BatchInput const& b) {
+		return a.input_path < b.input_path;
+	});
+	inputs.erase(std::unique(inputs.begin(), inputs.end(), [](BatchInput const& a, BatchInput const& b) {
+		return a.input_path == b.input_path;
+	}), inputs.end());
+
+	// largest files first so they don't finish last
+	std::sort(inputs.begin(), inputs.end(), [](BatchInput const& a, BatchInput const& b) {
+		return a.size > b.size;
+	});
+	return inputs;
+}
+
+// Inputs that would be written to the same output file are reported, as
+// their conversions would overwrite each other.
+static bool check_batch_outputs(std::vector<BatchInput> const& inputs) {
+	std::vector<BatchInput const*> by_output;
+	by_output.reserve(inputs.size());
+	for(BatchInput const& input : inputs) {
+		by_output.push_back(&input);
+	}
+	std::sort(by_output.begin(), by_output.end(), [](BatchInput const* a, BatchInput const* b) {
+		return a->output_path < b->output_path;
+	});
+	bool has_conflicts = false;
+	for(std::size_t i = 1; i < by_output.size(); ++i) {
+		if(by_output[i - 1]->output_path == by_output[i]->output_path) {
+			std::fprintf(stderr, OM_PATH_FORMAT " and " OM_PATH_FORMAT " would both be written to " OM_PATH_FORMAT "\n",
+			             by_output[i - 1]->input_path.c_str(), by_output[i]->input_path.c_str(), by_output[i]->output_path.c_str());
+			has_conflicts = true;
+		}
+	}
+	if(has_conflicts)
+		std::fputs("Inputs with the same output file! - Exiting\n", stderr);
+	return !has_conflicts;
+}
+
+// Everything besides the paths that changes the json. A cache manifest is
+// only used by runs with the same key.
+static std::string cache_options_key(ProgramOptions const& program_args) {
+	std::string key;
+	key += data_encoding_name(program_args.data_encoding);
+	key += ' ';
+	key += record_layout_name(program_args.record_layout);
+	key += program_args.compact ? " compact " : " pretty ";
+	// the event mask as hex, event 0 in the last digit
+	static constexpr char digits[] = "0123456789abcdef";
+	for(int id = 252; id >= 0; id -= 4) {
+		unsigned nibble = 0;
+		for(int bit = 0; bit < 4; ++bit) {
+			if(program_args.event_mask.test(static_cast<FLPEventType>(id + bit)))
+				nibble |= 1U << bit;
+		}
+		key += digits[nibble];
+	}
+	return key;
+}
+
+// Converts every input on a work stealing pool and prints a summary. With
+// a cache manifest inputs whose output is up to date are skipped. Only
+// converted files are counted in run_stats, which may be nullptr.
+static bool batch_flp_to_json(ProgramOptions const& program_args, RunStats* run_stats) {
+	using namespace std::chrono;
+	using clock = high_resolution_clock;
+
+	auto const begin_time = clock::now();
+
+	if(!program_args.input_path.empty() && !std::filesystem::is_directory(program_args.input_path)) {
+		std::fputs("The input must be a directory in batch runs! - Exiting\n", stderr);
+		return false;
+	}
+	std::vector<BatchInput> inputs;
+	try {
+		inputs = collect_batch_inputs(program_args);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, "Could not collect the inputs: %s - Exiting\n", e.what());
+		return false;
+	}
+	if(!check_batch_outputs(inputs))
+		return false;
+
+	bool const use_cache = !program_args.cache_path.empty();
+	Om::ConversionCache cache(cache_options_key(program_args));
+	if(use_cache)
+		cache.load(program_args.cache_path);
+	// what to record per input, empty if it failed
+	std::vector<std::optional<Om::ConversionCacheEntry>> cache_entries(inputs.size());
+
+	std::atomic<std::size_t> n_converted { 0 };
+	std::atomic<std::size_t> n_up_to_date { 0 };
+	std::atomic<std::size_t> n_failed { 0 };
+	std::atomic<std::uintmax_t> bytes_converted { 0 };
+	std::mutex run_stats_mutex;
+	{
+		Om::WorkStealingPool pool(program_args.n_threads);
+		for(std::size_t i = 0; i < inputs.size(); ++i) {
+			pool.submit([&, i] {
+				BatchInput const& input = inputs[i];
+				std::optional<Om::ConversionCacheEntry>& cache_entry = cache_entries[i];
+				std::filesystem::path const sidecar = program_args.data_encoding == FLPDataEncoding::sidecar
+					? sidecar_path(input.output_path)
+					: std::filesystem::path();
+				if(use_cache) {
+					cache_entry = cache.up_to_date(input.input_path, input.output_path, sidecar);
+					if(cache_entry) {
+						++n_up_to_date;
+						return;
+					}
+					cache_entry = Om::ConversionCache::describe_input(input.input_path);
+				}
+				ProgramOptions file_args = program_args;
+				file_args.input_path = input.input_path;
+				file_args.output_path = input.output_path;
+				file_args.n_threads = 1;
+				file_args.is_batch = false;
+				std::optional<FLPStats> file_stats;
+				if(run_stats)
+					file_stats.emplace();
+				bool success = false;
+				try {
+					std::error_code err;
+					std::filesystem::create_directories(file_args.output_path.parent_path(), err);
+					success = flp_to_json(file_args, file_stats ? &*file_stats : nullptr);
+				} catch(std::exception const& e) {
+					std::fprintf(stderr, OM_PATH_FORMAT ": %s\n", input.input_path.c_str(), e.what());
+				}
+				if(success) {
+					++n_converted;
+					bytes_converted += input.size;
+					if(run_stats) {
+						std::uintmax_t const output_bytes = output_size(file_args);
+						std::lock_guard<std::mutex> lock(run_stats_mutex);
+						++run_stats->n_files;
+						run_stats->input_bytes += input.size;
+						run_stats->output_bytes += output_bytes;
+						run_stats->events.merge(*file_stats);
+					}
+					if(cache_entry && !Om::ConversionCache::set_output(&*cache_entry, input.output_path, sidecar))
+						cache_entry.reset();
+				} else {
+					++n_failed;
+					cache_entry.reset();
+					// don't leave a truncated document behind
+					std::error_code err;
+					std::filesystem::remove(file_args.output_path, err);
+					if(!sidecar.empty())
+						std::filesystem::remove(sidecar, err);
+				}
+			});
+		}
+		pool.wait();
+	}
+
+	if(use_cache) {
+		for(std::size_t i = 0; i < inputs.size(); ++i) {
+			if(cache_entries[i])
+				cache.insert(inputs[i].input_path, std::move(*cache_entries[i]));
+			else
+				cache.erase(inputs[i].input_path);
+		}
+		if(!cache.save(program_args.cache_path))
+			std::fputs("Could not write the cache manifest!\n", stderr);
+	}
+
+	auto const end_time = clock::now();
+	double const seconds = duration<double>(end_time - begin_time).count();
+	double const megabytes = static_cast<double>(bytes_converted) / (1024.0 * 1024.0);
+	if(use_cache)
+		std::printf("converted: %zu, up to date: %zu, failed: %zu\n", n_converted.load(), n_up_to_date.load(), n_failed.load());
+	else
+		std::printf("converted: %zu, failed: %zu\n", n_converted.load(), n_failed.load());
+	std::printf("%.1f MB in %.3fs, %.1f MB/s, %.1f files/s\n",
+	            megabytes, seconds,
+	            seconds > 0 ? megabytes / seconds : 0.0,
+	            seconds > 0 ? static_cast<double>(n_converted.load()) / seconds : 0.0);
+
+	return n_failed == 0;
+}
+
 static ProgramOptions get_program_options(int argc, wchar_t* argv[]) {
 	auto write_path_arg = [](std::filesystem::path& p) -> std::function<void(wchar_t const*)> {
 		return [&p] (wchar_t const* arg) {
@@ -89,51 +1024,240 @@ static ProgramOptions get_program_options(int argc, wchar_t* argv[]) {
 		};
 	};
 
+	auto write_size_arg = [](std::size_t& n, std::size_t min_value, std::size_t max_value = SIZE_MAX) -> std::function<void(wchar_t const*)> {
+		return [&n, min_value, max_value] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			wchar_t* end;
+			errno = 0;
+			unsigned long long const value = std::wcstoull(arg, &end, 10);
+			if(*end != L'\0' || errno == ERANGE || value < min_value || value > max_value)
+				throw std::runtime_error("invalid size argument");
+			n = static_cast<std::size_t>(value);
+		};
+	};
+
 	ProgramOptions program_args {};
 	Om::ArgHandlerMap<wchar_t> const arg_handlers = {
-		{L"o", write_path_arg(program_args.output_path)},
-		{L"",  write_path_arg(program_args.input_path) }
+		{L"o",           write_path_arg(program_args.output_path)},
+		{L"read-buffer", write_size_arg(program_args.read_buffer_size, 16)},
+		{L"write-buffer", write_size_arg(program_args.write_buffer_size, Om::JSONOutStream<Om::FdSink>::min_buffer_size, Om::JSONOutStream<Om::FdSink>::max_buffer_size)},
+		{L"j",           [&, write_n = write_size_arg(program_args.n_threads, 0)] (wchar_t const* arg) {
+			write_n(arg);
+			if(program_args.n_threads == 0) // use all cores
+				program_args.n_threads = std::max(1U, std::thread::hardware_concurrency());
+		}},
+		{L"list",        write_path_arg(program_args.list_path)},
+		{L"cache",       write_path_arg(program_args.cache_path)},
+		{L"stats",       write_path_arg(program_args.stats_path)},
+		{L"trace",       write_path_arg(program_args.trace_path)},
+		{L"data-encoding", [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			for(FLPDataEncoding encoding : { FLPDataEncoding::hex, FLPDataEncoding::base64, FLPDataEncoding::sidecar }) {
+				std::string_view const name = data_encoding_name(encoding);
+				if(std::wstring_view(arg) == std::wstring(name.begin(), name.end())) {
+					program_args.data_encoding = encoding;
+					return;
+				}
+			}
+			throw std::runtime_error("invalid data encoding");
+		}},
+		{L"record-layout", [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			for(FLPRecordLayout layout : { FLPRecordLayout::rows, FLPRecordLayout::columns }) {
+				std::string_view const name = record_layout_name(layout);
+				if(std::wstring_view(arg) == std::wstring(name.begin(), name.end())) {
+					program_args.record_layout = layout;
+					return;
+				}
+			}
+			throw std::runtime_error("invalid record layout");
+		}},
+		{L"events",      [&] (wchar_t const* arg) {
+			// comma separated event names or ids, "FLP_FineTempo,224"
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			FLPEventMask mask;
+			for(std::wstring_view rest = arg; !rest.empty();) {
+				std::size_t const comma = rest.find(L',');
+				std::wstring_view const item = rest.substr(0, comma);
+				rest = comma == std::wstring_view::npos ? std::wstring_view() : rest.substr(comma + 1);
+				if(item.empty())
+					continue;
+				std::string name;
+				for(wchar_t c : item) {
+					if(c > 0x7F)
+						throw std::runtime_error("invalid event type");
+					name.push_back(static_cast<char>(c));
+				}
+				unsigned id = 0;
+				auto const result = std::from_chars(name.data(), name.data() + name.size(), id);
+				if(result.ec == std::errc() && result.ptr == name.data() + name.size() && id <= 255) {
+					mask.set(static_cast<FLPEventType>(id));
+				} else if(std::optional<FLPEventType> const type = flp_event_type_from_name(name)) {
+					mask.set(*type);
+				} else {
+					throw std::runtime_error("invalid event type");
+				}
+			}
+			// FLP_Version decides whether strings are UTF-16, so it is always
+			// read and kept in the json to make the projection convertible back
+			mask.set(FLPEventType::FLP_Version);
+			program_args.event_mask = mask;
+		}},
+		{L"to",          [&] (wchar_t const* arg) {
+			// needed if stdin is converted to stdout, there are no extensions
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			if(std::wstring_view(arg) == L"json")
+				program_args.mode = Mode::flp_to_json;
+			else if(std::wstring_view(arg) == L"flp")
+				program_args.mode = Mode::json_to_flp;
+			else
+				throw std::runtime_error("invalid output type");
+		}},
+		{L"pipeline",    [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			if(std::wstring_view(arg) == L"on")
+				program_args.pipeline = true;
+			else if(std::wstring_view(arg) == L"off")
+				program_args.pipeline = false;
+			else
+				throw std::runtime_error("invalid pipeline setting");
+		}},
+		{L"format",      [&] (wchar_t const* arg) {
+			if(arg == nullptr)
+				throw std::runtime_error("missing argument");
+			if(std::wstring_view(arg) == L"compact")
+				program_args.compact = true;
+			else if(std::wstring_view(arg) == L"pretty")
+				program_args.compact = false;
+			else
+				throw std::runtime_error("invalid format");
+		}},
+		{L"",            write_path_arg(program_args.input_path) }
 	};
 
 	Om::parse_args<wchar_t>(argc, argv, arg_handlers);
 
+	program_args.is_batch = !program_args.list_path.empty()
+	                        || std::filesystem::is_directory(program_args.input_path);
+
+	// by default only batches use all cores
+	if(program_args.n_threads == 0) {
+		program_args.n_threads = program_args.is_batch ? std::max(1U, std::thread::hardware_concurrency()) : 1;
+	}
+
 	if(program_args.mode == Mode::not_set) {
+		// stdin has no extension, but the output may have one
 		auto const input_file_extension = program_args.input_path.extension();
-		if(input_file_extension == L"json") {
+		if(is_standard_stream(program_args.input_path)) {
+			program_args.mode = program_args.output_path.extension() == L".flp" ? Mode::json_to_flp : Mode::flp_to_json;
+		} else if(input_file_extension == L".json") {
 			program_args.mode = Mode::json_to_flp;
 		} else {
 			program_args.mode = Mode::flp_to_json;
 		}
 	}
 
-	if(program_args.mode == Mode::flp_to_json) {
+	if(is_standard_stream(program_args.input_path) && program_args.output_path.empty()) {
+		program_args.output_path = program_args.input_path;
+	}
+
+	if(program_args.mode == Mode::flp_to_json && !program_args.is_batch) {
 		if(program_args.output_path.empty()) {
 			program_args.output_path = program_args.input_path;
 			program_args.output_path.replace_filename(
 				program_args.input_path.filename().wstring() + L".json"
 			);
 		}
+	} else if(program_args.mode == Mode::json_to_flp) {
+		if(program_args.output_path.empty()) {
+			// "x.flp.json" becomes "x.flp"
+			program_args.output_path = program_args.input_path;
+			program_args.output_path.replace_extension();
+			if(program_args.output_path.extension() != L".flp") {
+				program_args.output_path += L".flp";
+			}
+		}
 	}
 
+	if(program_args.mode == Mode::flp_to_json && program_args.data_encoding == FLPDataEncoding::sidecar
+	   && is_standard_stream(program_args.output_path))
+		throw std::runtime_error("the sidecar encoding needs an output file");
+
 	return program_args;
 }
 
 int wmain(int argc, wchar_t* argv[]) {
-	ProgramOptions program_args = get_program_options(argc, argv);
-
-	std::printf("Input file: %ls\n", program_args.input_path.c_str());
-	std::printf("Output file: %ls\n", program_args.output_path.c_str());
+	ProgramOptions program_args;
+	try {
+		program_args = get_program_options(argc, argv);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, "Invalid arguments: %s - Exiting\n", e.what());
+		return EXIT_FAILURE;
+	}
 
 	using namespace std::chrono;
 	using clock = high_resolution_clock;
 
+	// only allocated with --stats, FLPStats is a few KiB
+	std::unique_ptr<RunStats> run_stats;
+	if(!program_args.stats_path.empty())
+		run_stats = std::make_unique<RunStats>();
+
+	if(program_args.is_batch) {
+		auto const begin_time = clock::now();
+		bool const success = batch_flp_to_json(program_args, run_stats.get());
+		if(run_stats && !write_stats(program_args, *run_stats, duration<double>(clock::now() - begin_time).count()))
+			return EXIT_FAILURE;
+		if(!program_args.trace_path.empty() && !write_trace(program_args))
+			return EXIT_FAILURE;
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// keep the messages out of the output if that is stdout
+	FILE* const messages = is_standard_stream(program_args.output_path) ? stderr : stdout;
+	std::fprintf(messages, "Input file: " OM_PATH_FORMAT "\n", program_args.input_path.c_str());
+	std::fprintf(messages, "Output file: " OM_PATH_FORMAT "\n", program_args.output_path.c_str());
+
 	auto begin_time = clock::now();
 
-	if(!flp_to_json(program_args))
+	bool success = false;
+	try {
+		success = program_args.mode == Mode::json_to_flp
+			? json_to_flp(program_args)
+			: flp_to_json(program_args, run_stats ? &run_stats->events : nullptr);
+	} catch(std::exception const& e) {
+		std::fprintf(stderr, OM_PATH_FORMAT ": %s\n", program_args.input_path.c_str(), e.what());
+		remove_output(program_args);
+	}
+	if(!success)
 		return EXIT_FAILURE;
 
 	auto end_time = clock::now();
-	std::printf("elapsed time: %lldus\n", duration_cast<microseconds>(end_time - begin_time).count());
+	std::fprintf(messages, "elapsed time: %lldus\n", static_cast<long long>(duration_cast<microseconds>(end_time - begin_time).count()));
+
+	if(run_stats) {
+		std::error_code err;
+		std::uintmax_t const input_bytes = std::filesystem::file_size(program_args.input_path, err);
+		run_stats->n_files = 1;
+		run_stats->input_bytes = err ? 0 : input_bytes;
+		run_stats->output_bytes = output_size(program_args);
+		if(!write_stats(program_args, *run_stats, duration<double>(end_time - begin_time).count()))
+			return EXIT_FAILURE;
+	}
+	if(!program_args.trace_path.empty() && !write_trace(program_args))
+		return EXIT_FAILURE;
 
 	return EXIT_SUCCESS;
 }
+
+#ifndef _WIN32
+int main(int argc, char* argv[]) {
+	return Om::call_wmain(argc, argv, wmain);
+}
+#endif
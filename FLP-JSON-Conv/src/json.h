@@ -1,5 +1,11 @@
 #pragma once
 
+#include "flp_cpu_features.h"
+#include "flp_utf_conversions.h"
+#include "flp_trace.h"
+
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <string_view>
@@ -10,80 +16,151 @@
 #include <string>
 #include <type_traits>
 #include <charconv>
+#include <climits>
+#include <limits>
+#include <memory>
 #include <new>
+#include <system_error>
+#include <exception>
+
+#if OM_ARCH_X86
+#include <immintrin.h>
+#endif
 
 
 namespace Om {
 
-inline std::string json_escape_string(std::string_view strv) {
-	static char escape_chars[] = {
-		'"',
-		'\\',
-		'/',
-		'\b',
-		'\f',
-		'\n',
-		'\r',
-		'\t',
-		'\0'
-	};
-	char const* str = strv.data();
-	char const* endptr = str + strv.size();
-	std::string ret;
-	for(;;) {
-		char const* where = nullptr;
-		for(char const* p = str; p < endptr; ++p) {
-			for(char const* pesc = &escape_chars[0]; *pesc != '\0'; ++pesc) {
-				if(*p == *pesc) {
-					where = p;
-					break;
-				}
-			}
-			if(where != nullptr)
-				break;
+namespace detail {
+
+	// '"', '\\' and '/' and all control characters are escaped
+	inline bool json_needs_escape(char c) noexcept {
+		return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\' || c == '/';
+	}
+
+	inline char const* find_json_escape_scalar(char const* p, char const* end) noexcept {
+		while(p != end && !json_needs_escape(*p)) {
+			++p;
 		}
-		if(where == nullptr) {
-			break;
+		return p;
+	}
+
+#if OM_ARCH_X86
+	// SSE2 is part of x86-64 and the default for x86 builds
+	inline char const* find_json_escape_sse2(char const* p, char const* end) noexcept {
+		__m128i const quote = _mm_set1_epi8('"');
+		__m128i const backslash = _mm_set1_epi8('\\');
+		__m128i const slash = _mm_set1_epi8('/');
+		__m128i const max_control = _mm_set1_epi8(0x1F);
+		for(; end - p >= 16; p += 16) {
+			__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+			__m128i const special = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+				_mm_or_si128(_mm_cmpeq_epi8(v, slash), _mm_cmpeq_epi8(_mm_max_epu8(v, max_control), max_control)));
+			int const mask = _mm_movemask_epi8(special);
+			if(mask != 0)
+				return p + std::countr_zero(static_cast<unsigned>(mask));
 		}
-		ret.append(str, where - str);
-		switch(*where) {
-		case '"':
-			ret.append("\\\"", 2);
-			break;
-		case '\\':
-			ret.append("\\\\", 2);
-			break;
-		case '/':
-			ret.append("\\/", 2);
-			break;
-		case '\b':
-			ret.append("\\b", 2);
-			break;
-		case '\f':
-			ret.append("\\f", 2);
-			break;
-		case '\n':
-			ret.append("\\n", 2);
-			break;
-		case '\r':
-			ret.append("\\r", 2);
-			break;
-		case '\t':
-			ret.append("\\t", 2);
-			break;
+		return find_json_escape_scalar(p, end);
+	}
+
+	OM_TARGET("avx2")
+	inline char const* find_json_escape_avx2(char const* p, char const* end) noexcept {
+		__m256i const quote = _mm256_set1_epi8('"');
+		__m256i const backslash = _mm256_set1_epi8('\\');
+		__m256i const slash = _mm256_set1_epi8('/');
+		__m256i const max_control = _mm256_set1_epi8(0x1F);
+		for(; end - p >= 32; p += 32) {
+			__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+			__m256i const special = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, slash), _mm256_cmpeq_epi8(_mm256_max_epu8(v, max_control), max_control)));
+			auto const mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+			if(mask != 0)
+				return p + std::countr_zero(mask);
 		}
-		str = where + 1;
+		return find_json_escape_sse2(p, end);
+	}
+#endif
+
+	// position of the first char in [p, end) that has to be escaped, or end
+	inline char const* find_json_escape(char const* p, char const* end) noexcept {
+#if OM_ARCH_X86
+		static bool const use_avx2 = cpu_features().avx2;
+		return use_avx2 ? find_json_escape_avx2(p, end) : find_json_escape_sse2(p, end);
+#else
+		return find_json_escape_scalar(p, end);
+#endif
+	}
+
+	constexpr int max_json_escape_length = 6;
+
+	// writes the escape sequence for c, returns its length
+	inline int json_escape_char(char c, char* out) noexcept {
+		char short_form = 0;
+		switch(c) {
+		case '"':  short_form = '"'; break;
+		case '\\': short_form = '\\'; break;
+		case '/':  short_form = '/'; break;
+		case '\b': short_form = 'b'; break;
+		case '\f': short_form = 'f'; break;
+		case '\n': short_form = 'n'; break;
+		case '\r': short_form = 'r'; break;
+		case '\t': short_form = 't'; break;
+		}
+		out[0] = '\\';
+		if(short_form != 0) {
+			out[1] = short_form;
+			return 2;
+		}
+		// other control characters
+		constexpr char hex_digits[] = "0123456789abcdef";
+		auto const uc = static_cast<unsigned char>(c);
+		out[1] = 'u';
+		out[2] = '0';
+		out[3] = '0';
+		out[4] = hex_digits[uc >> 4];
+		out[5] = hex_digits[uc & 0x0F];
+		return 6;
 	}
-	ret.append(str, endptr - str);
-	return ret;
 }
 
-template<typename StreamT>
+// One of several buffers written with a single call.
+struct IOSlice {
+	char const* data;
+	std::size_t size;
+};
+
+// Formatting policies for JSONOutStream. Pretty output puts every key and
+// array element on its own line, indented with tabs. Compact output has no
+// whitespace at all, the indentation code isn't even compiled.
+struct JSONPrettyFormat {
+	static constexpr bool pretty = true;
+};
+
+struct JSONCompactFormat {
+	static constexpr bool pretty = false;
+};
+
+// StreamT needs write(char const* data, std::size_t size). If it also has
+// writev(IOSlice const* slices, std::size_t n) the buffered output and a
+// large value that bypasses the buffer are written with one call.
+// Call flush() once the document is complete, so that errors of the
+// stream are thrown where they can be handled. The destructor only writes
+// what is left if it isn't reached by an exception.
+template<typename StreamT, typename FormatT = JSONPrettyFormat>
 class JSONOutStream {
 public:
-	JSONOutStream(StreamT& underlying) :
+	static constexpr std::size_t default_buffer_size = 64 * 1024;
+	static constexpr std::size_t min_buffer_size = 256;
+	static constexpr std::size_t max_buffer_size = std::size_t(1) << 30; // positions in it are ints
+
+	explicit JSONOutStream(StreamT& underlying, std::size_t buffer_size = default_buffer_size) :
 		m_stream { underlying },
-		m_position { &m_buffer[0] } {
+		m_buffer { std::make_unique_for_overwrite<char[]>(buffer_size) },
+		m_buffer_size { static_cast<int>(buffer_size) },
+		m_position { m_buffer.get() },
+		m_uncaught_exceptions { std::uncaught_exceptions() } {
+		assert(buffer_size >= min_buffer_size && buffer_size <= max_buffer_size);
 	}
 
 	JSONOutStream(JSONOutStream const&) = delete;
@@ -92,8 +169,12 @@ public:
 	JSONOutStream& operator=(JSONOutStream&&) = delete;
 
 	~JSONOutStream() {
-		assert(m_agg_stack.empty());
-		flush();
+		// A conversion that threw leaves its aggregates open. Its output is
+		// incomplete anyway, and a stream that throws again would terminate.
+		bool const is_unwinding = std::uncaught_exceptions() > m_uncaught_exceptions;
+		assert(m_agg_stack.empty() || is_unwinding);
+		if(!is_unwinding && m_position != m_buffer.get())
+			flush();
 	}
 
 	void begin_object() {
@@ -118,10 +199,31 @@ public:
 		end_aggregate(']');
 	}
 
+	// Continue an object or array whose opening was written by another
+	// JSONOutStream, so that parts of one document can be written
+	// independently and concatenated.
+	void resume_object(bool has_elements) {
+		resume_aggregate(AggregateType::Object, has_elements);
+	}
+
+	void resume_array(bool has_elements) {
+		resume_aggregate(AggregateType::Array, has_elements);
+	}
+
+	// leave the innermost object or array open for another JSONOutStream
+	void suspend_aggregate() {
+		assert(!m_agg_stack.empty());
+		m_agg_stack.pop();
+	}
+
 	void key(std::string_view key) {
 		int const keylen = static_cast<int>(key.length());
-		// space for newline, indentation, key, quotes, colon and space
-		int required_size = 1 + int(m_agg_stack.size()) + 1 + keylen + 1 + 1 + 1;
+		// space for key, quotes and colon
+		int required_size = 1 + keylen + 1 + 1;
+		if constexpr(FormatT::pretty) {
+			// newline, indentation and space after the colon
+			required_size += 1 + int(m_agg_stack.size()) + 1;
+		}
 		assert(!m_agg_stack.empty() && m_agg_stack.top().type() == AggregateType::Object);
 		bool const is_not_first_key = m_agg_stack.top().nonempty();
 		if(is_not_first_key) {
@@ -131,29 +233,76 @@ public:
 		if(is_not_first_key) {
 			*m_position++ = ',';
 		}
-		*m_position++ = '\n';
-		indent();
+		if constexpr(FormatT::pretty) {
+			*m_position++ = '\n';
+			indent();
+		}
 		*m_position++ = '"';
 		std::memcpy(m_position, key.data(), keylen);
 		m_position += keylen;
 		*m_position++ = '"';
 		*m_position++ = ':';
-		*m_position++ = ' ';
+		if constexpr(FormatT::pretty) {
+			*m_position++ = ' ';
+		}
 	}
 
 	void value(std::string_view value) {
-		value_str_noescape(json_escape_string(value));
+		// copy the runs between characters that need escaping straight into the buffer
+		prepare_write_value(1);
+		*m_position++ = '"';
+		char const* p = value.data();
+		char const* const end = p + value.size();
+		for(;;) {
+			char const* const next = detail::find_json_escape(p, end);
+			write_raw(p, static_cast<std::size_t>(next - p));
+			if(next == end)
+				break;
+			flush_if_necessary(detail::max_json_escape_length);
+			m_position += detail::json_escape_char(*next, m_position);
+			p = next + 1;
+		}
+		flush_if_necessary(1);
+		*m_position++ = '"';
+		if(!m_agg_stack.empty())
+			m_agg_stack.top().set_nonempty();
+	}
+
+	// Transcodes UTF-16 to UTF-8 right into the buffer, piece by piece,
+	// and escapes the piece in place. Throws std::system_error for unpaired
+	// surrogates.
+	void value(std::u16string_view value) {
+		// any code unit takes at most 6 chars, 3 as UTF-8 or 6 as \u00XX
+		constexpr int max_unit_length = 6;
+		constexpr int min_piece_units = 32;
+		prepare_write_value(1);
+		*m_position++ = '"';
+		while(!value.empty()) {
+			flush_if_necessary(min_piece_units * max_unit_length);
+			std::size_t n_units = std::min<std::size_t>(value.size(), space_available() / max_unit_length);
+			// surrogate pairs stay in one piece
+			if(n_units < value.size() && is_utf16_high_surrogate(load_utf16_unit(value.data() + n_units - 1)))
+				--n_units;
+			std::size_t n_chars = 0;
+			if(std::error_code err = utf16_to_utf8(value.substr(0, n_units), m_position, &n_chars))
+				throw std::system_error(err);
+			escape_in_place(n_chars);
+			value.remove_prefix(n_units);
+		}
+		flush_if_necessary(1);
+		*m_position++ = '"';
+		if(!m_agg_stack.empty())
+			m_agg_stack.top().set_nonempty();
 	}
 
 	void value_str_noescape(std::string_view value) {
 		int const vlen = static_cast<int>(value.size());
 		int const size_required = vlen + 2;
 
-		if(size_required > buffer_size) {
+		if(size_required > m_buffer_size) {
 			prepare_write_value(1);
 			*m_position++ ='"';
-			flush();
-			m_stream.write(value.data(), vlen);
+			flush_and_write(value.data(), value.size());
 			*m_position++ = '"';
 		} else {
 			prepare_write_value(size_required);
@@ -166,6 +315,27 @@ public:
 			m_agg_stack.top().set_nonempty();
 	}
 
+	// Writes a string value of length chars without escaping. The chars are
+	// produced by fill(char* out, std::size_t n) directly in the output
+	// buffer, in pieces of n chars and in order.
+	template<typename Fill>
+	void value_str_fill(std::size_t length, Fill fill) {
+		prepare_write_value(1);
+		*m_position++ = '"';
+		while(length > 0) {
+			if(space_available() == 0)
+				flush();
+			std::size_t const n = std::min<std::size_t>(length, space_available());
+			fill(m_position, n);
+			m_position += n;
+			length -= n;
+		}
+		flush_if_necessary(1);
+		*m_position++ = '"';
+		if(!m_agg_stack.empty())
+			m_agg_stack.top().set_nonempty();
+	}
+
 	void value(std::byte bt) {
 		prepare_write_value(3);
 		auto value = static_cast<unsigned char>(bt);
@@ -177,43 +347,74 @@ public:
 	
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic_v<T>> value(T value) {
-		// TODO: charconv
-		auto s = std::to_string(value);
-		prepare_write_value(static_cast<int>(s.size()));
-		std::memcpy(m_position, s.data(), s.size());
-		m_position += s.size();
-		if(!m_agg_stack.empty())
-			m_agg_stack.top().set_nonempty();
+		if constexpr(std::is_same_v<T, bool>) {
+			value_literal(value ? std::string_view("true") : std::string_view("false"));
+		} else {
+			// sign, digits and for floating point the exponent
+			constexpr int max_chars = std::is_integral_v<T>
+				? std::numeric_limits<T>::digits10 + 2
+				: std::numeric_limits<T>::max_digits10 + 8;
+			prepare_write_value(max_chars);
+			auto const result = std::to_chars(m_position, m_position + max_chars, value);
+			assert(result.ec == std::errc());
+			m_position = result.ptr;
+			if(!m_agg_stack.empty())
+				m_agg_stack.top().set_nonempty();
+		}
 	}
 
 	void value(std::nullptr_t) {
-		prepare_write_value(sizeof("null") - 1);
-		std::memcpy(m_position, "null", sizeof("null") - 1);
-		m_position += sizeof("null") - 1;
-		if(!m_agg_stack.empty())
-			m_agg_stack.top().set_nonempty();
+		value_literal("null");
 	}
 
 	void flush() {
-		m_stream.write(&m_buffer[0], m_position - &m_buffer[0]);
-		m_position = &m_buffer[0];
+		OM_TRACE_SPAN("flush", "json");
+		m_stream.write(m_buffer.get(), static_cast<std::size_t>(m_position - m_buffer.get()));
+		m_position = m_buffer.get();
 	}
 
 private:
+	void value_literal(std::string_view literal) {
+		prepare_write_value(static_cast<int>(literal.size()));
+		std::memcpy(m_position, literal.data(), literal.size());
+		m_position += literal.size();
+		if(!m_agg_stack.empty())
+			m_agg_stack.top().set_nonempty();
+	}
+
+	// writes the buffer followed by data that is too large for it
+	void flush_and_write(char const* data, std::size_t size) {
+		if constexpr(requires(IOSlice const* slices) { m_stream.writev(slices, std::size_t(2)); }) {
+			IOSlice const slices[2] = {
+				{ m_buffer.get(), static_cast<std::size_t>(m_position - m_buffer.get()) },
+				{ data, size }
+			};
+			m_stream.writev(slices, 2);
+			m_position = m_buffer.get();
+		} else {
+			flush();
+			m_stream.write(data, size);
+		}
+	}
+
 	void end_aggregate(char term_symbol) {
 		bool const has_elements = m_agg_stack.top().nonempty();
 		m_agg_stack.pop();
 
-		int size_required = 1;
-		if(has_elements) {
-			// newline and indent
-			size_required += 1 + int(m_agg_stack.size());
-		}
-		flush_if_necessary(size_required);
+		if constexpr(FormatT::pretty) {
+			int size_required = 1;
+			if(has_elements) {
+				// newline and indent
+				size_required += 1 + int(m_agg_stack.size());
+			}
+			flush_if_necessary(size_required);
 
-		if(has_elements) {
-			*m_position++ = '\n';
-			indent();
+			if(has_elements) {
+				*m_position++ = '\n';
+				indent();
+			}
+		} else {
+			flush_if_necessary(1);
 		}
 		*m_position++ = term_symbol;
 
@@ -221,12 +422,56 @@ private:
 			m_agg_stack.top().set_nonempty();
 	}
 
+	// Escapes the n_chars that were written at m_position and moves past
+	// them, the caller made sure that there is enough space for escaping
+	// all of them.
+	void escape_in_place(std::size_t n_chars) {
+		char* const end = m_position + n_chars;
+		char* const first = const_cast<char*>(detail::find_json_escape(m_position, end));
+		if(first == end) {
+			m_position = end;
+			return;
+		}
+		// move the chars back to front to their escaped positions
+		char escaped[detail::max_json_escape_length];
+		std::size_t extra = 0;
+		for(char const* p = first; p != end; ++p) {
+			if(detail::json_needs_escape(*p))
+				extra += detail::json_escape_char(*p, escaped) - 1;
+		}
+		char* out = end + extra;
+		for(char const* p = end; p != first;) {
+			--p;
+			if(detail::json_needs_escape(*p)) {
+				int const len = detail::json_escape_char(*p, escaped);
+				out -= len;
+				std::memcpy(out, escaped, len);
+			} else {
+				*--out = *p;
+			}
+		}
+		m_position = end + extra;
+	}
+
+	// copies without separators, in one write if it doesn't fit into the buffer
+	void write_raw(char const* data, std::size_t size) {
+		if(size > static_cast<std::size_t>(space_available())) {
+			if(size > static_cast<std::size_t>(m_buffer_size)) {
+				flush_and_write(data, size);
+				return;
+			}
+			flush();
+		}
+		std::memcpy(m_position, data, size);
+		m_position += size;
+	}
+
 	int space_available() {
-		return static_cast<int>((m_buffer + buffer_size) - m_position);
+		return static_cast<int>((m_buffer.get() + m_buffer_size) - m_position);
 	}
 
 	void flush_if_necessary(int required_size) {
-		assert(required_size <= buffer_size);
+		assert(required_size <= m_buffer_size);
 		if(space_available() < required_size) {
 			flush();
 		}
@@ -244,8 +489,10 @@ private:
 		if(!m_agg_stack.empty()) {
 			StackEntry const e = m_agg_stack.top();
 			if(e.type() == AggregateType::Array) {
-				add_newline = true;
-				size_required += 1 + int(m_agg_stack.size());
+				if constexpr(FormatT::pretty) {
+					add_newline = true;
+					size_required += 1 + int(m_agg_stack.size());
+				}
 				if(e.nonempty()) {
 					size_required += 1;
 					add_comma = true;
@@ -253,12 +500,14 @@ private:
 			}
 		}
 		flush_if_necessary(size_required);
-		if(add_newline) {
-			if(add_comma) {
-				*m_position++ = ',';
+		if(add_comma) {
+			*m_position++ = ',';
+		}
+		if constexpr(FormatT::pretty) {
+			if(add_newline) {
+				*m_position++ = '\n';
+				indent();
 			}
-			*m_position++ = '\n';
-			indent();
 		}
 	}
 
@@ -288,12 +537,19 @@ private:
 		std::uint8_t data;
 	};
 
-	static constexpr int buffer_size = 128;
+	void resume_aggregate(AggregateType type, bool has_elements) {
+		StackEntry e(type);
+		if(has_elements)
+			e.set_nonempty();
+		m_agg_stack.push(e);
+	}
 
-	char m_buffer[buffer_size];
+	StreamT& m_stream;
+	std::unique_ptr<char[]> m_buffer;
+	int m_buffer_size;
 	char* m_position;
 	std::stack<StackEntry, std::vector<StackEntry>> m_agg_stack;
-	StreamT& m_stream;
+	int m_uncaught_exceptions; // when constructed
 };
 
 } // namespace Om
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+
+namespace Om {
+
+enum class JSONToken : std::uint8_t {
+	begin_object,
+	end_object,
+	begin_array,
+	end_array,
+	key,
+	string,
+	number,
+	boolean,
+	null,
+	end_of_input
+};
+
+// Pull parser that reads one token at a time, memory use is bounded by the
+// largest single string. Separators are not validated, the input is
+// expected to be well formed JSON as written by JSONOutStream.
+template<typename StreamT>
+class JSONInStream {
+public:
+	JSONInStream(StreamT& underlying, std::size_t buffer_size = 64 * 1024) :
+		m_stream { underlying },
+		m_buffer { std::make_unique<char[]>(buffer_size) },
+		m_buffer_size { buffer_size } {
+	}
+
+	JSONInStream(JSONInStream const&) = delete;
+	JSONInStream& operator=(JSONInStream const&) = delete;
+
+	JSONToken next() {
+		for(;;) {
+			int const c = get();
+			switch(c) {
+			case ' ':
+			case '\t':
+			case '\n':
+			case '\r':
+			case ':':
+				break;
+			case ',':
+				m_expect_key = !m_is_object.empty() && m_is_object.back();
+				break;
+			case '{':
+				m_is_object.push_back(true);
+				m_expect_key = true;
+				return m_token = JSONToken::begin_object;
+			case '}':
+				pop_aggregate(true);
+				return m_token = JSONToken::end_object;
+			case '[':
+				m_is_object.push_back(false);
+				m_expect_key = false;
+				return m_token = JSONToken::begin_array;
+			case ']':
+				pop_aggregate(false);
+				return m_token = JSONToken::end_array;
+			case '"':
+				read_string();
+				if(m_expect_key) {
+					// keep the key around while its value is read
+					m_key.swap(m_string);
+					m_expect_key = false;
+					return m_token = JSONToken::key;
+				}
+				return m_token = JSONToken::string;
+			case eof:
+				return m_token = JSONToken::end_of_input;
+			default:
+				if(c == '-' || (c >= '0' && c <= '9')) {
+					read_while(c, [](int ch) {
+						return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+					});
+					return m_token = JSONToken::number;
+				}
+				read_while(c, [](int ch) { return ch >= 'a' && ch <= 'z'; });
+				if(m_string == "true" || m_string == "false")
+					return m_token = JSONToken::boolean;
+				if(m_string == "null")
+					return m_token = JSONToken::null;
+				throw std::runtime_error { "Invalid JSON!" };
+			}
+		}
+	}
+
+	JSONToken token() const noexcept {
+		return m_token;
+	}
+
+	// unescaped text of the last key, valid until the next key is read
+	std::string_view key() const noexcept {
+		return m_key;
+	}
+
+	// unescaped text of the last string, or the text of a number or literal
+	std::string_view string() const noexcept {
+		return m_string;
+	}
+
+	template<typename T>
+	T number() const {
+		static_assert(std::is_integral_v<T>, "only integers are supported");
+		if(m_token != JSONToken::number)
+			throw std::runtime_error { "Expected a number!" };
+		T value {};
+		auto const result = std::from_chars(m_string.data(), m_string.data() + m_string.size(), value);
+		if(result.ec != std::errc() || result.ptr != m_string.data() + m_string.size())
+			throw std::runtime_error { "Invalid number!" };
+		return value;
+	}
+
+	// skips the value that follows a key or starts with the last token
+	void skip_value() {
+		if(m_token == JSONToken::key)
+			next();
+		int depth = 0;
+		for(;;) {
+			switch(m_token) {
+			case JSONToken::begin_object:
+			case JSONToken::begin_array:
+				++depth;
+				break;
+			case JSONToken::end_object:
+			case JSONToken::end_array:
+				--depth;
+				break;
+			case JSONToken::end_of_input:
+				throw std::runtime_error { "Unexpected end of JSON!" };
+			default:
+				break;
+			}
+			if(depth == 0)
+				return;
+			next();
+		}
+	}
+
+private:
+	static constexpr int eof = -1;
+
+	int get() {
+		if(m_position == m_end && !refill())
+			return eof;
+		return static_cast<unsigned char>(*m_position++);
+	}
+
+	bool refill() {
+		m_position = m_buffer.get();
+		m_end = m_position + m_stream.read(m_buffer.get(), m_buffer_size);
+		return m_position != m_end;
+	}
+
+	void pop_aggregate(bool is_object) {
+		if(m_is_object.empty() || m_is_object.back() != is_object)
+			throw std::runtime_error { "Invalid JSON!" };
+		m_is_object.pop_back();
+		m_expect_key = false;
+	}
+
+	template<typename Pred>
+	void read_while(int c, Pred pred) {
+		m_string.clear();
+		m_string.push_back(static_cast<char>(c));
+		for(;;) {
+			if(m_position == m_end && !refill())
+				return;
+			if(!pred(static_cast<unsigned char>(*m_position)))
+				return;
+			m_string.push_back(*m_position++);
+		}
+	}
+
+	void read_string() {
+		m_string.clear();
+		for(;;) {
+			// copy everything up to the next quote or escape at once
+			char const* p = m_position;
+			while(p != m_end && *p != '"' && *p != '\\') {
+				++p;
+			}
+			m_string.append(m_position, p);
+			m_position = p;
+			int const c = get();
+			if(c == '"') {
+				return;
+			} else if(c == '\\') {
+				read_escape();
+			} else if(c == eof) {
+				throw std::runtime_error { "Unexpected end of JSON!" };
+			} else {
+				// the buffer ended in the middle of the string
+				m_string.push_back(static_cast<char>(c));
+			}
+		}
+	}
+
+	void read_escape() {
+		int const c = get();
+		switch(c) {
+		case '"':
+		case '\\':
+		case '/':
+			m_string.push_back(static_cast<char>(c));
+			break;
+		case 'b':
+			m_string.push_back('\b');
+			break;
+		case 'f':
+			m_string.push_back('\f');
+			break;
+		case 'n':
+			m_string.push_back('\n');
+			break;
+		case 'r':
+			m_string.push_back('\r');
+			break;
+		case 't':
+			m_string.push_back('\t');
+			break;
+		case 'u':
+		{
+			std::uint32_t cp = read_hex4();
+			if(cp >= 0xD800 && cp < 0xDC00) {
+				// high surrogate, combine with the following low surrogate
+				if(get() != '\\' || get() != 'u')
+					throw std::runtime_error { "Invalid surrogate pair in JSON string!" };
+				std::uint32_t const low = read_hex4();
+				if(low < 0xDC00 || low >= 0xE000)
+					throw std::runtime_error { "Invalid surrogate pair in JSON string!" };
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+			}
+			append_utf8(cp);
+			break;
+		}
+		default:
+			throw std::runtime_error { "Invalid escape sequence in JSON string!" };
+		}
+	}
+
+	std::uint32_t read_hex4() {
+		std::uint32_t value = 0;
+		for(int i = 0; i < 4; ++i) {
+			int const c = get();
+			value <<= 4;
+			if(c >= '0' && c <= '9')
+				value |= static_cast<std::uint32_t>(c - '0');
+			else if(c >= 'a' && c <= 'f')
+				value |= static_cast<std::uint32_t>(c - 'a' + 10);
+			else if(c >= 'A' && c <= 'F')
+				value |= static_cast<std::uint32_t>(c - 'A' + 10);
+			else
+				throw std::runtime_error { "Invalid escape sequence in JSON string!" };
+		}
+		return value;
+	}
+
+	void append_utf8(std::uint32_t cp) {
+		if(cp < 0x80) {
+			m_string.push_back(static_cast<char>(cp));
+		} else if(cp < 0x800) {
+			m_string.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+			m_string.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		} else if(cp < 0x10000) {
+			m_string.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+			m_string.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			m_string.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		} else {
+			m_string.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+			m_string.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+			m_string.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+			m_string.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+		}
+	}
+
+	StreamT& m_stream;
+	std::unique_ptr<char[]> m_buffer;
+	std::size_t m_buffer_size;
+	char const* m_position = nullptr;
+	char const* m_end = nullptr;
+	std::string m_string;
+	std::string m_key;
+	std::vector<bool> m_is_object;
+	bool m_expect_key = false;
+	JSONToken m_token = JSONToken::end_of_input;
+};
+
+} // namespace Om
@@ -0,0 +1,517 @@
+#pragma once
+
+#include "flp_out_stream.h"
+#include "flp_utf_conversions.h"
+
+#include "cfile.h"
+#include "json_reader.h"
+#include "version.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+
+namespace Om {
+
+namespace detail {
+
+	[[noreturn]]
+	inline void invalid_flp_json(char const* what) {
+		throw std::runtime_error(std::string("Invalid FLP JSON: ") + what);
+	}
+
+	template<typename JSONStream>
+	void expect_token(JSONStream& json, JSONToken token, char const* what) {
+		if(json.next() != token)
+			invalid_flp_json(what);
+	}
+
+	inline FLPFormat header_format_from_name(std::string_view name) {
+		static constexpr FLPFormat formats[] = {
+			FLPFormat::FLP_Format_None,
+			FLPFormat::FLP_Format_Song,
+			FLPFormat::FLP_Format_Score,
+			FLPFormat::FLP_Format_Auto,
+			FLPFormat::FLP_Format_ChanState,
+			FLPFormat::FLP_Format_PlugState,
+			FLPFormat::FLP_Format_PlugState_Gen,
+			FLPFormat::FLP_Format_PlugState_FX,
+			FLPFormat::FLP_Format_MixerState,
+			FLPFormat::FLP_Format_Patcher,
+		};
+		for(FLPFormat format : formats) {
+			if(name == header_format_name(format))
+				return format;
+		}
+		invalid_flp_json("unknown header format");
+	}
+
+	template<typename JSONStream>
+	FLPFileHeader read_flp_header(JSONStream& json) {
+		FLPFileHeader header {};
+		expect_token(json, JSONToken::begin_object, "header is not an object");
+		while(json.next() == JSONToken::key) {
+			std::string_view const key = json.key();
+			if(key == "format") {
+				expect_token(json, JSONToken::string, "format is not a string");
+				header.Format = header_format_from_name(json.string());
+			} else if(key == "n_channels") {
+				json.next();
+				header.nChannels = json.template number<std::uint16_t>();
+			} else if(key == "ppq") {
+				json.next();
+				header.BeatDiv = json.template number<std::uint16_t>();
+			} else {
+				json.skip_value();
+			}
+		}
+		if(json.token() != JSONToken::end_object)
+			invalid_flp_json("header is not an object");
+		return header;
+	}
+
+	inline int hex_digit_value(char c) noexcept {
+		if(c >= '0' && c <= '9')
+			return c - '0';
+		if(c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		if(c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		return -1;
+	}
+
+	inline void decode_hex_bytes(std::string_view hex, std::vector<std::byte>& out) {
+		// "XX XX XX", see stream_bytes
+		out.reserve((hex.size() + 1) / 3);
+		for(std::size_t i = 0; i < hex.size(); i += 3) {
+			int const hi = hex_digit_value(hex[i]);
+			int const lo = i + 1 < hex.size() ? hex_digit_value(hex[i + 1]) : -1;
+			if(hi < 0 || lo < 0 || (i + 2 < hex.size() && hex[i + 2] != ' '))
+				invalid_flp_json("invalid hex data");
+			out.push_back(static_cast<std::byte>(hi << 4 | lo));
+		}
+	}
+
+	inline int base64_digit_value(char c) noexcept {
+		if(c >= 'A' && c <= 'Z')
+			return c - 'A';
+		if(c >= 'a' && c <= 'z')
+			return c - 'a' + 26;
+		if(c >= '0' && c <= '9')
+			return c - '0' + 52;
+		if(c == '+')
+			return 62;
+		if(c == '/')
+			return 63;
+		return -1;
+	}
+
+	inline void decode_base64_bytes(std::string_view base64, std::vector<std::byte>& out) {
+		if(base64.size() % 4 != 0)
+			invalid_flp_json("invalid base64 data");
+		out.reserve(base64.size() / 4 * 3);
+		for(std::size_t i = 0; i < base64.size(); i += 4) {
+			bool const is_last = i + 4 == base64.size();
+			// padding is only allowed at the end
+			std::size_t const n_padding = !is_last ? 0 : base64[i + 3] != '=' ? 0 : base64[i + 2] != '=' ? 1 : 2;
+			std::uint32_t bits = 0;
+			for(std::size_t j = 0; j < 4; ++j) {
+				int const digit = j < 4 - n_padding ? base64_digit_value(base64[i + j]) : 0;
+				if(digit < 0)
+					invalid_flp_json("invalid base64 data");
+				bits = bits << 6 | static_cast<std::uint32_t>(digit);
+			}
+			out.push_back(static_cast<std::byte>(bits >> 16));
+			if(n_padding < 2)
+				out.push_back(static_cast<std::byte>(bits >> 8));
+			if(n_padding < 1)
+				out.push_back(static_cast<std::byte>(bits));
+		}
+	}
+
+	template<typename T>
+	void append_record(std::vector<std::byte>& out, T const& record) {
+		auto const* p = reinterpret_cast<std::byte const*>(&record);
+		out.insert(out.end(), p, p + sizeof(T));
+	}
+
+	// reads arrays of bytes as written for the data1/data2 fields of playlist
+	// clips, the opening bracket was already read
+	template<typename JSONStream, std::size_t N>
+	void read_byte_array(JSONStream& json, std::byte (&target)[N]) {
+		if(json.token() != JSONToken::begin_array)
+			invalid_flp_json("expected an array");
+		std::size_t i = 0;
+		while(json.next() == JSONToken::number) {
+			if(i == N)
+				invalid_flp_json("array too long");
+			target[i++] = std::byte { json.template number<std::uint8_t>() };
+		}
+		if(json.token() != JSONToken::end_array)
+			invalid_flp_json("expected an array");
+	}
+
+	// A field of a pattern note or playlist clip. read is called with the
+	// first token of the value already read.
+	template<typename JSONStream, typename Record>
+	struct RecordField {
+		std::string_view name;
+		void (*read)(JSONStream& json, Record& record);
+	};
+
+	template<typename JSONStream>
+	constexpr RecordField<JSONStream, FLPPatternNoteRecord> pattern_note_fields[] = {
+		{ "position",     [](JSONStream& json, FLPPatternNoteRecord& n) { n.position = json.template number<std::uint32_t>(); } },
+		{ "flags",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.flags = json.template number<std::uint16_t>(); } },
+		{ "rack_channel", [](JSONStream& json, FLPPatternNoteRecord& n) { n.rack_channel = json.template number<std::uint16_t>(); } },
+		{ "length",       [](JSONStream& json, FLPPatternNoteRecord& n) { n.length = json.template number<std::uint32_t>(); } },
+		{ "key",          [](JSONStream& json, FLPPatternNoteRecord& n) { n.key = json.template number<std::uint8_t>(); } },
+		{ "data0",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.data0 = std::byte { json.template number<std::uint8_t>() }; } },
+		{ "group",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.group_id = json.template number<std::uint8_t>(); } },
+		{ "data1",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.data1 = std::byte { json.template number<std::uint8_t>() }; } },
+		{ "fine_pitch",   [](JSONStream& json, FLPPatternNoteRecord& n) { n.fine_pitch = json.template number<std::uint8_t>(); } },
+		{ "data2",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.data2 = std::byte { json.template number<std::uint8_t>() }; } },
+		{ "release",      [](JSONStream& json, FLPPatternNoteRecord& n) { n.release = json.template number<std::uint8_t>(); } },
+		// flags2 and midi_channel share a byte
+		{ "flags2",       [](JSONStream& json, FLPPatternNoteRecord& n) {
+			n.midi_channel = static_cast<std::uint8_t>((json.template number<std::uint8_t>() << 4) | (n.midi_channel & 0x0F));
+		} },
+		{ "midi_channel", [](JSONStream& json, FLPPatternNoteRecord& n) {
+			n.midi_channel = static_cast<std::uint8_t>((n.midi_channel & 0xF0) | (json.template number<std::uint8_t>() & 0x0F));
+		} },
+		{ "pan",          [](JSONStream& json, FLPPatternNoteRecord& n) { n.pan = json.template number<std::uint8_t>(); } },
+		{ "velocity",     [](JSONStream& json, FLPPatternNoteRecord& n) { n.velocity = json.template number<std::uint8_t>(); } },
+		{ "mod_x",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.mod_x = json.template number<std::uint8_t>(); } },
+		{ "mod_y",        [](JSONStream& json, FLPPatternNoteRecord& n) { n.mod_y = json.template number<std::uint8_t>(); } },
+	};
+
+	template<typename JSONStream>
+	constexpr RecordField<JSONStream, FLPPlaylistClipRecord> playlist_clip_fields[] = {
+		{ "position",     [](JSONStream& json, FLPPlaylistClipRecord& c) { c.position = json.template number<std::uint32_t>(); } },
+		{ "data0",        [](JSONStream& json, FLPPlaylistClipRecord& c) { c.data0 = json.template number<std::uint16_t>(); } },
+		{ "source_index", [](JSONStream& json, FLPPlaylistClipRecord& c) { c.source_index = json.template number<std::uint16_t>(); } },
+		{ "duration",     [](JSONStream& json, FLPPlaylistClipRecord& c) { c.duration = json.template number<std::uint32_t>(); } },
+		{ "lane_index",   [](JSONStream& json, FLPPlaylistClipRecord& c) { c.lane_index = json.template number<std::uint16_t>(); } },
+		{ "group",        [](JSONStream& json, FLPPlaylistClipRecord& c) { c.group = json.template number<std::uint8_t>(); } },
+		{ "data1",        [](JSONStream& json, FLPPlaylistClipRecord& c) { read_byte_array(json, c.data1); } },
+		{ "flags",        [](JSONStream& json, FLPPlaylistClipRecord& c) { c.flags = std::byte { json.template number<std::uint8_t>() }; } },
+		{ "data2",        [](JSONStream& json, FLPPlaylistClipRecord& c) { read_byte_array(json, c.data2); } },
+		{ "window_start", [](JSONStream& json, FLPPlaylistClipRecord& c) { c.window_start = json.template number<std::int32_t>(); } },
+		{ "window_end",   [](JSONStream& json, FLPPlaylistClipRecord& c) { c.window_end = json.template number<std::int32_t>(); } },
+	};
+
+	// nullptr for unknown fields
+	template<typename JSONStream, typename Record, std::size_t N>
+	auto find_record_field(RecordField<JSONStream, Record> const (&fields)[N], std::string_view name) {
+		for(auto const& field : fields) {
+			if(field.name == name)
+				return field.read;
+		}
+		return static_cast<void (*)(JSONStream&, Record&)>(nullptr);
+	}
+
+	// [{ "position": x, "key": y, ... }, ...], the opening bracket was already read
+	template<typename Record, typename JSONStream, std::size_t N>
+	void read_record_rows(JSONStream& json, RecordField<JSONStream, Record> const (&fields)[N], std::vector<std::byte>& out) {
+		while(json.next() == JSONToken::begin_object) {
+			Record record {};
+			while(json.next() == JSONToken::key) {
+				if(auto const read_field = find_record_field(fields, json.key())) {
+					json.next();
+					read_field(json, record);
+				} else {
+					json.skip_value();
+				}
+			}
+			if(json.token() != JSONToken::end_object)
+				invalid_flp_json("record is not an object");
+			append_record(out, record);
+		}
+		if(json.token() != JSONToken::end_array)
+			invalid_flp_json("records are not an array");
+	}
+
+	// { "position": [...], "key": [...], ... } with all arrays in record order,
+	// the opening brace was already read
+	template<typename Record, typename JSONStream, std::size_t N>
+	void read_record_columns(JSONStream& json, RecordField<JSONStream, Record> const (&fields)[N], std::vector<std::byte>& out) {
+		std::size_t n_records = 0;
+		bool has_columns = false;
+		while(json.next() == JSONToken::key) {
+			auto const read_field = find_record_field(fields, json.key());
+			if(!read_field) {
+				json.skip_value();
+				continue;
+			}
+			expect_token(json, JSONToken::begin_array, "column is not an array");
+			std::size_t i = 0;
+			while(json.next() != JSONToken::end_array) {
+				if(json.token() == JSONToken::end_of_input)
+					invalid_flp_json("column is not an array");
+				if(i == n_records) {
+					if(has_columns)
+						invalid_flp_json("columns differ in length");
+					append_record(out, Record {});
+					++n_records;
+				}
+				// records are packed, so they can be accessed in place
+				read_field(json, *reinterpret_cast<Record*>(out.data() + i * sizeof(Record)));
+				++i;
+			}
+			if(i != n_records)
+				invalid_flp_json("columns differ in length");
+			has_columns = true;
+		}
+		if(json.token() != JSONToken::end_object)
+			invalid_flp_json("columns are not an object");
+	}
+
+	// an array of objects or, with "data_layout": "columns", an object of arrays
+	template<typename Record, typename JSONStream, std::size_t N>
+	void read_records(JSONStream& json, RecordField<JSONStream, Record> const (&fields)[N], std::vector<std::byte>& out) {
+		JSONToken const token = json.next();
+		if(token == JSONToken::begin_array)
+			read_record_rows(json, fields, out);
+		else if(token == JSONToken::begin_object)
+			read_record_columns(json, fields, out);
+		else
+			invalid_flp_json("records are neither an array nor an object");
+	}
+
+	template<typename JSONStream>
+	void read_fxrouting(JSONStream& json, std::vector<std::byte>& out, std::size_t data_size) {
+		// only the non-zero entries are written
+		out.assign(data_size, std::byte { 0 });
+		expect_token(json, JSONToken::begin_array, "fx routing is not an array");
+		while(json.next() == JSONToken::begin_object) {
+			std::size_t target = 0;
+			std::uint8_t value = 0;
+			while(json.next() == JSONToken::key) {
+				std::string_view const key = json.key();
+				json.next();
+				if(key == "target")
+					target = json.template number<std::size_t>();
+				else if(key == "value")
+					value = json.template number<std::uint8_t>();
+				else
+					json.skip_value();
+			}
+			if(target >= out.size())
+				out.resize(target + 1, std::byte { 0 });
+			out[target] = std::byte { value };
+		}
+		if(json.token() != JSONToken::end_array)
+			invalid_flp_json("fx routing is not an array");
+	}
+
+	// state carried from one event to the next
+	struct JSONEventReaderState {
+		std::vector<std::byte> payload;
+		std::u16string wide_string;
+		CFile sidecar;
+		bool found_version = false;
+		bool is_unicode = false;
+	};
+
+	// "data": { "offset": x, "length": n } of payloads in the sidecar file,
+	// the opening brace was already read
+	template<typename JSONStream>
+	void read_sidecar_data(JSONStream& json, JSONEventReaderState& state) {
+		std::uint64_t offset = 0;
+		std::size_t length = 0;
+		while(json.next() == JSONToken::key) {
+			std::string_view const key = json.key();
+			json.next();
+			if(key == "offset")
+				offset = json.template number<std::uint64_t>();
+			else if(key == "length")
+				length = json.template number<std::size_t>();
+			else
+				json.skip_value();
+		}
+		if(json.token() != JSONToken::end_object)
+			invalid_flp_json("sidecar data is not an object");
+		if(!state.sidecar.is_open())
+			invalid_flp_json("sidecar data without sidecar file");
+		if(offset > static_cast<std::uint64_t>(INT64_MAX) || !state.sidecar.seek(static_cast<std::int64_t>(offset)))
+			throw std::runtime_error { "Error reading sidecar file!" };
+		state.payload.resize(length);
+		if(state.sidecar.read(state.payload.data(), length) != length)
+			throw std::runtime_error { "Error reading sidecar file!" };
+	}
+
+	template<typename JSONStream>
+	void read_bytes_data(JSONStream& json, std::string_view data_encoding, JSONEventReaderState& state) {
+		JSONToken const token = json.next();
+		if(token == JSONToken::null)
+			return;
+		if(data_encoding == "sidecar") {
+			if(token != JSONToken::begin_object)
+				invalid_flp_json("sidecar data is not an object");
+			read_sidecar_data(json, state);
+			return;
+		}
+		if(token != JSONToken::string)
+			invalid_flp_json("bytes data is neither a string nor null");
+		if(data_encoding.empty() || data_encoding == "hex")
+			decode_hex_bytes(json.string(), state.payload);
+		else if(data_encoding == "base64")
+			decode_base64_bytes(json.string(), state.payload);
+		else
+			invalid_flp_json("unknown data encoding");
+	}
+
+	template<typename JSONStream>
+	void read_string_data(JSONStream& json, FLPEventType type, JSONEventReaderState& state) {
+		if(json.next() != JSONToken::string)
+			invalid_flp_json("string data is not a string");
+		std::string_view const str = json.string();
+		auto& payload = state.payload;
+		// FLP_Version is always an ANSI string, see stream_flp_event
+		if(state.is_unicode && type != FLPEventType::FLP_Version) {
+			if(std::error_code err = utf8_to_utf16(str, &state.wide_string))
+				throw std::system_error(err);
+			auto const* p = reinterpret_cast<std::byte const*>(state.wide_string.data());
+			payload.assign(p, p + state.wide_string.size() * sizeof(char16_t));
+			payload.insert(payload.end(), sizeof(char16_t), std::byte { 0 });
+		} else {
+			auto const* p = reinterpret_cast<std::byte const*>(str.data());
+			payload.assign(p, p + str.size());
+			payload.push_back(std::byte { 0 });
+		}
+	}
+
+	template<typename JSONStream>
+	void read_event_data(JSONStream& json, std::string_view data_type, std::string_view data_encoding,
+	                     std::size_t data_size, FLPEventView& e, JSONEventReaderState& state) {
+		auto& payload = state.payload;
+		if(data_type == "uint8") {
+			json.next();
+			e.u8 = json.template number<std::uint8_t>();
+		} else if(data_type == "int16") {
+			json.next();
+			e.i16 = json.template number<std::int16_t>();
+		} else if(data_type == "int32") {
+			json.next();
+			e.i32 = json.template number<std::int32_t>();
+		} else if(data_type == "string") {
+			read_string_data(json, e.type, state);
+		} else if(data_type == "bytes") {
+			read_bytes_data(json, data_encoding, state);
+		} else if(data_type == "pattern_note[]") {
+			read_records(json, pattern_note_fields<JSONStream>, payload);
+		} else if(data_type == "playlist_clip[]") {
+			read_records(json, playlist_clip_fields<JSONStream>, payload);
+		} else if(data_type == "fx_routing[]") {
+			read_fxrouting(json, payload, data_size);
+		} else {
+			invalid_flp_json("unknown data type");
+		}
+	}
+
+	// reads the members of one event object, returns false at the end of the events array
+	template<typename JSONStream, typename FLPStream>
+	bool read_flp_event(JSONStream& json, FLPStream& flp, JSONEventReaderState& state) {
+		JSONToken const token = json.next();
+		if(token == JSONToken::end_array)
+			return false;
+		if(token != JSONToken::begin_object)
+			invalid_flp_json("event is not an object");
+
+		FLPEventView e {};
+		bool has_id = false;
+		bool has_data = false;
+		std::string data_type;
+		std::string data_encoding;
+		std::size_t data_size = 0;
+		state.payload.clear();
+		while(json.next() == JSONToken::key) {
+			std::string_view const key = json.key();
+			if(key == "id") {
+				// "<id>/<name>"
+				expect_token(json, JSONToken::string, "id is not a string");
+				std::string_view const id = json.string();
+				unsigned id_value = 0;
+				auto const result = std::from_chars(id.data(), id.data() + id.size(), id_value);
+				if(result.ec != std::errc() || id_value > 255)
+					invalid_flp_json("invalid event id");
+				e.type = static_cast<FLPEventType>(id_value);
+				has_id = true;
+			} else if(key == "data_type") {
+				expect_token(json, JSONToken::string, "data_type is not a string");
+				data_type = json.string();
+			} else if(key == "data_encoding") {
+				expect_token(json, JSONToken::string, "data_encoding is not a string");
+				data_encoding = json.string();
+			} else if(key == "data_size") {
+				json.next();
+				data_size = json.template number<std::size_t>();
+			} else if(key == "data") {
+				if(!has_id || data_type.empty())
+					invalid_flp_json("data before id and data_type");
+				read_event_data(json, data_type, data_encoding, data_size, e, state);
+				has_data = true;
+			} else {
+				json.skip_value();
+			}
+		}
+		if(json.token() != JSONToken::end_object)
+			invalid_flp_json("event is not an object");
+		if(!has_data)
+			invalid_flp_json("event without data");
+
+		if(static_cast<std::uint8_t>(e.type) / 64 == 3)
+			e.data = state.payload;
+		flp.write_event(e);
+
+		if(!state.found_version && e.type == FLPEventType::FLP_Version) {
+			state.found_version = true;
+			state.payload.push_back(std::byte { 0 });
+			Version version(reinterpret_cast<char const*>(state.payload.data()));
+			state.is_unicode = version >= "12.0.0";
+		}
+		return true;
+	}
+}
+
+// Streams a JSON document as written by the converter into an flp file,
+// one event at a time. open_sidecar(std::string_view name) returns the
+// CFile with the payloads if the document names a sidecar file.
+template<typename JSONStream, typename FLPStream, typename OpenSidecar>
+void json_to_flp(JSONStream& json, FLPStream& flp, OpenSidecar open_sidecar) {
+	detail::expect_token(json, JSONToken::begin_object, "document is not an object");
+	detail::JSONEventReaderState state;
+	bool has_header = false;
+	while(json.next() == JSONToken::key) {
+		std::string_view const key = json.key();
+		if(key == "header") {
+			flp.write_headers(detail::read_flp_header(json));
+			has_header = true;
+		} else if(key == "sidecar") {
+			detail::expect_token(json, JSONToken::string, "sidecar is not a string");
+			state.sidecar = open_sidecar(json.string());
+			if(!state.sidecar.is_open())
+				throw std::runtime_error { "Could not open sidecar file!" };
+		} else if(key == "events") {
+			if(!has_header)
+				detail::invalid_flp_json("events before header");
+			detail::expect_token(json, JSONToken::begin_array, "events is not an array");
+			while(detail::read_flp_event(json, flp, state)) {
+			}
+		} else {
+			json.skip_value();
+		}
+	}
+	if(json.token() != JSONToken::end_object || !has_header)
+		detail::invalid_flp_json("document is not an object");
+	flp.finish();
+}
+
+} // namespace Om
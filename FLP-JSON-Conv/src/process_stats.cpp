@@ -0,0 +1,100 @@
+#include "process_stats.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+namespace {
+
+std::atomic<std::uint64_t> n_allocations { 0 };
+std::atomic<std::uint64_t> n_allocated_bytes { 0 };
+
+void* counted_malloc(std::size_t size) noexcept {
+	n_allocations.fetch_add(1, std::memory_order_relaxed);
+	n_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	// every allocation needs its own address, even an empty one
+	return std::malloc(size != 0 ? size : 1);
+}
+
+} // namespace
+
+// The aligned forms are left alone, they are paired with their own deletes.
+void* operator new(std::size_t size) {
+	if(void* p = counted_malloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	if(void* p = counted_malloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+	return counted_malloc(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+	return counted_malloc(size);
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::nothrow_t const&) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, std::nothrow_t const&) noexcept {
+	std::free(p);
+}
+
+namespace Om {
+
+AllocationStats allocation_stats() noexcept {
+	return { n_allocations.load(std::memory_order_relaxed), n_allocated_bytes.load(std::memory_order_relaxed) };
+}
+
+std::uint64_t peak_rss_bytes() noexcept {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if(!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)))
+		return 0;
+	return counters.PeakWorkingSetSize;
+#else
+	rusage usage;
+	if(::getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	return static_cast<std::uint64_t>(usage.ru_maxrss); // bytes
+#else
+	return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024; // KiB
+#endif
+#endif
+}
+
+} // namespace Om
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace Om {
+
+struct AllocationStats {
+	std::uint64_t count = 0;
+	std::uint64_t bytes = 0;
+};
+
+// Allocations made with operator new since the program started, counted by
+// the replacements of the global operator new in process_stats.cpp.
+AllocationStats allocation_stats() noexcept;
+
+// the largest resident set size of the process so far, 0 if unknown
+std::uint64_t peak_rss_bytes() noexcept;
+
+} // namespace Om
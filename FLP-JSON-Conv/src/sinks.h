@@ -0,0 +1,267 @@
+#pragma once
+
+#include "flp_stream.h"
+#include "json.h"
+#include "flp_trace.h"
+#include "spsc_queue.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+
+namespace Om {
+
+// output stream that collects everything written in memory
+class MemorySink {
+public:
+	void write(char const* data, std::size_t size) {
+		m_buffer.append(data, size);
+	}
+
+	std::string_view data() const noexcept {
+		return m_buffer;
+	}
+
+	void clear() noexcept {
+		m_buffer.clear();
+	}
+
+private:
+	std::string m_buffer;
+};
+
+// Writes to a file descriptor without another buffer in between, for
+// output that JSONOutStream already buffers. On POSIX systems writev()
+// writes several buffers with one system call.
+class FdSink {
+public:
+	// is_open() is false if the file could not be created
+	static FdSink open(std::filesystem::path const& path) noexcept {
+#ifdef _WIN32
+		return FdSink(::_wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE));
+#else
+		return FdSink(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666));
+#endif
+	}
+
+	FdSink() noexcept = default;
+
+	explicit FdSink(int fd) noexcept : m_fd { fd } { }
+
+	FdSink(FdSink const&) = delete;
+	FdSink& operator=(FdSink const&) = delete;
+
+	FdSink(FdSink&& other) noexcept :
+		m_fd { other.m_fd } {
+		other.m_fd = -1;
+	}
+
+	FdSink& operator=(FdSink&& other) noexcept {
+		if(this != &other) {
+			close();
+			m_fd = other.m_fd;
+			other.m_fd = -1;
+		}
+		return *this;
+	}
+
+	~FdSink() {
+		close();
+	}
+
+	bool is_open() const noexcept {
+		return m_fd >= 0;
+	}
+
+	void write(char const* data, std::size_t size) {
+		OM_TRACE_SPAN("write", "io");
+		while(size > 0) {
+#ifdef _WIN32
+			unsigned const chunk = size > INT_MAX ? INT_MAX : static_cast<unsigned>(size);
+			int const n = ::_write(m_fd, data, chunk);
+#else
+			ssize_t const n = ::write(m_fd, data, size);
+			// interrupted by a signal before anything was written
+			if(n < 0 && errno == EINTR)
+				continue;
+#endif
+			if(n <= 0)
+				failed_write();
+			data += n;
+			size -= static_cast<std::size_t>(n);
+		}
+	}
+
+	void writev(IOSlice const* slices, std::size_t n_slices) {
+		OM_TRACE_SPAN("writev", "io");
+#ifdef _WIN32
+		for(std::size_t i = 0; i < n_slices; ++i) {
+			write(slices[i].data, slices[i].size);
+		}
+#else
+		constexpr std::size_t max_slices = 16;
+		while(n_slices > 0) {
+			iovec iov[max_slices];
+			std::size_t const n_iov = n_slices < max_slices ? n_slices : max_slices;
+			std::size_t total = 0;
+			for(std::size_t i = 0; i < n_iov; ++i) {
+				iov[i].iov_base = const_cast<char*>(slices[i].data);
+				iov[i].iov_len = slices[i].size;
+				total += slices[i].size;
+			}
+			ssize_t const n = ::writev(m_fd, iov, static_cast<int>(n_iov));
+			if(n < 0 && errno == EINTR)
+				continue;
+			if(n < 0 || (n == 0 && total != 0))
+				failed_write();
+			// finish a partially written slice on its own
+			auto written = static_cast<std::size_t>(n);
+			std::size_t i = 0;
+			for(; i < n_iov && written >= slices[i].size; ++i) {
+				written -= slices[i].size;
+			}
+			if(i < n_iov) {
+				write(slices[i].data + written, slices[i].size - written);
+				++i;
+			}
+			slices += i;
+			n_slices -= i;
+		}
+#endif
+	}
+
+	void close() noexcept {
+		if(m_fd >= 0) {
+#ifdef _WIN32
+			::_close(m_fd);
+#else
+			::close(m_fd);
+#endif
+			m_fd = -1;
+		}
+	}
+
+private:
+	[[noreturn]]
+	static void failed_write() {
+		throw std::runtime_error { "Error writing output file!" };
+	}
+
+	int m_fd = -1;
+};
+
+// Hands every write to a thread that passes it on to sink, so that waiting
+// for the sink overlaps with producing the next output. Writes are copied
+// into one of n_blocks buffers, which bounds the data in flight. An error
+// of the sink is rethrown by the next write() or by finish().
+template<typename SinkT>
+class WriterThreadSink {
+public:
+	explicit WriterThreadSink(SinkT& sink, std::size_t n_blocks = 4) :
+		m_sink { sink },
+		m_blocks(n_blocks),
+		m_free_blocks(n_blocks),
+		m_full_blocks(n_blocks) {
+		for(std::vector<char>& block : m_blocks) {
+			m_free_blocks.push(&block);
+		}
+		m_thread = std::thread([this] { run(); });
+	}
+
+	WriterThreadSink(WriterThreadSink const&) = delete;
+	WriterThreadSink& operator=(WriterThreadSink const&) = delete;
+
+	// doesn't throw, call finish() to learn about errors
+	~WriterThreadSink() {
+		m_full_blocks.close();
+		if(m_thread.joinable())
+			m_thread.join();
+	}
+
+	void write(char const* data, std::size_t size) {
+		std::optional<std::vector<char>*> const block = m_free_blocks.pop();
+		if(!block)
+			failed_write();
+		(*block)->assign(data, data + size);
+		if(!m_full_blocks.push(*block))
+			failed_write();
+	}
+
+	// waits until everything is written
+	void finish() {
+		m_full_blocks.close();
+		if(m_thread.joinable())
+			m_thread.join();
+		if(m_error)
+			std::rethrow_exception(m_error);
+	}
+
+private:
+	void run() {
+		while(std::optional<std::vector<char>*> const block = m_full_blocks.pop()) {
+			try {
+				m_sink.write((*block)->data(), (*block)->size());
+			} catch(...) {
+				// the queues publish the error to write()
+				m_error = std::current_exception();
+				m_full_blocks.close();
+				m_free_blocks.close();
+				return;
+			}
+			m_free_blocks.push(*block);
+		}
+	}
+
+	[[noreturn]]
+	void failed_write() {
+		if(m_error)
+			std::rethrow_exception(m_error);
+		throw std::runtime_error { "Error writing output file!" };
+	}
+
+	SinkT& m_sink;
+	std::vector<std::vector<char>> m_blocks;
+	SPSCQueue<std::vector<char>*> m_free_blocks; // writer thread to producer
+	SPSCQueue<std::vector<char>*> m_full_blocks; // producer to writer thread
+	std::exception_ptr m_error;
+	std::thread m_thread;
+};
+
+// writes sidecar payloads to any of the sinks
+template<typename SinkT>
+class SidecarSink final : public FLPSidecarWriter {
+public:
+	explicit SidecarSink(SinkT& sink, std::uint64_t offset = 0) noexcept :
+		FLPSidecarWriter(offset),
+		m_sink { sink } {
+	}
+
+protected:
+	void write(std::byte const* data, std::size_t size) override {
+		m_sink.write(reinterpret_cast<char const*>(data), size);
+	}
+
+private:
+	SinkT& m_sink;
+};
+
+} // namespace Om
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace Om {
+
+// Bounded queue between one producer and one consumer thread. Pushing and
+// popping take no locks, a side only blocks (with atomic wait) while the
+// queue is full or empty. Either side may close() it: the producer to mark
+// the end, the consumer to cancel. Elements pushed before are still popped.
+template<typename T>
+class SPSCQueue {
+public:
+	explicit SPSCQueue(std::size_t capacity) :
+		m_slots(std::bit_ceil(capacity)),
+		m_mask { m_slots.size() - 1 } {
+		assert(capacity > 0);
+	}
+
+	SPSCQueue(SPSCQueue const&) = delete;
+	SPSCQueue& operator=(SPSCQueue const&) = delete;
+
+	// blocks while the queue is full, returns false if it was closed
+	bool push(T value) {
+		std::uint64_t const tail = index(m_tail.load(std::memory_order_relaxed));
+		for(;;) {
+			std::uint64_t const head = m_head.load(std::memory_order_acquire);
+			if(head & closed_bit)
+				return false;
+			if(tail - head < m_slots.size())
+				break;
+			m_head.wait(head, std::memory_order_acquire);
+		}
+		m_slots[tail & m_mask] = std::move(value);
+		m_tail.fetch_add(1, std::memory_order_release);
+		m_tail.notify_one();
+		return true;
+	}
+
+	// blocks while the queue is empty, nullopt once it is closed and empty
+	std::optional<T> pop() {
+		std::uint64_t const head = index(m_head.load(std::memory_order_relaxed));
+		for(;;) {
+			std::uint64_t const tail = m_tail.load(std::memory_order_acquire);
+			if(index(tail) != head)
+				break;
+			if(tail & closed_bit)
+				return std::nullopt;
+			m_tail.wait(tail, std::memory_order_acquire);
+		}
+		std::optional<T> value { std::move(m_slots[head & m_mask]) };
+		m_head.fetch_add(1, std::memory_order_release);
+		m_head.notify_one();
+		return value;
+	}
+
+	// The flag is part of both positions, so that a waiting side sees the
+	// value it waits on change. Positions are only changed by fetch_add,
+	// which keeps the flag.
+	void close() noexcept {
+		m_head.fetch_or(closed_bit);
+		m_tail.fetch_or(closed_bit);
+		m_head.notify_all();
+		m_tail.notify_all();
+	}
+
+private:
+	static constexpr std::uint64_t closed_bit = std::uint64_t(1) << 63;
+
+	static std::uint64_t index(std::uint64_t position) noexcept {
+		return position & ~closed_bit;
+	}
+
+	std::vector<T> m_slots;
+	std::size_t m_mask;
+	// on separate cache lines, each is written by one side
+	alignas(64) std::atomic<std::uint64_t> m_head { 0 };
+	alignas(64) std::atomic<std::uint64_t> m_tail { 0 };
+};
+
+} // namespace Om
@@ -61,6 +61,9 @@ CharT* is_switch(CharT* s) {
 	if(result == nullptr) {
 		result = matches_prefix(s, PrsOpt::short_prefix);
 	}
+	// a lone prefix is an argument, "-" commonly stands for stdin or stdout
+	if(result != nullptr && *result == nulchar<std::remove_const_t<CharT>>())
+		return nullptr;
 	return result;
 }
 
@@ -1,15 +1,31 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <cstdio>
+#include <filesystem>
 #include <vector>
 #include <type_traits>
 
 
 namespace Om {
 
+// fopen for any path, on Windows paths outside of the ANSI code page need
+// the wide variant
+inline FILE* open_file(std::filesystem::path const& path, char const* mode) noexcept {
+#ifdef _WIN32
+	wchar_t wmode[8] {};
+	for(int i = 0; i < 7 && mode[i] != '\0'; ++i) {
+		wmode[i] = static_cast<wchar_t>(mode[i]);
+	}
+	return ::_wfopen(path.c_str(), wmode);
+#else
+	return std::fopen(path.c_str(), mode);
+#endif
+}
+
 class CFile {
-	FILE* file_ptr;
+	FILE* file_ptr = nullptr;
 
 public:
 	static CFile open(char const* filename, char const* mode) noexcept {
@@ -80,6 +96,25 @@ public:
 		}
 	}
 
+	// position from the start of the file, negative on error
+	std::int64_t tell() const noexcept {
+		assert(file_ptr != nullptr);
+#ifdef _WIN32
+		return _ftelli64(file_ptr);
+#else
+		return ftello(file_ptr);
+#endif
+	}
+
+	bool seek(std::int64_t pos) noexcept {
+		assert(file_ptr != nullptr);
+#ifdef _WIN32
+		return _fseeki64(file_ptr, pos, SEEK_SET) == 0;
+#else
+		return fseeko(file_ptr, pos, SEEK_SET) == 0;
+#endif
+	}
+
 	FILE* fptr() const noexcept {
 		return file_ptr;
 	}
@@ -2,11 +2,39 @@
 
 #include "flp_enums.h"
 
+#include <cstring>       // memcpy
 #include <memory>        // unique_ptr
+#include <span>          // span
 
 
 namespace Om {
 
+// event that does not own its payload, for variable size events data points
+// into memory owned by the stream that produced the event
+struct FLPEventView {
+	FLPEventType type;
+	union {
+		std::uint8_t u8;
+		std::int16_t i16;
+		std::int32_t i32;
+	};
+	std::span<std::byte const> data;
+
+	FLPEventView const& view() const noexcept {
+		return *this;
+	}
+};
+
+// payloads read into a FLPPayloadArena are not owned by their event
+struct FLPPayloadDeleter {
+	bool owning = true;
+
+	void operator()(std::byte const* p) const noexcept {
+		if(owning)
+			delete[] p;
+	}
+};
+
 struct FLPEvent {
 	FLPEventType type;
 	union {
@@ -15,7 +43,40 @@ struct FLPEvent {
 		std::int32_t i32;
 		std::size_t var_size; // size of text_data in bytes
 	};
-	std::unique_ptr<std::byte const[]> text_data;
+	std::unique_ptr<std::byte const[], FLPPayloadDeleter> text_data;
+
+	bool owns_payload() const noexcept {
+		return text_data.get_deleter().owning;
+	}
+
+	// copy of the payload of a variable size event that outlives the
+	// stream and its arena
+	std::unique_ptr<std::byte[]> copy_payload() const {
+		auto copy = std::make_unique_for_overwrite<std::byte[]>(var_size);
+		if(var_size != 0)
+			std::memcpy(copy.get(), text_data.get(), var_size);
+		return copy;
+	}
+
+	FLPEventView view() const noexcept {
+		FLPEventView v {};
+		v.type = type;
+		switch(static_cast<std::uint8_t>(type) / 64) {
+		case 0:
+			v.u8 = u8;
+			break;
+		case 1:
+			v.i16 = i16;
+			break;
+		case 2:
+			v.i32 = i32;
+			break;
+		case 3:
+			v.data = { text_data.get(), var_size };
+			break;
+		}
+		return v;
+	}
 };
 
 #pragma pack(push, 1)
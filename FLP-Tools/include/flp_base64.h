@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>       // byte, size_t
+#include <span>          // span
+
+
+namespace Om {
+
+// Length of data encoded as padded base64 (RFC 4648).
+constexpr std::size_t base64_length(std::size_t n_bytes) noexcept {
+	return (n_bytes + 2) / 3 * 4;
+}
+
+// Writes the chars [first_char, first_char + n_chars) of data encoded as
+// padded base64, so long payloads can be encoded piece by piece.
+void base64_encode(std::span<std::byte const> data, std::size_t first_char,
+                   std::size_t n_chars, char* out) noexcept;
+
+}
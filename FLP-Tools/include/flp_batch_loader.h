@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>       // byte, size_t
+#include <cstdint>       // SIZE_MAX
+#include <filesystem>    // path
+#include <memory>        // unique_ptr
+#include <optional>      // optional
+#include <span>          // span
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+#include <vector>        // vector
+
+
+namespace Om {
+
+enum class FileLoaderBackend {
+	automatic, // io_uring where available, pread otherwise
+	io_uring,  // Linux 5.6 and later, pread is used if it isn't available
+	pread      // a pool of threads with blocking reads
+};
+
+std::string_view file_loader_backend_name(FileLoaderBackend backend) noexcept;
+
+struct BatchFileLoaderOptions {
+	FileLoaderBackend backend = FileLoaderBackend::automatic;
+	// files being read or waiting to be taken
+	std::size_t max_files_in_flight = 32;
+	// bytes of those files, a larger file is still read while nothing else is
+	std::size_t max_bytes_in_flight = 64 * 1024 * 1024;
+	// Larger files aren't read but returned with errc::file_too_large, so
+	// the caller can map them and only touch the parts it parses.
+	std::size_t max_file_size = SIZE_MAX;
+};
+
+struct LoadedFile {
+	std::size_t index = 0; // of its path in the list given to the loader
+	std::unique_ptr<std::byte[]> data;
+	std::size_t size = 0;
+	std::error_code error; // the file could not be read if set
+
+	std::span<std::byte const> bytes() const noexcept {
+		return { data.get(), size };
+	}
+};
+
+// Reads whole files for batch jobs over many small files, where waiting for
+// open, read and close takes longer than parsing. Many files are read at
+// once, with io_uring on Linux or else by a pool of threads, and returned in
+// the order they complete:
+//   BatchFileLoader loader(paths);
+//   while(std::optional<LoadedFile> file = loader.next())
+//       FLPViewInStream flp(file->bytes());
+// Files are read whole, so a parser that skips most of a large file is
+// better off mapping it, see max_file_size. The files and bytes being read
+// or waiting to be taken are limited by the options, which bounds the
+// memory used.
+class BatchFileLoader {
+public:
+	explicit BatchFileLoader(std::vector<std::filesystem::path> paths, BatchFileLoaderOptions const& options = {});
+
+	// files that weren't taken yet are dropped
+	~BatchFileLoader();
+
+	BatchFileLoader(BatchFileLoader const&) = delete;
+	BatchFileLoader& operator=(BatchFileLoader const&) = delete;
+
+	// Blocks until the next file is loaded, nullopt once every file was
+	// returned. Can be called from several threads.
+	std::optional<LoadedFile> next();
+
+	// the backend in use, never automatic
+	FileLoaderBackend backend() const noexcept;
+
+private:
+	struct State;
+	std::unique_ptr<State> _state;
+};
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define OM_ARCH_X86 1
+#else
+#define OM_ARCH_X86 0
+#endif
+
+// functions using instructions that are only available on some CPUs are
+// compiled for those CPUs and are only called after checking cpu_features()
+#if defined(__GNUC__) || defined(__clang__)
+#define OM_TARGET(arch) __attribute__((target(arch)))
+#else
+#define OM_TARGET(arch)
+#endif
+
+
+namespace Om {
+
+struct CPUFeatures {
+	bool ssse3 = false;
+	bool avx2 = false;  // only set if the OS saves the ymm registers too
+};
+
+// detected once on first use
+CPUFeatures const& cpu_features() noexcept;
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "flp.h"
+
+#include <cstddef>       // size_t
+#include <cstdint>       // uint32_t, uint64_t
+#include <span>          // span
+#include <vector>        // vector
+
+
+namespace Om {
+
+// a[a_begin, a_end) was replaced by b[b_begin, b_end), one of the ranges is
+// empty for pure removals and insertions
+struct FLPDiffHunk {
+	std::uint32_t a_begin;
+	std::uint32_t a_end;
+	std::uint32_t b_begin;
+	std::uint32_t b_end;
+};
+
+// Aligns two sequences of hashes with Myers' O(ND) algorithm in linear
+// space. Sequences that differ a lot are split heuristically instead of
+// searching the shortest edit script, like GNU diff does, so the time stays
+// close to linear. Hunks are in order and don't touch each other.
+std::vector<FLPDiffHunk> diff_sequences(std::span<std::uint64_t const> a, std::span<std::uint64_t const> b);
+
+// hash of the type and the value or payload of an event
+std::uint64_t hash_event(FLPEventView const& e) noexcept;
+
+// hashes of the fixed size records of a FLP_PatNoteRecChan or FLP_PLRecChan
+// payload, a trailing partial record is hashed too
+std::vector<std::uint64_t> hash_records(std::span<std::byte const> data, std::size_t record_size);
+
+enum class FLPDiffKind : std::uint8_t {
+	removed,  // a_index is valid
+	inserted, // b_index is valid
+	changed   // both are valid
+};
+
+struct FLPRecordDiff {
+	FLPDiffKind kind;
+	std::uint32_t a_index;
+	std::uint32_t b_index;
+};
+
+struct FLPEventDiff {
+	FLPDiffKind kind;
+	std::uint32_t a_index;
+	std::uint32_t b_index;
+	// record level changes of changed pattern note and playlist events
+	std::vector<FLPRecordDiff> records;
+};
+
+// Changes between two event lists. Within a hunk removed and inserted
+// events of the same type are paired in order as changed events.
+std::vector<FLPEventDiff> diff_events(std::span<FLPEventView const> a, std::span<FLPEventView const> b);
+
+}
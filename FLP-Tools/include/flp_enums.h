@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <string_view>
 
 namespace Om {
 
@@ -210,5 +212,8 @@ inline char const* flp_event_name(FLPEventType event_type) noexcept {
 	return flp_event_name(static_cast<std::uint8_t>(event_type));
 }
 
+// inverse of flp_event_name
+std::optional<FLPEventType> flp_event_type_from_name(std::string_view name) noexcept;
+
 
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "flp_enums.h"
+
+#include <cstdint>       // uint64_t, uint8_t
+
+
+namespace Om {
+
+// Set of event types with one bit per event id. Input streams skip the
+// events that are not in their mask, variable size payloads are not even
+// read then.
+class FLPEventMask {
+public:
+	// no events
+	constexpr FLPEventMask() noexcept = default;
+
+	static constexpr FLPEventMask all() noexcept {
+		FLPEventMask mask;
+		for(std::uint64_t& word : mask._bits) {
+			word = ~std::uint64_t(0);
+		}
+		return mask;
+	}
+
+	constexpr FLPEventMask& set(FLPEventType type) noexcept {
+		auto const id = static_cast<std::uint8_t>(type);
+		_bits[id >> 6] |= std::uint64_t(1) << (id & 63);
+		return *this;
+	}
+
+	constexpr FLPEventMask& reset(FLPEventType type) noexcept {
+		auto const id = static_cast<std::uint8_t>(type);
+		_bits[id >> 6] &= ~(std::uint64_t(1) << (id & 63));
+		return *this;
+	}
+
+	constexpr bool test(FLPEventType type) const noexcept {
+		auto const id = static_cast<std::uint8_t>(type);
+		return (_bits[id >> 6] >> (id & 63)) & 1;
+	}
+
+	constexpr bool is_all() const noexcept {
+		return (_bits[0] & _bits[1] & _bits[2] & _bits[3]) == ~std::uint64_t(0);
+	}
+
+	constexpr bool is_empty() const noexcept {
+		return (_bits[0] | _bits[1] | _bits[2] | _bits[3]) == 0;
+	}
+
+	constexpr FLPEventMask& operator|=(FLPEventMask const& other) noexcept {
+		for(int i = 0; i < 4; ++i) {
+			_bits[i] |= other._bits[i];
+		}
+		return *this;
+	}
+
+	friend constexpr bool operator==(FLPEventMask const&, FLPEventMask const&) noexcept = default;
+
+private:
+	std::uint64_t _bits[4] {};
+};
+
+}
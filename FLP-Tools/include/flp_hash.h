@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>       // byte
+#include <cstdint>       // uint64_t
+#include <span>          // span
+
+
+namespace Om {
+
+// Fast non-cryptographic 64 bit hash of data, the XXH64 algorithm. Good
+// for telling whether file contents changed, not against tampering.
+std::uint64_t hash64(std::span<std::byte const> data, std::uint64_t seed = 0) noexcept;
+
+// CRC-32 of data as used by zip, pass the previous result as crc to
+// continue over several pieces.
+std::uint32_t crc32(std::span<std::byte const> data, std::uint32_t crc = 0) noexcept;
+
+}
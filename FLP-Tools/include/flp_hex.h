@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>       // byte, size_t
+#include <span>          // span
+
+
+namespace Om {
+
+struct CPUFeatures;
+
+// Length of data formatted as "XX XX XX", two upper case hex digits per
+// byte separated by spaces.
+constexpr std::size_t hex_spaced_length(std::size_t n_bytes) noexcept {
+	return n_bytes == 0 ? 0 : n_bytes * 3 - 1;
+}
+
+// Writes the chars [first_char, first_char + n_chars) of data formatted as
+// "XX XX XX", so long payloads can be encoded piece by piece into a fixed
+// size buffer. Uses SSSE3 or AVX2 if the CPU supports them.
+void hex_encode_spaced(std::span<std::byte const> data, std::size_t first_char,
+                       std::size_t n_chars, char* out) noexcept;
+
+// The same with the kernel that features selects, which must be a subset of
+// cpu_features(). Lets the SIMD kernels be checked against the scalar one.
+void hex_encode_spaced(std::span<std::byte const> data, std::size_t first_char,
+                       std::size_t n_chars, char* out, CPUFeatures const& features) noexcept;
+
+}
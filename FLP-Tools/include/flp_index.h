@@ -0,0 +1,195 @@
+#pragma once
+
+#include "flp.h"
+#include "flp_event_mask.h"
+#include "flp_mapped_file.h"
+
+#include <cstddef>       // byte, size_t
+#include <cstdint>       // uint8_t, uint32_t, uint64_t
+#include <filesystem>    // path
+#include <optional>      // optional
+#include <span>          // span
+#include <string>        // string
+#include <string_view>   // string_view
+#include <system_error>  // error_code
+#include <unordered_map> // unordered_map
+#include <vector>        // vector
+
+
+namespace Om {
+
+// What an index term was found in.
+enum class FLPIndexField : std::uint8_t {
+	plugin,       // FLP_Text_DefPluginName, the plugin itself, like "Sytrus"
+	plugin_name,  // FLP_Text_PluginName, the name given in the project
+	sample,       // file name of FLP_Text_SampleFileName
+	sample_path,  // FLP_Text_SampleFileName as stored
+	author,       // FLP_Text_Author
+	genre,        // FLP_Text_Genre
+	version       // FLP_Version
+};
+
+constexpr std::size_t flp_index_n_fields = 7;
+
+std::string_view index_field_name(FLPIndexField field) noexcept;
+std::optional<FLPIndexField> index_field_from_name(std::string_view name) noexcept;
+
+struct FLPIndexTerm {
+	FLPIndexField field;
+	std::string text;   // UTF-8 for FL 12 and later, as stored (ANSI) before
+
+	friend bool operator==(FLPIndexTerm const&, FLPIndexTerm const&) = default;
+};
+
+// Collects the distinct index terms of one project from its events.
+class FLPIndexTermCollector {
+public:
+	// the events terms are taken from, input streams can skip the others
+	static FLPEventMask event_mask() noexcept;
+
+	void add_event(FLPEventView const& e);
+
+	void add_event(FLPEvent const& e) {
+		add_event(e.view());
+	}
+
+	// sorted, without duplicates
+	std::vector<FLPIndexTerm> finish();
+
+private:
+	void add_term(FLPIndexField field, FLPEventView const& e);
+
+	std::vector<FLPIndexTerm> _terms;
+	int _major_version = 0;
+};
+
+template<typename FLPStreamT>
+std::vector<FLPIndexTerm> collect_index_terms(FLPStreamT& flp) {
+	flp.set_event_mask(FLPIndexTermCollector::event_mask());
+	FLPIndexTermCollector collector;
+	for(; flp.has_event(); ++flp) {
+		collector.add_event(*flp);
+	}
+	return collector.finish();
+}
+
+// On disk layout of an index, little endian. All sections start at a
+// multiple of 8 so the mapped file can be used in place.
+//
+//   FLPIndexHeader
+//   FLPIndexDocument[n_documents]
+//   FLPIndexTermEntry[n_terms]   sorted by field, then by folded text
+//   postings                     per term the ascending document ids, delta
+//                                and LEB128 encoded
+//   strings                      paths and term texts, UTF-8 where known
+namespace detail {
+	constexpr char flp_index_magic[4] = { 'F', 'L', 'P', 'X' };
+}
+
+constexpr std::uint32_t flp_index_format_version = 1;
+
+struct FLPIndexHeader {
+	char magic[4];
+	std::uint32_t format_version;
+	std::uint32_t n_documents;
+	std::uint32_t n_terms;
+	std::uint64_t documents_offset;
+	std::uint64_t terms_offset;
+	std::uint64_t postings_offset;
+	std::uint64_t strings_offset;
+	std::uint64_t file_size;
+};
+static_assert(sizeof(FLPIndexHeader) == 56);
+
+struct FLPIndexDocument {
+	std::uint32_t path_offset;    // into strings
+	std::uint32_t path_length;
+};
+static_assert(sizeof(FLPIndexDocument) == 8);
+
+struct FLPIndexTermEntry {
+	FLPIndexField field;
+	std::uint8_t reserved[3];
+	std::uint32_t text_offset;    // into strings
+	std::uint32_t text_length;
+	std::uint32_t n_documents;
+	std::uint64_t postings_offset; // into postings
+};
+static_assert(sizeof(FLPIndexTermEntry) == 24);
+
+// Terms are looked up ignoring ASCII case, "sytrus" finds "Sytrus".
+int compare_index_text(std::string_view a, std::string_view b) noexcept;
+
+// Gathers documents and their terms and serializes the index.
+class FLPIndexWriter {
+public:
+	// returns the document id, ids are given in the order of the calls
+	std::uint32_t add_document(std::string_view path, std::span<FLPIndexTerm const> terms);
+
+	std::vector<std::byte> serialize() const;
+
+private:
+	struct Term {
+		FLPIndexField field;
+		std::uint32_t text_offset;
+		std::uint32_t text_length;
+		std::vector<std::uint32_t> documents;
+	};
+
+	std::uint32_t add_string(std::string_view str);
+
+	std::string _strings;
+	std::vector<FLPIndexDocument> _documents;
+	std::vector<Term> _terms;
+	// per field the term indexes by exact text
+	std::unordered_map<std::string, std::uint32_t> _term_lookup[flp_index_n_fields];
+};
+
+// Read-only view of an index file, queries don't copy or allocate except
+// for the decoded document ids.
+class FLPIndex {
+public:
+	// the error of reading the file, or an flp_index error if it is not a
+	// valid index
+	std::error_code open(std::filesystem::path const& path);
+
+	std::uint32_t n_documents() const noexcept {
+		return static_cast<std::uint32_t>(_documents.size());
+	}
+
+	std::string_view document_path(std::uint32_t document) const noexcept {
+		FLPIndexDocument const& d = _documents[document];
+		return string(d.path_offset, d.path_length);
+	}
+
+	std::span<FLPIndexTermEntry const> terms() const noexcept {
+		return _terms;
+	}
+
+	// terms of one field
+	std::span<FLPIndexTermEntry const> terms(FLPIndexField field) const noexcept;
+
+	// terms equal to text, or starting with it if is_prefix, ignoring ASCII case
+	std::span<FLPIndexTermEntry const> find(FLPIndexField field, std::string_view text, bool is_prefix) const noexcept;
+
+	std::string_view text(FLPIndexTermEntry const& term) const noexcept {
+		return string(term.text_offset, term.text_length);
+	}
+
+	// appends the ascending ids of the documents containing term, throws
+	// std::runtime_error if the postings are damaged
+	void postings(FLPIndexTermEntry const& term, std::vector<std::uint32_t>* documents) const;
+
+private:
+	std::string_view string(std::uint32_t offset, std::uint32_t length) const noexcept {
+		return std::string_view(_strings).substr(offset, length);
+	}
+
+	MappedFile _file;
+	std::span<FLPIndexDocument const> _documents;
+	std::span<FLPIndexTermEntry const> _terms;
+	std::span<std::byte const> _postings;
+	std::string_view _strings;
+};
+
+}
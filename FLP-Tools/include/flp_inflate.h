@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>       // byte, size_t
+#include <cstdint>       // uint8_t, uint32_t, uint64_t
+#include <memory>        // unique_ptr
+#include <span>          // span
+#include <vector>        // vector
+
+
+namespace Om {
+
+namespace detail {
+
+	// two level lookup table of a Huffman code, indexed by the next input bits
+	struct HuffmanTable {
+		std::vector<std::uint32_t> entries;
+		unsigned primary_bits = 0;
+	};
+}
+
+// Streaming decoder of raw deflate data (RFC 1951), the compression of zip
+// entries. The compressed input is in memory, the output is decoded on
+// demand into a 64 KiB window so that the whole entry never has to be held
+// at once.
+class Inflater {
+public:
+	explicit Inflater(std::span<std::byte const> input);
+
+	Inflater(Inflater const&) = delete;
+	Inflater& operator=(Inflater const&) = delete;
+
+	// Decodes up to out.size() bytes, fewer only at the end of the data or
+	// after an error.
+	std::size_t read(std::span<std::byte> out);
+
+	// the final block was decoded and everything was read
+	bool finished() const noexcept {
+		return _state == State::done && _read_position == _write_position;
+	}
+
+	// the data is invalid or truncated
+	bool error() const noexcept {
+		return _state == State::error;
+	}
+
+	// number of bytes decoded so far
+	std::uint64_t total_out() const noexcept {
+		return _write_position;
+	}
+
+private:
+	enum class State : std::uint8_t {
+		block_header,
+		stored,
+		huffman,
+		done,
+		error
+	};
+
+	// decodes into the window until it is nearly full or the data ends
+	void decode();
+	bool read_block_header();
+	bool read_dynamic_tables();
+	void decode_stored();
+	void decode_huffman();
+
+	void refill_bits() noexcept;
+	std::uint32_t take_bits(unsigned n) noexcept;
+	// next symbol of table, -1 for an unused code
+	int decode_symbol(detail::HuffmanTable const& table) noexcept;
+	bool input_overrun() const noexcept;
+
+	std::byte const* _in;
+	std::byte const* _in_end;
+	std::uint64_t _bits = 0;
+	unsigned _n_bits = 0;
+	std::size_t _n_padding_bytes = 0; // zeros added to _bits past the input
+
+	State _state = State::block_header;
+	bool _is_final_block = false;
+	bool _has_fixed_tables = false; // the tables are the fixed code's
+	std::uint32_t _stored_remaining = 0;
+	detail::HuffmanTable _literal_table;
+	detail::HuffmanTable _distance_table;
+
+	std::unique_ptr<std::byte[]> _window;
+	std::uint64_t _read_position = 0;
+	std::uint64_t _write_position = 0;
+};
+
+}
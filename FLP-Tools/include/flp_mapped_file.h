@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>       // byte, size_t
+#include <filesystem>    // path
+#include <span>          // span
+#include <system_error>  // error_code
+
+
+namespace Om {
+
+// read-only memory mapping of a whole file
+class MappedFile {
+public:
+	MappedFile() noexcept = default;
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	MappedFile(MappedFile&& other) noexcept :
+		_data { other._data },
+		_size { other._size } {
+		other._data = nullptr;
+		other._size = 0;
+	}
+
+	MappedFile& operator=(MappedFile&& other) noexcept {
+		if(this != &other) {
+			close();
+			_data = other._data;
+			_size = other._size;
+			other._data = nullptr;
+			other._size = 0;
+		}
+		return *this;
+	}
+
+	~MappedFile() {
+		close();
+	}
+
+	// maps the file at path, an empty file results in an empty data() span
+	std::error_code open(std::filesystem::path const& path) noexcept;
+
+	void close() noexcept;
+
+	std::span<std::byte const> data() const noexcept {
+		return { static_cast<std::byte const*>(_data), _size };
+	}
+
+private:
+	void const* _data = nullptr;
+	std::size_t _size = 0;
+};
+
+}
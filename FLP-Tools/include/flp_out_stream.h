@@ -0,0 +1,137 @@
+#pragma once
+
+#include "flp_stream.h"
+
+#include <cstdint>       // uint32_t, UINT32_MAX
+#include <cstring>       // memcpy
+#include <stdexcept>     // runtime_error
+#include <utility>       // forward
+#include <vector>        // vector
+
+
+namespace Om {
+
+// Writes an flp file event by event. The length of the data chunk is
+// patched into its header by finish(), so StreamType has to support
+// tell() and seek() in addition to write(). If tell() fails, as it does
+// for pipes, the data chunk is kept in memory until finish() instead.
+template<typename StreamType>
+class FLPOutStream {
+public:
+	template<typename... Args>
+	FLPOutStream(Args&&... args) :
+		_stream(std::forward<Args>(args)...) {
+	}
+
+	FLPOutStream(FLPOutStream const&) = delete;
+	FLPOutStream& operator=(FLPOutStream const&) = delete;
+
+	// writes the FLhd header and the FLdt header with a placeholder length
+	void write_headers(FLPFileHeader const& file_header) {
+		FLPFileHeader header = file_header;
+		header.header.ChunkID = detail::chunkID("FLhd");
+		header.header.Length = sizeof(FLPFileHeader) - sizeof(FLPChunkHeader);
+		write_value(header);
+
+		_data_header_pos = _stream.tell();
+		_data_size = 0;
+		_pending_data.clear();
+		if(!is_buffered())
+			write_value(FLPChunkHeader { detail::chunkID("FLdt"), 0 });
+	}
+
+	void write_event(FLPEventView const& e) {
+		auto const event_id = static_cast<std::uint8_t>(e.type);
+		// id, up to 5 bytes of varint size or a fixed size value
+		std::byte buf[6];
+		std::size_t n = 0;
+		buf[n++] = std::byte { event_id };
+
+		switch(event_id / 64) {
+		case 0:
+			std::memcpy(buf + n, &e.u8, sizeof(e.u8));
+			n += sizeof(e.u8);
+			break;
+		case 1:
+			std::memcpy(buf + n, &e.i16, sizeof(e.i16));
+			n += sizeof(e.i16);
+			break;
+		case 2:
+			std::memcpy(buf + n, &e.i32, sizeof(e.i32));
+			n += sizeof(e.i32);
+			break;
+		case 3:
+		{
+			if(e.data.size() > UINT32_MAX)
+				throw std::runtime_error { "Event too large!" };
+			auto text_size = static_cast<std::uint32_t>(e.data.size());
+			do {
+				auto b = static_cast<std::uint8_t>(text_size & 0x7FU);
+				text_size >>= 7;
+				if(text_size != 0)
+					b |= 0x80U;
+				buf[n++] = std::byte { b };
+			} while(text_size != 0);
+			break;
+		}
+		}
+
+		write_bytes(buf, n);
+		if(!e.data.empty())
+			write_bytes(e.data.data(), e.data.size());
+	}
+
+	// patches the length of the data chunk, the stream is positioned at the end afterwards
+	void finish() {
+		if(is_buffered()) {
+			write_value(FLPChunkHeader { detail::chunkID("FLdt"), static_cast<std::uint32_t>(_data_size) });
+			if(_stream.write(_pending_data.data(), _pending_data.size()) != _pending_data.size())
+				failed_write();
+			_pending_data.clear();
+			return;
+		}
+		std::int64_t const end_pos = _stream.tell();
+		if(end_pos < 0 || !_stream.seek(_data_header_pos))
+			failed_write();
+		write_value(FLPChunkHeader { detail::chunkID("FLdt"), static_cast<std::uint32_t>(_data_size) });
+		if(!_stream.seek(end_pos))
+			failed_write();
+	}
+
+	StreamType& stream() & noexcept {
+		return _stream;
+	}
+
+private:
+	template<typename T>
+	void write_value(T const& value) {
+		if(_stream.write(&value, 1) != 1)
+			failed_write();
+	}
+
+	bool is_buffered() const noexcept {
+		return _data_header_pos < 0;
+	}
+
+	void write_bytes(std::byte const* data, std::size_t size) {
+		if(size > UINT32_MAX - _data_size)
+			throw std::runtime_error { "Data chunk too large!" };
+		if(is_buffered())
+			_pending_data.insert(_pending_data.end(), data, data + size);
+		else if(_stream.write(data, size) != size)
+			failed_write();
+		_data_size += size;
+	}
+
+	[[noreturn]]
+	static void failed_write() {
+		throw std::runtime_error { "Error writing output file!" };
+	}
+
+	std::int64_t _data_header_pos = -1;
+	std::size_t _data_size = 0;
+	std::vector<std::byte> _pending_data; // the data chunk if the stream can't seek
+	StreamType _stream {};
+};
+
+}
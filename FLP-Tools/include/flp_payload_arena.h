@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cassert>       // assert
+#include <cstddef>       // byte, size_t
+#include <memory>        // unique_ptr
+#include <vector>        // vector
+
+
+namespace Om {
+
+// When a FLPInStream resets the arena per event only one payload is alive
+// at a time, when it is reset per batch the caller calls reset() once it
+// is done with all events read since the last reset.
+enum class FLPArenaReset {
+	per_event,
+	per_batch
+};
+
+// Bump allocator for event payloads. Memory is reused across resets, so
+// after the first few events decoding does not allocate anymore and the
+// memory used stays bounded by the largest event (or batch).
+class FLPPayloadArena {
+public:
+	static constexpr std::size_t default_block_size = 64 * 1024;
+
+	explicit FLPPayloadArena(std::size_t initial_size = default_block_size) {
+		add_block(initial_size);
+	}
+
+	FLPPayloadArena(FLPPayloadArena const&) = delete;
+	FLPPayloadArena& operator=(FLPPayloadArena const&) = delete;
+
+	// memory stays valid until the next reset()
+	std::byte* allocate(std::size_t size) {
+		std::size_t const offset = align_up(_used);
+		// what the allocation takes up in a single block, padding included
+		_batch_size += align_up(size);
+		Block& block = _blocks.back();
+		if(offset + size > block.size) {
+			// keep the payloads in the current block alive
+			std::size_t const new_size = (size > block.size ? size : block.size);
+			add_block(new_size);
+			_used = size;
+			return _blocks.back().data.get();
+		}
+		_used = offset + size;
+		return block.data.get() + offset;
+	}
+
+	void reset() {
+		if(_blocks.size() > 1) {
+			// replace the blocks by one that fits everything the last batch needed
+			std::size_t const needed = _batch_size;
+			std::size_t const last_size = _blocks.back().size;
+			if(last_size >= needed) {
+				_blocks.erase(_blocks.begin(), _blocks.end() - 1);
+			} else {
+				_blocks.clear();
+				add_block(needed);
+			}
+		}
+		_used = 0;
+		_batch_size = 0;
+	}
+
+	// number of bytes reserved
+	std::size_t capacity() const noexcept {
+		std::size_t n = 0;
+		for(Block const& block : _blocks) {
+			n += block.size;
+		}
+		return n;
+	}
+
+private:
+	static constexpr std::size_t alignment = 16;
+
+	static constexpr std::size_t align_up(std::size_t n) noexcept {
+		return (n + (alignment - 1)) & ~(alignment - 1);
+	}
+
+	struct Block {
+		std::unique_ptr<std::byte[]> data;
+		std::size_t size;
+	};
+
+	void add_block(std::size_t size) {
+		assert(size > 0);
+		_blocks.push_back({ std::make_unique_for_overwrite<std::byte[]>(size), size });
+	}
+
+	std::vector<Block> _blocks;
+	std::size_t _used = 0;
+	std::size_t _batch_size = 0; // bytes the allocations since the last reset need, padded
+};
+
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "flp.h"
+
+#include <cstddef>       // size_t
+#include <cstdint>       // uint32_t, UINT32_MAX
+#include <string>        // string
+#include <string_view>   // string_view, u16string_view
+#include <vector>        // vector
+
+
+namespace Om {
+
+// Index of a row in one of the tables of an FLPProject.
+using FLPHandle = std::uint32_t;
+constexpr FLPHandle flp_no_handle = UINT32_MAX;
+
+// text in an FLPStringPool
+struct FLPStringRef {
+	std::uint32_t offset = 0;
+	std::uint32_t length = 0;
+};
+
+// All strings of a project in one buffer, as UTF-8 for FL 12 and later
+// and as stored (ANSI) before.
+class FLPStringPool {
+public:
+	FLPStringRef add(std::string_view str);
+
+	// throws std::system_error for invalid UTF-16
+	FLPStringRef add_utf16(std::u16string_view str);
+
+	std::string_view view(FLPStringRef ref) const noexcept {
+		return std::string_view(_chars).substr(ref.offset, ref.length);
+	}
+
+	std::size_t size() const noexcept {
+		return _chars.size();
+	}
+
+private:
+	std::string _chars;
+};
+
+// The tables store one vector per field, rows with the same index belong
+// together. Handles are row indexes.
+
+struct FLPChannelTable {
+	std::vector<std::uint16_t> index;       // as given by FLP_NewChan, notes refer to channels by it
+	std::vector<std::uint8_t> type;         // FLP_ChanType
+	std::vector<FLPStringRef> name;         // name in the channel rack
+	std::vector<FLPStringRef> plugin;       // internal name of the generator, like "Sytrus"
+	std::vector<FLPStringRef> sample_path;
+	std::vector<std::int16_t> mixer_insert; // -1 if not set
+
+	std::size_t size() const noexcept {
+		return index.size();
+	}
+};
+
+struct FLPPatternTable {
+	std::vector<std::uint16_t> id;          // as given by FLP_NewPat, playlist clips refer to patterns by it
+	std::vector<FLPStringRef> name;
+	std::vector<std::uint32_t> color;
+	std::vector<std::uint32_t> n_notes;
+
+	std::size_t size() const noexcept {
+		return id.size();
+	}
+};
+
+// the notes of all patterns in file order
+struct FLPNoteTable {
+	std::vector<FLPHandle> pattern;
+	std::vector<FLPHandle> channel;         // flp_no_handle if the project has no such channel
+	std::vector<std::uint32_t> position;    // in ticks
+	std::vector<std::uint32_t> length;      // in ticks
+	std::vector<std::uint8_t> key;          // C5 is 60
+	std::vector<std::uint8_t> velocity;     // 0 to 128
+	std::vector<std::uint8_t> pan;          // 0 to 128, 64 is default
+	std::vector<std::uint8_t> fine_pitch;   // 0 - 240, 120 is default
+
+	std::size_t size() const noexcept {
+		return position.size();
+	}
+};
+
+// mixer inserts in file order, 0 is the master
+struct FLPInsertTable {
+	std::vector<FLPStringRef> name;
+	std::vector<std::uint32_t> color;
+	std::vector<std::int32_t> input;        // FLP_FXInChanNum, -1 if not set
+	std::vector<std::int32_t> output;       // FLP_FXOutChanNum, -1 if not set
+
+	std::size_t size() const noexcept {
+		return name.size();
+	}
+};
+
+enum class FLPPlaylistSource : std::uint8_t {
+	pattern,
+	channel  // audio and automation clips
+};
+
+struct FLPPlaylistTable {
+	std::vector<std::uint32_t> position;    // in ticks
+	std::vector<std::uint32_t> length;      // in ticks
+	std::vector<std::uint16_t> track;       // 0 is the top track from FL 20 on, as stored before
+	std::vector<FLPPlaylistSource> source_kind;
+	std::vector<FLPHandle> source;          // into patterns or channels, flp_no_handle if missing
+	std::vector<std::uint8_t> muted;
+
+	std::size_t size() const noexcept {
+		return position.size();
+	}
+};
+
+struct FLPProject {
+	FLPFileHeader header {};
+	FLPStringRef version;
+	FLPStringRef title;
+	FLPStringRef author;
+	FLPStringRef genre;
+	std::uint32_t tempo = 0;                // BPM * 1000
+
+	FLPStringPool strings;
+	FLPChannelTable channels;
+	FLPPatternTable patterns;
+	FLPNoteTable notes;
+	FLPInsertTable inserts;
+	FLPPlaylistTable playlist;
+
+	std::string_view string(FLPStringRef ref) const noexcept {
+		return strings.view(ref);
+	}
+};
+
+// Tracks which channel, pattern or mixer insert the events belong to while
+// they are added in file order. References by FL's ids are resolved to
+// handles by finish(), channels may come after the patterns using them.
+class FLPProjectBuilder {
+public:
+	explicit FLPProjectBuilder(FLPFileHeader const& header);
+
+	void add_event(FLPEventView const& e);
+
+	void add_event(FLPEvent const& e) {
+		add_event(e.view());
+	}
+
+	FLPProject finish();
+
+private:
+	enum class Section : std::uint8_t {
+		none,
+		channel,
+		pattern,
+		mixer
+	};
+
+	FLPStringRef add_string(FLPEventView const& e);
+	FLPHandle channel_handle(std::uint16_t index);
+	FLPHandle pattern_handle(std::uint16_t id);
+	FLPHandle current_insert();
+
+	FLPProject _project;
+	Section _section = Section::none;
+	FLPHandle _channel = flp_no_handle;
+	FLPHandle _pattern = flp_no_handle;
+	FLPHandle _insert = 0;
+	int _major_version = 0;
+	bool _has_fine_tempo = false;
+	std::vector<FLPHandle> _channel_by_index;
+	std::vector<FLPHandle> _pattern_by_id;
+	// resolved by finish()
+	std::vector<std::uint16_t> _note_rack_channels;
+	std::vector<std::uint16_t> _playlist_source_ids;
+};
+
+// Reads the remaining events of an FLPInStream or FLPViewInStream.
+template<typename FLPStreamT>
+FLPProject read_flp_project(FLPStreamT& flp) {
+	FLPProjectBuilder builder(flp.file_header());
+	for(; flp.has_event(); ++flp) {
+		builder.add_event(*flp);
+	}
+	return builder.finish();
+}
+
+}
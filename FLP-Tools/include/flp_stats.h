@@ -0,0 +1,125 @@
+#pragma once
+
+#include "flp.h"
+#include "flp_enums.h"
+
+#include <algorithm>     // sort
+#include <array>         // array
+#include <chrono>        // steady_clock, duration
+#include <cstdint>       // uint8_t, uint64_t
+#include <vector>        // vector
+
+
+namespace Om {
+
+struct FLPEventTypeStats {
+	std::uint64_t count = 0;
+	std::uint64_t payload_bytes = 0;
+	std::uint64_t max_payload = 0;
+};
+
+// Where the time and bytes of reading and converting a project go.
+// FLPInStream and FLPViewInStream count the events they visit and time
+// decoding once set_stats() was called, stream_flp_event times serializing
+// if FLPStreamOptions::stats is set. Without them nothing is measured and
+// the cost is a pointer check per event.
+struct FLPStats {
+	using clock = std::chrono::steady_clock;
+
+	std::array<FLPEventTypeStats, 256> event_types {};
+	clock::duration decode_time {};
+	clock::duration serialize_time {};
+
+	void add_event(FLPEventView const& e) noexcept {
+		auto const id = static_cast<std::uint8_t>(e.type);
+		// data is only set for the variable sized events from id 192 on
+		constexpr std::uint64_t fixed_sizes[] = { 1, 2, 4 };
+		std::uint64_t const size = id < 192 ? fixed_sizes[id / 64] : e.data.size();
+		FLPEventTypeStats& type = event_types[id];
+		++type.count;
+		type.payload_bytes += size;
+		if(size > type.max_payload)
+			type.max_payload = size;
+	}
+
+	// for the statistics of several threads or files
+	void merge(FLPStats const& other) noexcept {
+		for(std::size_t i = 0; i < event_types.size(); ++i) {
+			event_types[i].count += other.event_types[i].count;
+			event_types[i].payload_bytes += other.event_types[i].payload_bytes;
+			if(other.event_types[i].max_payload > event_types[i].max_payload)
+				event_types[i].max_payload = other.event_types[i].max_payload;
+		}
+		decode_time += other.decode_time;
+		serialize_time += other.serialize_time;
+	}
+
+	std::uint64_t n_events() const noexcept {
+		std::uint64_t n = 0;
+		for(FLPEventTypeStats const& type : event_types) {
+			n += type.count;
+		}
+		return n;
+	}
+
+	std::uint64_t payload_bytes() const noexcept {
+		std::uint64_t n = 0;
+		for(FLPEventTypeStats const& type : event_types) {
+			n += type.payload_bytes;
+		}
+		return n;
+	}
+};
+
+// Writes stats as keys of the current object of stream, the event types
+// with the most payload bytes first. Times are in seconds.
+template<typename StreamT>
+void stream_flp_stats(StreamT& stream, FLPStats const& stats) {
+	using seconds = std::chrono::duration<double>;
+
+	stream.key("events");
+	stream.value(stats.n_events());
+	stream.key("payload_bytes");
+	stream.value(stats.payload_bytes());
+	stream.key("decode_seconds");
+	stream.value(std::chrono::duration_cast<seconds>(stats.decode_time).count());
+	stream.key("serialize_seconds");
+	stream.value(std::chrono::duration_cast<seconds>(stats.serialize_time).count());
+
+	std::vector<std::uint8_t> ids;
+	for(std::size_t id = 0; id < stats.event_types.size(); ++id) {
+		if(stats.event_types[id].count != 0)
+			ids.push_back(static_cast<std::uint8_t>(id));
+	}
+	std::sort(ids.begin(), ids.end(), [&](std::uint8_t a, std::uint8_t b) {
+		FLPEventTypeStats const& x = stats.event_types[a];
+		FLPEventTypeStats const& y = stats.event_types[b];
+		if(x.payload_bytes != y.payload_bytes)
+			return x.payload_bytes > y.payload_bytes;
+		if(x.count != y.count)
+			return x.count > y.count;
+		return a < b;
+	});
+
+	stream.key("event_types");
+	stream.begin_array();
+	for(std::uint8_t id : ids) {
+		FLPEventTypeStats const& type = stats.event_types[id];
+		char const* name = flp_event_name(id);
+		stream.begin_object();
+		stream.key("id");
+		stream.value(static_cast<unsigned>(id));
+		stream.key("name");
+		stream.value_str_noescape(name ? name : "Unknown");
+		stream.key("count");
+		stream.value(type.count);
+		stream.key("payload_bytes");
+		stream.value(type.payload_bytes);
+		stream.key("max_payload");
+		stream.value(type.max_payload);
+		stream.end_object();
+	}
+	stream.end_array();
+}
+
+}
@@ -1,17 +1,37 @@
 #pragma once
 
 #include "flp.h"
+#include "flp_base64.h"
+#include "flp_event_mask.h"
+#include "flp_hex.h"
+#include "flp_payload_arena.h"
+#include "flp_stats.h"
+#include "flp_trace.h"
 #include "flp_utf_conversions.h"
 
 #include <cassert>       // assert
+#include <cstdint>       // uint64_t
+#include <span>          // span
 #include <vector>        // vector
-#include <string_view>   // string_view, wstring_view, std::size
+#include <string_view>   // string_view, u16string_view, std::size
 #include <stdexcept>     // runtime_error
 #include <utility>       // forward
 
 
 namespace Om {
 
+namespace detail {
+
+	inline std::uint32_t chunkID(char const (&p)[5]) noexcept {
+		assert(strlen(p) == 4);
+		return std::uint32_t(p[0] | p[1] << 8 | p[2] << 16 | p[3] << 24);
+	}
+
+	inline bool check_chunkID(std::uint32_t id, char const (&p)[5]) noexcept {
+		return id == chunkID(p);
+	}
+}
+
 template<typename StreamType>
 class FLPInStream {
 public:
@@ -26,7 +46,7 @@ public:
 	FLPInStream& operator=(FLPInStream const&) = delete;
 
 	bool has_event() {
-		return _data_bytes_read < _data_header.Length;
+		return _has_event;
 	}
 
 	FLPEvent* operator->() & {
@@ -37,7 +57,67 @@ public:
 		return _current_event;
 	}
 
+	// Payloads of the following events are read into arena instead of
+	// being allocated one by one, they are not owned by the events then.
+	// Passing nullptr switches back to allocating payloads.
+	void use_payload_arena(FLPPayloadArena* arena, FLPArenaReset reset = FLPArenaReset::per_event) noexcept {
+		_arena = arena;
+		_arena_reset = reset;
+	}
+
+	// Only events whose type is in mask are visited from now on, the
+	// current event is skipped too if it isn't in the mask.
+	void set_event_mask(FLPEventMask const& mask) {
+		_event_mask = mask;
+		if(_has_event && !_event_mask.test(_current_event.type))
+			++(*this);
+	}
+
+	// Events visited from now on are counted in stats and the time to
+	// decode them is added, the current event is counted right away.
+	// Passing nullptr stops measuring.
+	void set_stats(FLPStats* stats) noexcept {
+		_stats = stats;
+		if(_stats && _has_event)
+			_stats->add_event(_current_event.view());
+	}
+
 	FLPInStream& operator++() {
+		OM_TRACE_SPAN("decode", "flp");
+		if(_stats) {
+			auto const begin = FLPStats::clock::now();
+			read_next_event();
+			_stats->decode_time += FLPStats::clock::now() - begin;
+			if(_has_event)
+				_stats->add_event(_current_event.view());
+			return *this;
+		}
+		read_next_event();
+		return *this;
+	}
+
+	FLPFileHeader const& file_header() const& {
+		return _file_header;
+	}
+
+	FLPChunkHeader const& data_header() const& {
+		return _data_header;
+	}
+
+private:
+	void read_next_event() {
+		while(!read_event()) {
+			// the event wasn't in the mask
+		}
+	}
+
+	// returns false if the event was skipped because it isn't in the mask
+	bool read_event() {
+		if(_data_bytes_read >= _data_header.Length) {
+			_has_event = false;
+			return true;
+		}
+
 		std::uint8_t event_id = 0;
 		if(!_stream.read(&event_id))
 			failed_read(_stream);
@@ -67,56 +147,88 @@ public:
 		case 3:
 		{ // TEXT event
 			std::uint32_t text_size = 0;
-			std::uint8_t current_byte;
-			std::uint32_t shift_by = 0;
-			do { // extract size
-				 // left shift by more is undefined behaviour
-				assert(shift_by < sizeof(shift_by) * CHAR_BIT);
-				if(!_stream.read(&current_byte))
+			if constexpr(requires { _stream.read_varint(&text_size); }) {
+				// the stream can decode the size from its buffer
+				std::size_t const n_bytes = _stream.read_varint(&text_size);
+				if(n_bytes == 0)
 					failed_read(_stream);
-				_data_bytes_read += 1;
-				text_size += ((current_byte & std::uint8_t(0x7FU)) << shift_by);
-				shift_by += 7;
-			} while(current_byte & 0x80U);
+				_data_bytes_read += static_cast<std::uint32_t>(n_bytes);
+			} else {
+				std::uint8_t current_byte;
+				std::uint32_t shift_by = 0;
+				do { // extract size
+					 // left shift by more is undefined behaviour
+					assert(shift_by < sizeof(shift_by) * CHAR_BIT);
+					if(!_stream.read(&current_byte))
+						failed_read(_stream);
+					_data_bytes_read += 1;
+					text_size += ((current_byte & std::uint8_t(0x7FU)) << shift_by);
+					shift_by += 7;
+				} while(current_byte & 0x80U);
+			}
+
+			if(!_event_mask.test(_current_event.type)) {
+				skip_payload(text_size);
+				return false;
+			}
 
 			_current_event.var_size = text_size;
 
 			if(text_size == 0) {
 				_current_event.text_data = nullptr;
+			} else if(_arena) {
+				_current_event.text_data = nullptr;
+				if(_arena_reset == FLPArenaReset::per_event)
+					_arena->reset();
+				std::byte* buffer = _arena->allocate(text_size);
+				if(_stream.read(buffer, text_size) != text_size)
+					failed_read(_stream);
+				_data_bytes_read += text_size;
+
+				_current_event.text_data = { buffer, FLPPayloadDeleter { false } };
 			} else {
 				auto up_buffer = std::make_unique<std::byte[]>(text_size);
 				if(_stream.read(up_buffer.get(), text_size) != text_size)
 					failed_read(_stream);
 				_data_bytes_read += text_size;
 
-				_current_event.text_data = std::move(up_buffer);
+				_current_event.text_data = { up_buffer.release(), FLPPayloadDeleter {} };
 			}
 			break;
 		}
 		}
-		return *this;
+		return _event_mask.test(_current_event.type);
 	}
 
-	FLPFileHeader const& file_header() const& {
-		return _file_header;
-	}
-
-	FLPChunkHeader const& data_header() const& {
-		return _data_header;
+	void skip_payload(std::uint32_t size) {
+		if constexpr(requires { _stream.skip(std::size_t {}); }) {
+			// the stream can seek over the payload
+			if(!_stream.skip(size))
+				failed_read(_stream);
+		} else {
+			std::byte discard[4096];
+			for(std::uint32_t rest = size; rest > 0;) {
+				std::uint32_t const n = rest < sizeof(discard) ? rest : sizeof(discard);
+				if(_stream.read(discard, n) != n)
+					failed_read(_stream);
+				rest -= n;
+			}
+		}
+		_data_bytes_read += size;
 	}
 
-private:
 	void read_headers() {
+		OM_TRACE_SPAN("read_headers", "flp");
 		// read flp header
 		if(!_stream.read(&_file_header))
 			failed_read(_stream);
-		if(!check_chunkID(_file_header.header.ChunkID, "FLhd"))
+		if(!detail::check_chunkID(_file_header.header.ChunkID, "FLhd"))
 			throw std::runtime_error { "Not an FLP file!" };
 
 		// read data header
 		if(!_stream.read(&_data_header))
 			failed_read(_stream);
-		if(!check_chunkID(_data_header.ChunkID, "FLdt"))
+		if(!detail::check_chunkID(_data_header.ChunkID, "FLdt"))
 			throw std::runtime_error { "Invalid data header!" };
 	}
 
@@ -126,18 +238,90 @@ private:
 		throw std::runtime_error(errstr);
 	}
 
-	static bool check_chunkID(std::uint32_t id, char const (&p)[5]) noexcept {
-		assert(strlen(p) == 4);
-		return id == std::uint32_t(p[0] | p[1] << 8 | p[2] << 16 | p[3] << 24);
-	};
-
 	FLPEvent _current_event {};
 	std::uint32_t _data_bytes_read = 0;
+	bool _has_event = true;
+	FLPPayloadArena* _arena = nullptr;
+	FLPArenaReset _arena_reset = FLPArenaReset::per_event;
+	FLPEventMask _event_mask = FLPEventMask::all();
+	FLPStats* _stats = nullptr;
 	FLPFileHeader _file_header {};
 	FLPChunkHeader _data_header {};
 	StreamType _stream {};
 };
 
+// How the payloads of events without a known structure (plugin states,
+// channel parameters...) are written.
+enum class FLPDataEncoding : std::uint8_t {
+	hex,     // "XX XX XX"
+	base64,
+	sidecar  // raw bytes in a separate file, the json only has offset and length
+};
+
+inline char const* data_encoding_name(FLPDataEncoding encoding) noexcept {
+	switch(encoding) {
+	case FLPDataEncoding::hex:
+		return "hex";
+	case FLPDataEncoding::base64:
+		return "base64";
+	case FLPDataEncoding::sidecar:
+		return "sidecar";
+	}
+	return nullptr;
+}
+
+// Receives the payloads for FLPDataEncoding::sidecar and keeps track of the
+// offset of the next one in the sidecar file.
+class FLPSidecarWriter {
+public:
+	explicit FLPSidecarWriter(std::uint64_t offset = 0) noexcept :
+		_offset(offset) {
+	}
+
+	virtual ~FLPSidecarWriter() = default;
+
+	// returns the offset of the payload in the sidecar file
+	std::uint64_t append(std::span<std::byte const> data) {
+		std::uint64_t const offset = _offset;
+		write(data.data(), data.size());
+		_offset += data.size();
+		return offset;
+	}
+
+	std::uint64_t offset() const noexcept {
+		return _offset;
+	}
+
+protected:
+	virtual void write(std::byte const* data, std::size_t size) = 0;
+
+private:
+	std::uint64_t _offset;
+};
+
+// How arrays of pattern notes and playlist clips are written.
+enum class FLPRecordLayout : std::uint8_t {
+	rows,    // an object per record
+	columns  // an object with an array per field, each in record order
+};
+
+inline char const* record_layout_name(FLPRecordLayout layout) noexcept {
+	switch(layout) {
+	case FLPRecordLayout::rows:
+		return "rows";
+	case FLPRecordLayout::columns:
+		return "columns";
+	}
+	return nullptr;
+}
+
+struct FLPStreamOptions {
+	FLPDataEncoding data_encoding = FLPDataEncoding::hex;
+	FLPSidecarWriter* sidecar = nullptr; // required for FLPDataEncoding::sidecar
+	FLPRecordLayout record_layout = FLPRecordLayout::rows;
+	FLPStats* stats = nullptr;           // serializing time is added if set
+};
+
 template<typename StreamT>
 void stream_flp_header(StreamT& stream, FLPFileHeader const& header) {
 	stream.begin_object();
@@ -153,16 +337,20 @@ void stream_flp_header(StreamT& stream, FLPFileHeader const& header) {
 namespace detail {
 
 	template<typename Stream>
-	void stream_fxrouting(Stream& stream, FLPEvent const& e) {
+	void stream_fxrouting(Stream& stream, FLPEventView const& e) {
+		OM_TRACE_SPAN("stream_fxrouting", "serialize");
 		stream.key("data_type");
 		stream.value_str_noescape("fx_routing[]");
+		// only non-zero entries are written, the size is needed to restore the event
+		stream.key("data_size");
+		stream.value(e.data.size());
 		stream.key("data");
 		stream.begin_array();
 
-		auto const* data = reinterpret_cast<unsigned char const*>(e.text_data.get());
+		auto const* data = reinterpret_cast<unsigned char const*>(e.data.data());
 
-		assert(e.var_size != 0);
-		for(std::size_t i = 0; i < e.var_size; ++i) {
+		assert(e.data.size() != 0);
+		for(std::size_t i = 0; i < e.data.size(); ++i) {
 			if(data[i] == 0) {
 				continue;
 			}
@@ -177,14 +365,99 @@ namespace detail {
 		stream.end_array();
 	}
 
+	// rows is the default and has no key
 	template<typename Stream>
-	void stream_pattern_notes(Stream& stream, FLPEvent const& e) {
-		assert(e.var_size % sizeof(FLPPatternNoteRecord) == 0);
+	void stream_record_layout(Stream& stream, FLPRecordLayout layout) {
+		if(layout != FLPRecordLayout::rows) {
+			stream.key("data_layout");
+			stream.value_str_noescape(record_layout_name(layout));
+		}
+	}
+
+	template<typename Stream, typename Record, typename Get>
+	void stream_record_column(Stream& stream, char const* name, std::span<Record const> records, Get get) {
+		stream.key(name);
+		stream.begin_array();
+		for(Record const& record : records) {
+			stream.value(get(record));
+		}
+		stream.end_array();
+	}
+
+	// same keys as the objects written by stream_pattern_notes
+	template<typename Stream>
+	void stream_pattern_note_columns(Stream& stream, std::span<FLPPatternNoteRecord const> notes) {
+		using Note = FLPPatternNoteRecord;
+		stream.begin_object();
+		stream_record_column(stream, "position", notes, [](Note const& n) { return n.position; });
+		stream_record_column(stream, "flags", notes, [](Note const& n) { return n.flags; });
+		stream_record_column(stream, "rack_channel", notes, [](Note const& n) { return n.rack_channel; });
+		stream_record_column(stream, "length", notes, [](Note const& n) { return n.length; });
+		stream_record_column(stream, "key", notes, [](Note const& n) { return n.key; });
+		stream_record_column(stream, "data0", notes, [](Note const& n) { return n.data0; });
+		stream_record_column(stream, "group", notes, [](Note const& n) { return n.group_id; });
+		stream_record_column(stream, "data1", notes, [](Note const& n) { return n.data1; });
+		stream_record_column(stream, "fine_pitch", notes, [](Note const& n) { return n.fine_pitch; });
+		stream_record_column(stream, "data2", notes, [](Note const& n) { return n.data2; });
+		stream_record_column(stream, "release", notes, [](Note const& n) { return n.release; });
+		stream_record_column(stream, "flags2", notes, [](Note const& n) { return (n.midi_channel & 0xF0) >> 4; });
+		stream_record_column(stream, "midi_channel", notes, [](Note const& n) { return n.midi_channel & 0x0F; });
+		stream_record_column(stream, "pan", notes, [](Note const& n) { return n.pan; });
+		stream_record_column(stream, "velocity", notes, [](Note const& n) { return n.velocity; });
+		stream_record_column(stream, "mod_x", notes, [](Note const& n) { return n.mod_x; });
+		stream_record_column(stream, "mod_y", notes, [](Note const& n) { return n.mod_y; });
+		stream.end_object();
+	}
+
+	// data1 and data2 are arrays of arrays, one per clip
+	template<typename Stream, std::size_t N>
+	void stream_clip_bytes_column(Stream& stream, char const* name, std::span<FLPPlaylistClipRecord const> clips,
+	                              std::byte const (FLPPlaylistClipRecord::*field)[N]) {
+		stream.key(name);
+		stream.begin_array();
+		for(FLPPlaylistClipRecord const& clip : clips) {
+			stream.begin_array();
+			for(std::byte b : clip.*field) {
+				stream.value(b);
+			}
+			stream.end_array();
+		}
+		stream.end_array();
+	}
+
+	// same keys as the objects written by stream_playlist_clips
+	template<typename Stream>
+	void stream_playlist_clip_columns(Stream& stream, std::span<FLPPlaylistClipRecord const> clips) {
+		using Clip = FLPPlaylistClipRecord;
+		stream.begin_object();
+		stream_record_column(stream, "position", clips, [](Clip const& c) { return c.position; });
+		stream_record_column(stream, "data0", clips, [](Clip const& c) { return c.data0; });
+		stream_record_column(stream, "source_index", clips, [](Clip const& c) { return c.source_index; });
+		stream_record_column(stream, "duration", clips, [](Clip const& c) { return c.duration; });
+		stream_record_column(stream, "lane_index", clips, [](Clip const& c) { return c.lane_index; });
+		stream_record_column(stream, "group", clips, [](Clip const& c) { return c.group; });
+		stream_clip_bytes_column(stream, "data1", clips, &Clip::data1);
+		stream_record_column(stream, "flags", clips, [](Clip const& c) { return c.flags; });
+		stream_clip_bytes_column(stream, "data2", clips, &Clip::data2);
+		stream_record_column(stream, "window_start", clips, [](Clip const& c) { return c.window_start; });
+		stream_record_column(stream, "window_end", clips, [](Clip const& c) { return c.window_end; });
+		stream.end_object();
+	}
+
+	template<typename Stream>
+	void stream_pattern_notes(Stream& stream, FLPEventView const& e, FLPRecordLayout layout) {
+		OM_TRACE_SPAN("stream_pattern_notes", "serialize");
+		assert(e.data.size() % sizeof(FLPPatternNoteRecord) == 0);
 		stream.key("data_type");
 		stream.value_str_noescape("pattern_note[]");
+		stream_record_layout(stream, layout);
 		stream.key("data");
-		auto* notes = reinterpret_cast<FLPPatternNoteRecord const*>(e.text_data.get());
-		int const n_notes = static_cast<int>(e.var_size / sizeof(FLPPatternNoteRecord));
+		auto* notes = reinterpret_cast<FLPPatternNoteRecord const*>(e.data.data());
+		int const n_notes = static_cast<int>(e.data.size() / sizeof(FLPPatternNoteRecord));
+		if(layout == FLPRecordLayout::columns) {
+			stream_pattern_note_columns(stream, std::span(notes, n_notes));
+			return;
+		}
 		stream.begin_array();
 		for(int i = 0; i < n_notes; ++i) {
 			FLPPatternNoteRecord const& note = notes[i];
@@ -230,13 +503,19 @@ namespace detail {
 	}
 
 	template<typename Stream>
-	void stream_playlist_clips(Stream& stream, FLPEvent const& e) {
-		assert(e.var_size % sizeof(FLPPlaylistClipRecord) == 0);
+	void stream_playlist_clips(Stream& stream, FLPEventView const& e, FLPRecordLayout layout) {
+		OM_TRACE_SPAN("stream_playlist_clips", "serialize");
+		assert(e.data.size() % sizeof(FLPPlaylistClipRecord) == 0);
 		stream.key("data_type");
 		stream.value_str_noescape("playlist_clip[]");
+		stream_record_layout(stream, layout);
 		stream.key("data");
-		auto* clips = reinterpret_cast<FLPPlaylistClipRecord const*>(e.text_data.get());
-		int const n_clips = static_cast<int>(e.var_size / sizeof(FLPPlaylistClipRecord));
+		auto* clips = reinterpret_cast<FLPPlaylistClipRecord const*>(e.data.data());
+		int const n_clips = static_cast<int>(e.data.size() / sizeof(FLPPlaylistClipRecord));
+		if(layout == FLPRecordLayout::columns) {
+			stream_playlist_clip_columns(stream, std::span(clips, n_clips));
+			return;
+		}
 		stream.begin_array();
 		for(int i = 0; i < n_clips; ++i) {
 			FLPPlaylistClipRecord const& clip = clips[i];
@@ -276,85 +555,145 @@ namespace detail {
 		stream.end_array();
 	}
 
-	constexpr inline char get_nibble_char(std::byte nibble) noexcept {
-		auto nbval = static_cast<unsigned char>(nibble);
-		return (nbval < 0xA) ? nbval + '0' : nbval - 0xA + 'A';
-	}
-
 	template<typename Stream>
-	void stream_bytes(Stream& stream, FLPEvent const& e) {
-		// write bytes as hex
+	void stream_bytes(Stream& stream, FLPEventView const& e, FLPStreamOptions const& options) {
+		OM_TRACE_SPAN("stream_bytes", "serialize");
 		stream.key("data_type");
 		stream.value_str_noescape("bytes");
 		stream.key("data_size");
-		stream.value(e.var_size);
+		stream.value(e.data.size());
+		// hex is the default and has no key
+		if(options.data_encoding != FLPDataEncoding::hex) {
+			stream.key("data_encoding");
+			stream.value_str_noescape(data_encoding_name(options.data_encoding));
+		}
 
 		stream.key("data");
 
-		if(e.var_size == 0) {
+		if(e.data.size() == 0) {
 			stream.value(nullptr);
 			return;
 		}
 
-		char local_buf[4457];
-		//char local_buf[4016];
-		std::unique_ptr<char> large_buf;
-		char* buf;
-		std::size_t const required_bufsz = (e.var_size - 1) * 3 + 2;
-		if(required_bufsz > std::size(local_buf)) {
-			large_buf.reset(new char[required_bufsz]);
-			buf = large_buf.get();
-			//std::printf("used large buffer: %s, %zu bytes\n", flp_event_name(e.type), required_bufsz);
-		} else {
-			buf = local_buf;
-		}
-		std::byte const* data = e.text_data.get();
-		std::byte b;
-		char* p = buf;
-		for(auto i = 0U; i < e.var_size - 1; i++) {
-			b = data[i];
-			p[0] = detail::get_nibble_char(b >> 4);
-			p[1] = detail::get_nibble_char(b & std::byte { 0x0F });
-			p[2] = ' ';
-			p += 3;
+		// plugin states can be hundreds of KB, encode them straight into the output buffer
+		std::size_t encoded = 0;
+		switch(options.data_encoding) {
+		case FLPDataEncoding::hex:
+			stream.value_str_fill(hex_spaced_length(e.data.size()), [&](char* out, std::size_t n) {
+				hex_encode_spaced(e.data, encoded, n, out);
+				encoded += n;
+			});
+			break;
+		case FLPDataEncoding::base64:
+			stream.value_str_fill(base64_length(e.data.size()), [&](char* out, std::size_t n) {
+				base64_encode(e.data, encoded, n, out);
+				encoded += n;
+			});
+			break;
+		case FLPDataEncoding::sidecar:
+			assert(options.sidecar != nullptr);
+			stream.begin_object();
+			stream.key("offset");
+			stream.value(options.sidecar->append(e.data));
+			stream.key("length");
+			stream.value(e.data.size());
+			stream.end_object();
+			break;
 		}
-		b = data[e.var_size - 1];
-		p[0] = detail::get_nibble_char(b >> 4);
-		p[1] = detail::get_nibble_char(b & std::byte { 0x0F });
-
-		stream.value_str_noescape(std::string_view(buf, required_bufsz));
 	}
 
 	template<bool useWideStr, typename Stream>
-	void stream_string(Stream& stream, FLPEvent const& e) {
+	void stream_string(Stream& stream, FLPEventView const& e) {
+		OM_TRACE_SPAN("stream_string", "serialize");
 		stream.key("data_type");
 		stream.value_str_noescape("string");
 		stream.key("string_length");
-		assert(e.var_size >= 1);
+		assert(e.data.size() >= 1);
 		if constexpr (useWideStr) {
-			assert(e.var_size % 2 == 0);
-			stream.value(e.var_size / 2 - 1);
+			assert(e.data.size() % 2 == 0);
+			stream.value(e.data.size() / 2 - 1);
 			stream.key("data");
 			// FLP_Text_* is a UTF16 string from FL12 on
-			auto wstr = reinterpret_cast<wchar_t const*>(e.text_data.get());
-			std::size_t const len = e.var_size / 2 - 1;
-			std::string sutf8;
-			if(std::error_code err = Om::utf16_to_utf8(std::wstring_view(wstr, len), &sutf8))
-				throw std::system_error(err);
-			else
-				stream.value(sutf8);
+			auto const* str16 = reinterpret_cast<char16_t const*>(e.data.data());
+			std::size_t const len = e.data.size() / 2 - 1;
+			// transcoded by the stream, straight into its buffer
+			stream.value(std::u16string_view(str16, len));
 		} else {
-			stream.value(e.var_size - 1);
+			stream.value(e.data.size() - 1);
 			stream.key("data");
-			char const* str = reinterpret_cast<char const*>(e.text_data.get());
-			std::size_t const len = e.var_size - 1;
+			char const* str = reinterpret_cast<char const*>(e.data.data());
+			std::size_t const len = e.data.size() - 1;
 			stream.value(std::string_view(str, len));
 		}
 	}
 }
 
+namespace detail {
+
+	enum class PayloadKind : std::uint8_t {
+		ansi_string,
+		string,         // UTF-16 from FL 12 on
+		pattern_notes,
+		playlist_clips,
+		fx_routing,
+		bytes
+	};
+
+	// how the payload of an event with a variable size is interpreted
+	constexpr PayloadKind payload_kind(FLPEventType type) noexcept {
+		switch(type) {
+		case FLPEventType::FLP_Version:
+			return PayloadKind::ansi_string;
+		case FLPEventType::FLP_Text_ChanName:
+		case FLPEventType::FLP_Text_PatName:
+		case FLPEventType::FLP_Text_Title:
+		case FLPEventType::FLP_Text_Comment:
+		case FLPEventType::FLP_Text_SampleFileName:
+		case FLPEventType::FLP_Text_URL:
+		case FLPEventType::FLP_Text_CommentRTF:
+		case FLPEventType::FLP_RegName:
+		case FLPEventType::FLP_Text_DefPluginName:
+		case FLPEventType::FLP_Text_ProjDataPath:
+		case FLPEventType::FLP_Text_PluginName:
+		case FLPEventType::FLP_Text_FXName:
+		case FLPEventType::FLP_Text_TimeMarker:
+		case FLPEventType::FLP_Text_Genre:
+		case FLPEventType::FLP_Text_Author:
+		case FLPEventType::FLP_Text_RemoteCtrlFormula:
+		case FLPEventType::FLP_Text_ChanFilter:
+		case FLPEventType::FLP_Text_PLTrackName:
+			return PayloadKind::string;
+		case FLPEventType::FLP_PatNoteRecChan:
+			return PayloadKind::pattern_notes;
+		case FLPEventType::FLP_PLRecChan:
+			return PayloadKind::playlist_clips;
+		case FLPEventType::FLP_FXRouting:
+			return PayloadKind::fx_routing;
+		default:
+			return PayloadKind::bytes;
+		}
+	}
+}
+
+// whether the event's payload is written with the FLPDataEncoding
+constexpr bool has_opaque_payload(FLPEventType type) noexcept {
+	return static_cast<std::uint8_t>(type) / 64 == 3
+		&& detail::payload_kind(type) == detail::PayloadKind::bytes;
+}
+
 template<bool useWideStr, typename StreamT>
-void stream_flp_event(StreamT& stream, FLPEvent const& e) {
+void stream_flp_event(StreamT& stream, FLPEventView const& e, FLPStreamOptions const& options = {}) {
+	if(options.stats) {
+		auto const begin = FLPStats::clock::now();
+		FLPStreamOptions untimed = options;
+		untimed.stats = nullptr;
+		stream_flp_event<useWideStr>(stream, e, untimed);
+		options.stats->serialize_time += FLPStats::clock::now() - begin;
+		return;
+	}
+	// named after the event type, so that single huge events stand out
+	OM_TRACE_SPAN(flp_event_name(e.type), "event");
+
 	auto const event_id =
 		static_cast<std::underlying_type_t<FLPEventType>>(e.type);
 	auto const event_size = event_id / 64;
@@ -389,41 +728,24 @@ void stream_flp_event(StreamT& stream, FLPEvent const& e) {
 		stream.value(e.i32);
 		break;
 	case 3:
-		switch(e.type) {
-		case FLPEventType::FLP_Version:
+		switch(detail::payload_kind(e.type)) {
+		case detail::PayloadKind::ansi_string:
 			detail::stream_string<false>(stream, e);
 			break;
-		case FLPEventType::FLP_Text_ChanName:
-		case FLPEventType::FLP_Text_PatName:
-		case FLPEventType::FLP_Text_Title:
-		case FLPEventType::FLP_Text_Comment:
-		case FLPEventType::FLP_Text_SampleFileName:
-		case FLPEventType::FLP_Text_URL:
-		case FLPEventType::FLP_Text_CommentRTF:
-		case FLPEventType::FLP_RegName:
-		case FLPEventType::FLP_Text_DefPluginName:
-		case FLPEventType::FLP_Text_ProjDataPath:
-		case FLPEventType::FLP_Text_PluginName:
-		case FLPEventType::FLP_Text_FXName:
-		case FLPEventType::FLP_Text_TimeMarker:
-		case FLPEventType::FLP_Text_Genre:
-		case FLPEventType::FLP_Text_Author:
-		case FLPEventType::FLP_Text_RemoteCtrlFormula:
-		case FLPEventType::FLP_Text_ChanFilter:
-		case FLPEventType::FLP_Text_PLTrackName:
+		case detail::PayloadKind::string:
 			detail::stream_string<useWideStr>(stream, e);
 			break;
-		case FLPEventType::FLP_PatNoteRecChan:
-			detail::stream_pattern_notes(stream, e);
+		case detail::PayloadKind::pattern_notes:
+			detail::stream_pattern_notes(stream, e, options.record_layout);
 			break;
-		case FLPEventType::FLP_PLRecChan:
-			detail::stream_playlist_clips(stream, e);
+		case detail::PayloadKind::playlist_clips:
+			detail::stream_playlist_clips(stream, e, options.record_layout);
 			break;
-		case FLPEventType::FLP_FXRouting:
+		case detail::PayloadKind::fx_routing:
 			detail::stream_fxrouting(stream, e);
 			break;
-		default:
-			detail::stream_bytes(stream, e);
+		case detail::PayloadKind::bytes:
+			detail::stream_bytes(stream, e, options);
 			break;
 		}
 		break;
@@ -432,4 +754,9 @@ void stream_flp_event(StreamT& stream, FLPEvent const& e) {
 	stream.end_object();
 }
 
+template<bool useWideStr, typename StreamT>
+void stream_flp_event(StreamT& stream, FLPEvent const& e, FLPStreamOptions const& options = {}) {
+	stream_flp_event<useWideStr>(stream, e.view(), options);
+}
+
 }
\ No newline at end of file
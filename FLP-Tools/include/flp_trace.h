@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>        // atomic
+#include <chrono>        // steady_clock, nanoseconds
+#include <cstddef>       // size_t
+#include <cstdint>       // int64_t, uint32_t, uint64_t
+#include <memory>        // unique_ptr
+#include <vector>        // vector
+
+// Spans are compiled in with OM_TRACE=1, a profiling build. Otherwise
+// OM_TRACE_SPAN expands to nothing and costs nothing.
+#ifndef OM_TRACE
+#define OM_TRACE 0
+#endif
+
+
+namespace Om {
+
+struct TraceEvent {
+	char const* name;     // must outlive the dump, nullptr for "unknown"
+	char const* category;
+	std::int64_t begin_ns;
+	std::int64_t end_ns;
+};
+
+// The spans of one thread. Only that thread adds to it, so adding is a
+// store and a release increment without locks. When it is full the oldest
+// spans are overwritten.
+class TraceBuffer {
+public:
+	static constexpr std::size_t capacity = std::size_t(1) << 16;
+
+	explicit TraceBuffer(std::uint32_t thread_id) :
+		_events { std::make_unique<TraceEvent[]>(capacity) },
+		_thread_id { thread_id } {
+	}
+
+	TraceBuffer(TraceBuffer const&) = delete;
+	TraceBuffer& operator=(TraceBuffer const&) = delete;
+
+	void add(TraceEvent const& e) noexcept {
+		std::uint64_t const n = _n_added.load(std::memory_order_relaxed);
+		_events[n & (capacity - 1)] = e;
+		_n_added.store(n + 1, std::memory_order_release);
+	}
+
+	// Calls f with the kept spans, oldest first. They are only consistent
+	// if the thread doesn't add spans meanwhile, dump after joining it.
+	template<typename F>
+	void for_each(F&& f) const {
+		std::uint64_t const n = _n_added.load(std::memory_order_acquire);
+		for(std::uint64_t i = n > capacity ? n - capacity : 0; i < n; ++i) {
+			f(_events[i & (capacity - 1)]);
+		}
+	}
+
+	std::uint64_t n_dropped() const noexcept {
+		std::uint64_t const n = _n_added.load(std::memory_order_acquire);
+		return n > capacity ? n - capacity : 0;
+	}
+
+	std::uint32_t thread_id() const noexcept {
+		return _thread_id;
+	}
+
+private:
+	std::unique_ptr<TraceEvent[]> _events;
+	std::atomic<std::uint64_t> _n_added { 0 };
+	std::uint32_t _thread_id;
+};
+
+namespace detail {
+	// creates the buffer of the calling thread, nullptr if out of memory
+	TraceBuffer* register_trace_buffer() noexcept;
+}
+
+inline std::int64_t trace_now_ns() noexcept {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline TraceBuffer* this_thread_trace_buffer() noexcept {
+	thread_local TraceBuffer* const buffer = detail::register_trace_buffer();
+	return buffer;
+}
+
+// the buffers of every thread that traced so far, they are never freed
+std::vector<TraceBuffer const*> trace_buffers();
+
+// Adds a span from its construction to its destruction to the buffer of
+// the thread. Use OM_TRACE_SPAN instead so that it is compiled out.
+class TraceSpan {
+public:
+	TraceSpan(char const* name, char const* category) noexcept :
+		_name { name },
+		_category { category },
+		_begin_ns { trace_now_ns() } {
+	}
+
+	TraceSpan(TraceSpan const&) = delete;
+	TraceSpan& operator=(TraceSpan const&) = delete;
+
+	~TraceSpan() {
+		if(TraceBuffer* const buffer = this_thread_trace_buffer())
+			buffer->add({ _name, _category, _begin_ns, trace_now_ns() });
+	}
+
+private:
+	char const* _name;
+	char const* _category;
+	std::int64_t _begin_ns;
+};
+
+// Writes the spans of all threads as a Chrome trace event file, which
+// chrome://tracing and Perfetto open. Times start at the first span.
+template<typename StreamT>
+void stream_chrome_trace(StreamT& stream) {
+	std::vector<TraceBuffer const*> const buffers = trace_buffers();
+	std::int64_t origin_ns = INT64_MAX;
+	std::uint64_t n_dropped = 0;
+	for(TraceBuffer const* buffer : buffers) {
+		buffer->for_each([&](TraceEvent const& e) {
+			if(e.begin_ns < origin_ns)
+				origin_ns = e.begin_ns;
+		});
+		n_dropped += buffer->n_dropped();
+	}
+
+	stream.begin_object();
+	stream.key("traceEvents");
+	stream.begin_array();
+	// complete events in microseconds, a thread is a track
+	for(TraceBuffer const* buffer : buffers) {
+		buffer->for_each([&](TraceEvent const& e) {
+			stream.begin_object();
+			stream.key("name");
+			stream.value_str_noescape(e.name ? e.name : "unknown");
+			stream.key("cat");
+			stream.value_str_noescape(e.category);
+			stream.key("ph");
+			stream.value_str_noescape("X");
+			stream.key("ts");
+			stream.value(static_cast<double>(e.begin_ns - origin_ns) / 1000.0);
+			stream.key("dur");
+			stream.value(static_cast<double>(e.end_ns - e.begin_ns) / 1000.0);
+			stream.key("pid");
+			stream.value(1);
+			stream.key("tid");
+			stream.value(buffer->thread_id());
+			stream.end_object();
+		});
+	}
+	stream.end_array();
+	stream.key("displayTimeUnit");
+	stream.value_str_noescape("ns");
+	stream.key("otherData");
+	stream.begin_object();
+	stream.key("dropped_spans");
+	stream.value(n_dropped);
+	stream.end_object();
+	stream.end_object();
+}
+
+}
+
+#if OM_TRACE
+#define OM_TRACE_CONCAT_IMPL(a, b) a##b
+#define OM_TRACE_CONCAT(a, b) OM_TRACE_CONCAT_IMPL(a, b)
+// traces the rest of the enclosing scope, name and category must be string literals or otherwise static
+#define OM_TRACE_SPAN(name, category) ::Om::TraceSpan OM_TRACE_CONCAT(om_trace_span_, __LINE__)((name), (category))
+#else
+#define OM_TRACE_SPAN(name, category) ((void)0)
+#endif
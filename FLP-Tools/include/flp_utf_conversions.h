@@ -1,12 +1,47 @@
-#pragma once
-
-#include <system_error>
-#include <string>
-#include <string_view>
-
-
-namespace Om {
-	
-std::error_code utf16_to_utf8(std::wstring_view str16, std::string* out_strutf8);
-
-}
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <system_error>
+#include <string>
+#include <string_view>
+
+
+namespace Om {
+
+struct CPUFeatures;
+
+// FL Studio stores text as little endian UTF-16 from version 12 on. These
+// work on char16_t on every platform, wchar_t is 4 bytes outside of Windows.
+
+constexpr bool is_utf16_high_surrogate(char16_t c) noexcept {
+	return (c & 0xFC00) == 0xD800;
+}
+
+// Strings in FLP payloads are not aligned, code units are read through this.
+inline char16_t load_utf16_unit(char16_t const* p) noexcept {
+	char16_t c;
+	std::memcpy(&c, p, sizeof(c));
+	return c;
+}
+
+// Upper bound of the UTF-8 length of n_units UTF-16 code units.
+constexpr std::size_t utf8_max_length(std::size_t n_units) noexcept {
+	return n_units * 3;
+}
+
+// Writes str16 as UTF-8 to out, which needs room for
+// utf8_max_length(str16.size()) chars, and stores the number of chars
+// written in *n_written. Unpaired surrogates are an error, the chars before
+// them are written anyway. Uses SSE2 or AVX2 where available.
+std::error_code utf16_to_utf8(std::u16string_view str16, char* out, std::size_t* n_written) noexcept;
+
+// The same with the kernel that features selects, which must be a subset of
+// cpu_features(). Without AVX2 that is the SSE2 one on x86.
+std::error_code utf16_to_utf8(std::u16string_view str16, char* out, std::size_t* n_written,
+                              CPUFeatures const& features) noexcept;
+
+std::error_code utf16_to_utf8(std::u16string_view str16, std::string* out_strutf8);
+std::error_code utf8_to_utf16(std::string_view strutf8, std::u16string* out_str16);
+
+}
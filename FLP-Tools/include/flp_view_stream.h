@@ -0,0 +1,223 @@
+#pragma once
+
+#include "flp_stream.h"
+#include "flp_mapped_file.h"
+
+#include <cassert>       // assert
+#include <climits>       // CHAR_BIT
+#include <cstring>       // memcpy
+#include <filesystem>    // path
+#include <span>          // span
+#include <stdexcept>     // runtime_error
+#include <system_error>  // system_error
+
+
+namespace Om {
+
+// Decodes the events of an flp file that is completely in memory.
+// Events are FLPEventViews whose payload points into the decoded memory,
+// no allocations or copies are made while iterating.
+class FLPViewInStream {
+public:
+	explicit FLPViewInStream(std::span<std::byte const> file_data) :
+		_end { file_data.data() + file_data.size() },
+		_pos { file_data.data() } {
+		read_headers();
+		++(*this);
+	}
+
+	FLPViewInStream(FLPViewInStream const&) = delete;
+	FLPViewInStream& operator=(FLPViewInStream const&) = delete;
+
+	bool has_event() const noexcept {
+		return _has_event;
+	}
+
+	FLPEventView const* operator->() const& noexcept {
+		return &_current_event;
+	}
+
+	FLPEventView const& operator*() const& noexcept {
+		return _current_event;
+	}
+
+	// Only events whose type is in mask are visited from now on, the
+	// current event is skipped too if it isn't in the mask. Segments get
+	// the mask of the stream they were made from.
+	void set_event_mask(FLPEventMask const& mask) {
+		_event_mask = mask;
+		if(_has_event && !_event_mask.test(_current_event.type))
+			++(*this);
+	}
+
+	// Events visited from now on are counted in stats and the time to
+	// decode them is added, the current event is counted right away.
+	// Segments don't inherit it. Passing nullptr stops measuring.
+	void set_stats(FLPStats* stats) noexcept {
+		_stats = stats;
+		if(_stats && _has_event)
+			_stats->add_event(_current_event);
+	}
+
+	FLPViewInStream& operator++() {
+		OM_TRACE_SPAN("decode", "flp");
+		if(_stats) {
+			auto const begin = FLPStats::clock::now();
+			read_next_event();
+			_stats->decode_time += FLPStats::clock::now() - begin;
+			if(_has_event)
+				_stats->add_event(_current_event);
+			return *this;
+		}
+		read_next_event();
+		return *this;
+	}
+
+	FLPFileHeader const& file_header() const& noexcept {
+		return _file_header;
+	}
+
+	FLPChunkHeader const& data_header() const& noexcept {
+		return _data_header;
+	}
+
+	// offset of the end of the current event in the data chunk
+	std::size_t data_position() const noexcept {
+		return static_cast<std::size_t>(_pos - _data_begin);
+	}
+
+	// Stream over the events between the offsets begin and end in the data
+	// chunk, both have to be event boundaries as given by data_position().
+	FLPViewInStream segment(std::size_t begin, std::size_t end) const {
+		assert(begin <= end && end <= _data_header.Length);
+		return FLPViewInStream(*this, begin, end);
+	}
+
+private:
+	FLPViewInStream(FLPViewInStream const& whole, std::size_t begin, std::size_t end) :
+		_end { whole._end },
+		_pos { whole._data_begin + begin },
+		_data_begin { whole._data_begin },
+		_data_end_offset { end },
+		_event_mask { whole._event_mask },
+		_file_header { whole._file_header },
+		_data_header { whole._data_header } {
+		++(*this);
+	}
+
+	void read_next_event() {
+		do {
+			read_event();
+		} while(_has_event && !_event_mask.test(_current_event.type));
+	}
+
+	void read_event() {
+		if(data_position() >= _data_end_offset) {
+			_has_event = false;
+			return;
+		}
+
+		std::uint8_t event_id = 0;
+		read_value(&event_id);
+		_current_event.type = static_cast<FLPEventType>(event_id);
+
+		switch(event_id / 64) {
+		case 0:
+			read_value(&_current_event.u8);
+			break;
+		case 1:
+			read_value(&_current_event.i16);
+			break;
+		case 2:
+			read_value(&_current_event.i32);
+			break;
+		case 3:
+		{ // TEXT event
+			std::uint32_t text_size = 0;
+			std::uint8_t current_byte;
+			std::uint32_t shift_by = 0;
+			do { // extract size
+				 // left shift by more is undefined behaviour
+				if(shift_by >= sizeof(shift_by) * CHAR_BIT)
+					throw std::runtime_error { "Invalid event size!" };
+				read_value(&current_byte);
+				text_size += ((current_byte & std::uint8_t(0x7FU)) << shift_by);
+				shift_by += 7;
+			} while(current_byte & 0x80U);
+
+			if(static_cast<std::size_t>(_end - _pos) < text_size)
+				failed_read();
+			_current_event.data = { _pos, text_size };
+			_pos += text_size;
+			break;
+		}
+		}
+	}
+
+	void read_headers() {
+		OM_TRACE_SPAN("read_headers", "flp");
+		// read flp header
+		read_value(&_file_header);
+		if(!detail::check_chunkID(_file_header.header.ChunkID, "FLhd"))
+			throw std::runtime_error { "Not an FLP file!" };
+
+		// read data header
+		read_value(&_data_header);
+		if(!detail::check_chunkID(_data_header.ChunkID, "FLdt"))
+			throw std::runtime_error { "Invalid data header!" };
+
+		_data_begin = _pos;
+		_data_end_offset = _data_header.Length;
+	}
+
+	template<typename T>
+	void read_value(T* target) {
+		if(static_cast<std::size_t>(_end - _pos) < sizeof(T))
+			failed_read();
+		std::memcpy(target, _pos, sizeof(T));
+		_pos += sizeof(T);
+	}
+
+	[[noreturn]]
+	static void failed_read() {
+		throw std::runtime_error { "Unexpected end of file!" };
+	}
+
+	FLPEventView _current_event {};
+	std::byte const* _end;
+	std::byte const* _pos;
+	std::byte const* _data_begin = nullptr;
+	std::size_t _data_end_offset = 0;
+	bool _has_event = true;
+	FLPEventMask _event_mask = FLPEventMask::all();
+	FLPStats* _stats = nullptr;
+	FLPFileHeader _file_header {};
+	FLPChunkHeader _data_header {};
+};
+
+namespace detail {
+
+	struct MappedFileHolder {
+		explicit MappedFileHolder(std::filesystem::path const& path) {
+			if(std::error_code err = mapped_file.open(path))
+				throw std::system_error(err);
+		}
+
+		MappedFile mapped_file;
+	};
+}
+
+// FLPViewInStream over a memory mapped file
+class FLPMappedInStream : private detail::MappedFileHolder, public FLPViewInStream {
+public:
+	explicit FLPMappedInStream(std::filesystem::path const& path) :
+		detail::MappedFileHolder(path),
+		FLPViewInStream(mapped_file.data()) {
+	}
+
+	std::span<std::byte const> file_data() const noexcept {
+		return mapped_file.data();
+	}
+};
+
+}
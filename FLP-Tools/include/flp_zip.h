@@ -0,0 +1,156 @@
+#pragma once
+
+#include "flp_inflate.h"
+#include "flp_mapped_file.h"
+
+#include <cassert>       // assert
+#include <cstddef>       // byte, size_t
+#include <cstdint>       // uint16_t, uint32_t, uint64_t
+#include <cstring>       // memcpy, memmove
+#include <filesystem>    // path
+#include <memory>        // unique_ptr
+#include <optional>      // optional
+#include <span>          // span
+#include <string>        // string
+#include <type_traits>   // is_trivially_copyable
+#include <vector>        // vector
+
+
+namespace Om {
+
+// an entry of the central directory of a zip archive
+struct ZipEntry {
+	std::string name; // as stored, '/' separated
+	std::uint16_t flags = 0;
+	std::uint16_t method = 0; // 0 stored, 8 deflate
+	std::uint32_t crc32 = 0;
+	std::uint64_t compressed_size = 0;
+	std::uint64_t uncompressed_size = 0;
+	std::uint64_t local_header_offset = 0;
+};
+
+// Reads the central directory of a zip archive in memory, zip64 archives
+// included. Returns nullopt if archive isn't a zip file or the directory is
+// damaged.
+std::optional<std::vector<ZipEntry>> read_zip_directory(std::span<std::byte const> archive);
+
+// the compressed data of entry, nullopt if its local header is damaged
+std::optional<std::span<std::byte const>> zip_entry_data(std::span<std::byte const> archive, ZipEntry const& entry);
+
+// Reads the .flp file in a zip archive, such as an FL Studio zipped loop
+// package, and decompresses it while it is read. This is a stream type for
+// FLPInStream:
+//   FLPInStream<ZipInFile> flp(path);
+// The archive is memory mapped, the project is decoded through a buffer
+// that works like the one of BufferedInFile, so it is never extracted as a
+// whole. Its CRC-32 is checked when the end of the entry is reached.
+class ZipInFile {
+public:
+	static constexpr std::size_t default_buffer_size = std::size_t(1) << 16;
+
+	// throws if the archive can't be read or has no usable .flp file
+	explicit ZipInFile(std::filesystem::path const& path, std::size_t buffer_size = default_buffer_size);
+
+	ZipInFile(ZipInFile const&) = delete;
+	ZipInFile& operator=(ZipInFile const&) = delete;
+
+	template<typename OutT>
+	bool read(OutT* target) {
+		static_assert(std::is_trivially_copyable<OutT>::value, "OutT must be trivially copyable!");
+		if(available() < sizeof(OutT) && !refill(sizeof(OutT)))
+			return false;
+		std::memcpy(target, _position, sizeof(OutT));
+		_position += sizeof(OutT);
+		return true;
+	}
+
+	template<typename OutT>
+	std::size_t read(OutT target[], std::size_t num_elems) {
+		static_assert(std::is_trivially_copyable<OutT>::value, "OutT must be trivially copyable!");
+		std::size_t const size = sizeof(OutT) * num_elems;
+		auto* out = reinterpret_cast<std::byte*>(target);
+		std::size_t const buffered = available() < size ? available() : size;
+		std::memcpy(out, _position, buffered);
+		_position += buffered;
+		std::size_t done = buffered;
+		if(done < size) {
+			std::size_t const rest = size - done;
+			if(rest >= _buffer_size) {
+				// too large for the buffer, decode directly into the target
+				done += decode(out + done, rest);
+			} else if(refill(rest)) {
+				std::memcpy(out + done, _position, rest);
+				_position += rest;
+				done += rest;
+			}
+		}
+		return done / sizeof(OutT);
+	}
+
+	// compressed data can't be seeked, skipped bytes are decoded and dropped
+	bool skip(std::size_t size) {
+		while(size > 0) {
+			if(available() == 0 && !refill(1))
+				return false;
+			std::size_t const n = available() < size ? available() : size;
+			_position += n;
+			size -= n;
+		}
+		return true;
+	}
+
+	// name of the .flp file in the archive
+	std::string const& entry_name() const noexcept {
+		return _entry.name;
+	}
+
+	bool error() const noexcept {
+		return _error;
+	}
+
+	static char const* errmsg(bool is_error) noexcept {
+		return is_error ? "Damaged .flp file in the zip archive!" : "Unexpected end of file!";
+	}
+
+private:
+	std::size_t available() const noexcept {
+		return static_cast<std::size_t>(_end - _position);
+	}
+
+	// moves the unread rest to the front and fills the remaining buffer,
+	// returns whether at least min_size bytes are available afterwards
+	bool refill(std::size_t min_size) {
+		assert(min_size <= _buffer_size);
+		std::size_t const rest = available();
+		std::memmove(_buffer.get(), _position, rest);
+		_position = _buffer.get();
+		_end = _position + rest;
+		while(available() < min_size) {
+			std::size_t const n = decode(_end, _buffer_size - available());
+			if(n == 0)
+				return false;
+			_end += n;
+		}
+		return true;
+	}
+
+	// Decompresses up to size bytes of the entry. Once its end is reached
+	// the size and checksum are compared, on a mismatch nothing is returned.
+	std::size_t decode(std::byte* out, std::size_t size);
+
+	MappedFile _archive;
+	ZipEntry _entry;
+	std::span<std::byte const> _stored; // the rest of a stored entry
+	std::optional<Inflater> _inflater;  // set for deflated entries
+	std::uint32_t _crc32 = 0;
+	std::uint64_t _n_decoded = 0;
+	bool _is_complete = false;
+	bool _error = false;
+
+	std::unique_ptr<std::byte[]> _buffer;
+	std::size_t _buffer_size;
+	std::byte* _position = nullptr;
+	std::byte* _end = nullptr;
+};
+
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Om {
+
+// Thread pool where every worker has its own task queue. Workers take tasks
+// from the front of their own queue and steal from the back of the other
+// queues when theirs is empty. Tasks must not throw.
+class WorkStealingPool {
+public:
+	using Task = std::function<void()>;
+
+	explicit WorkStealingPool(std::size_t n_threads) {
+		assert(n_threads > 0);
+		m_queues.reserve(n_threads);
+		for(std::size_t i = 0; i < n_threads; ++i) {
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+		}
+		m_threads.reserve(n_threads);
+		for(std::size_t i = 0; i < n_threads; ++i) {
+			m_threads.emplace_back([this, i] { run(i); });
+		}
+	}
+
+	WorkStealingPool(WorkStealingPool const&) = delete;
+	WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+	~WorkStealingPool() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_work_available.notify_all();
+		for(auto& thread : m_threads) {
+			thread.join();
+		}
+	}
+
+	std::size_t size() const noexcept {
+		return m_threads.size();
+	}
+
+	// tasks are distributed round robin over the worker queues
+	void submit(Task task) {
+		std::size_t const worker = m_next_queue++ % m_queues.size();
+		{
+			// count first, so the task can't finish before it is counted
+			std::lock_guard<std::mutex> lock(m_mutex);
+			++m_queued;
+			++m_pending;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_queues[worker]->mutex);
+			m_queues[worker]->tasks.push_back(std::move(task));
+		}
+		m_work_available.notify_one();
+	}
+
+	// blocks until all submitted tasks are done
+	void wait() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_all_done.wait(lock, [this] { return m_pending == 0; });
+	}
+
+private:
+	struct WorkerQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	bool try_pop(std::size_t self, Task& task) {
+		{
+			WorkerQueue& own = *m_queues[self];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if(!own.tasks.empty()) {
+				task = std::move(own.tasks.front());
+				own.tasks.pop_front();
+				--m_queued;
+				return true;
+			}
+		}
+		for(std::size_t i = 1; i < m_queues.size(); ++i) {
+			WorkerQueue& victim = *m_queues[(self + i) % m_queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if(!victim.tasks.empty()) {
+				task = std::move(victim.tasks.back());
+				victim.tasks.pop_back();
+				--m_queued;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void run(std::size_t self) {
+		for(;;) {
+			Task task;
+			if(try_pop(self, task)) {
+				task();
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if(--m_pending == 0) {
+					m_all_done.notify_all();
+				}
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_work_available.wait(lock, [this] { return m_stop || m_queued > 0; });
+			if(m_stop && m_queued == 0) {
+				return;
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+	std::vector<std::thread> m_threads;
+	std::atomic<std::size_t> m_next_queue { 0 };
+	std::atomic<std::size_t> m_queued { 0 };  // tasks in the queues
+	std::size_t m_pending = 0;                 // tasks queued or running
+	bool m_stop = false;
+	std::mutex m_mutex;
+	std::condition_variable m_work_available;
+	std::condition_variable m_all_done;
+};
+
+} // namespace Om
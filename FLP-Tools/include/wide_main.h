@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef _WIN32
+
+#include <clocale>    // setlocale
+#include <cstdio>     // fprintf
+#include <cstdlib>    // mbstowcs, EXIT_FAILURE
+#include <string>     // wstring
+#include <vector>     // vector
+
+
+namespace Om {
+
+// The tools parse their options as wide strings like on Windows, elsewhere
+// main converts the arguments from the locale's encoding and calls this.
+inline int call_wmain(int argc, char* argv[], int (*wmain)(int, wchar_t*[])) {
+	std::setlocale(LC_CTYPE, "");
+	std::vector<std::wstring> wide_args;
+	std::vector<wchar_t*> wide_argv;
+	wide_args.reserve(argc);
+	for(int i = 0; i < argc; ++i) {
+		std::size_t const n = std::mbstowcs(nullptr, argv[i], 0);
+		if(n == static_cast<std::size_t>(-1)) {
+			std::fprintf(stderr, "Invalid argument encoding: %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+		std::wstring& arg = wide_args.emplace_back(n, L'\0');
+		std::mbstowcs(arg.data(), argv[i], n + 1);
+	}
+	for(std::wstring& arg : wide_args) {
+		wide_argv.push_back(arg.data());
+	}
+	wide_argv.push_back(nullptr);
+	return wmain(argc, wide_argv.data());
+}
+
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "flp_base64.h"
+
+#include <cassert>       // assert
+#include <cstdint>       // uint32_t, uint8_t
+#include <cstring>       // memcpy
+
+
+namespace Om {
+
+namespace {
+
+	constexpr char base64_alphabet[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	// encodes the group of up to 3 bytes that starts at data[0]
+	inline void encode_group(std::byte const* data, std::size_t n, char* out) noexcept {
+		std::uint32_t bits = static_cast<std::uint32_t>(data[0]) << 16;
+		if(n > 1)
+			bits |= static_cast<std::uint32_t>(data[1]) << 8;
+		if(n > 2)
+			bits |= static_cast<std::uint32_t>(data[2]);
+		out[0] = base64_alphabet[(bits >> 18) & 0x3F];
+		out[1] = base64_alphabet[(bits >> 12) & 0x3F];
+		out[2] = n > 1 ? base64_alphabet[(bits >> 6) & 0x3F] : '=';
+		out[3] = n > 2 ? base64_alphabet[bits & 0x3F] : '=';
+	}
+
+	inline std::size_t group_size(std::size_t n_bytes, std::size_t group) noexcept {
+		std::size_t const rest = n_bytes - group * 3;
+		return rest < 3 ? rest : 3;
+	}
+
+}
+
+void base64_encode(std::span<std::byte const> data, std::size_t first_char,
+                   std::size_t n_chars, char* out) noexcept {
+	assert(first_char + n_chars <= base64_length(data.size()));
+	std::byte const* const bytes = data.data();
+	std::size_t group = first_char / 4;
+	std::size_t skip = first_char % 4;
+	char group_chars[4];
+	while(n_chars > 0) {
+		std::size_t const n = (4 - skip < n_chars ? 4 - skip : n_chars);
+		if(n == 4) {
+			encode_group(bytes + group * 3, group_size(data.size(), group), out);
+		} else {
+			// group split between two pieces
+			encode_group(bytes + group * 3, group_size(data.size(), group), group_chars);
+			std::memcpy(out, group_chars + skip, n);
+		}
+		out += n;
+		n_chars -= n;
+		skip = 0;
+		++group;
+	}
+}
+
+}
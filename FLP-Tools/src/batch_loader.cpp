@@ -0,0 +1,683 @@
+#include "flp_batch_loader.h"
+
+#include <algorithm>           // clamp, find, max, min
+#include <atomic>              // atomic, atomic_ref
+#include <condition_variable>  // condition_variable
+#include <cstdint>             // int32_t, uint64_t
+#include <deque>               // deque
+#include <initializer_list>    // initializer_list
+#include <mutex>               // mutex, unique_lock
+#include <new>                 // bad_alloc
+#include <thread>              // thread
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define OM_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define OM_HAS_IO_URING 0
+#endif
+
+
+namespace Om {
+
+std::string_view file_loader_backend_name(FileLoaderBackend backend) noexcept {
+	switch(backend) {
+	case FileLoaderBackend::automatic: return "auto";
+	case FileLoaderBackend::io_uring:  return "io_uring";
+	case FileLoaderBackend::pread:     return "pread";
+	}
+	return "unknown";
+}
+
+namespace {
+
+	std::unique_ptr<std::byte[]> allocate_file_data(std::size_t size) noexcept {
+		try {
+			return std::make_unique_for_overwrite<std::byte[]>(size);
+		} catch(std::bad_alloc const&) {
+			return nullptr;
+		}
+	}
+
+	// Reads a file unless it is larger than max_file_size, reserve(size) is
+	// called before the data is allocated and false cancels the read.
+#ifdef _WIN32
+
+	template<typename ReserveF>
+	LoadedFile read_whole_file(std::filesystem::path const& path, std::size_t index, std::size_t max_file_size,
+	                           ReserveF const& reserve) noexcept {
+		LoadedFile file;
+		file.index = index;
+
+		HANDLE const handle = ::CreateFileW(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr
+		);
+		if(handle == INVALID_HANDLE_VALUE) {
+			file.error = std::error_code(::GetLastError(), std::system_category());
+			return file;
+		}
+
+		LARGE_INTEGER file_size;
+		if(!::GetFileSizeEx(handle, &file_size)) {
+			file.error = std::error_code(::GetLastError(), std::system_category());
+		} else if(static_cast<unsigned long long>(file_size.QuadPart) > max_file_size) {
+			file.error = std::make_error_code(std::errc::file_too_large);
+		} else if(file_size.QuadPart != 0 && !reserve(static_cast<std::size_t>(file_size.QuadPart))) {
+			file.error = std::make_error_code(std::errc::operation_canceled);
+		} else if(file_size.QuadPart != 0) {
+			std::size_t const size = static_cast<std::size_t>(file_size.QuadPart);
+			file.data = allocate_file_data(size);
+			if(!file.data) {
+				file.error = std::make_error_code(std::errc::not_enough_memory);
+			}
+			while(file.data && file.size < size) {
+				DWORD const n_wanted = static_cast<DWORD>(std::min<std::size_t>(size - file.size, 1U << 30));
+				DWORD n_read = 0;
+				if(!::ReadFile(handle, file.data.get() + file.size, n_wanted, &n_read, nullptr)) {
+					file.error = std::error_code(::GetLastError(), std::system_category());
+					file.data.reset();
+					file.size = 0;
+				} else if(n_read == 0) {
+					break; // the file got shorter
+				} else {
+					file.size += n_read;
+				}
+			}
+		}
+		::CloseHandle(handle);
+		return file;
+	}
+
+#else
+
+	template<typename ReserveF>
+	LoadedFile read_whole_file(std::filesystem::path const& path, std::size_t index, std::size_t max_file_size,
+	                           ReserveF const& reserve) noexcept {
+		LoadedFile file;
+		file.index = index;
+
+		int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if(fd == -1) {
+			file.error = std::error_code(errno, std::generic_category());
+			return file;
+		}
+
+		struct stat st;
+		if(::fstat(fd, &st) != 0) {
+			file.error = std::error_code(errno, std::generic_category());
+		} else if(!S_ISREG(st.st_mode)) {
+			file.error = std::make_error_code(std::errc::not_supported);
+		} else if(static_cast<std::uint64_t>(st.st_size) > max_file_size) {
+			file.error = std::make_error_code(std::errc::file_too_large);
+		} else if(st.st_size != 0 && !reserve(static_cast<std::size_t>(st.st_size))) {
+			file.error = std::make_error_code(std::errc::operation_canceled);
+		} else if(st.st_size != 0) {
+			std::size_t const size = static_cast<std::size_t>(st.st_size);
+			file.data = allocate_file_data(size);
+			if(!file.data) {
+				file.error = std::make_error_code(std::errc::not_enough_memory);
+			}
+			while(file.data && file.size < size) {
+				ssize_t const n = ::pread(fd, file.data.get() + file.size, size - file.size, static_cast<off_t>(file.size));
+				if(n < 0 && errno == EINTR) {
+					continue;
+				}
+				if(n < 0) {
+					file.error = std::error_code(errno, std::generic_category());
+					file.data.reset();
+					file.size = 0;
+				} else if(n == 0) {
+					break; // the file got shorter
+				} else {
+					file.size += static_cast<std::size_t>(n);
+				}
+			}
+		}
+		::close(fd);
+		return file;
+	}
+
+#endif
+
+#if OM_HAS_IO_URING
+
+	// Just the part of io_uring the loader needs, on the system calls as
+	// there's no liburing to depend on. One thread submits and reaps.
+	class IoUring {
+	public:
+		IoUring() = default;
+		IoUring(IoUring const&) = delete;
+		IoUring& operator=(IoUring const&) = delete;
+
+		~IoUring() {
+			if(_sqes)
+				::munmap(_sqes, _sqes_size);
+			if(_cq_ring && _cq_ring != _sq_ring)
+				::munmap(_cq_ring, _cq_ring_size);
+			if(_sq_ring)
+				::munmap(_sq_ring, _sq_ring_size);
+			if(_fd != -1)
+				::close(_fd);
+		}
+
+		// false if the kernel has no io_uring, it is disabled or lacks one
+		// of the operations needed
+		bool open(unsigned entries) noexcept {
+			io_uring_params params {};
+			params.flags = IORING_SETUP_CQSIZE;
+			params.cq_entries = entries * 2;
+			int const fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+			if(fd < 0)
+				return false;
+			_fd = fd;
+
+			if(!supports({ IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE }))
+				return false;
+
+			_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			bool const single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if(single_mmap)
+				_sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+
+			_sq_ring = map(_sq_ring_size, IORING_OFF_SQ_RING);
+			if(!_sq_ring)
+				return false;
+			_cq_ring = single_mmap ? _sq_ring : map(_cq_ring_size, IORING_OFF_CQ_RING);
+			if(!_cq_ring)
+				return false;
+			_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+			_sqes = static_cast<io_uring_sqe*>(map(_sqes_size, IORING_OFF_SQES));
+			if(!_sqes)
+				return false;
+
+			auto* const sq = static_cast<std::byte*>(_sq_ring);
+			_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+			_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+			_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+			auto* const cq = static_cast<std::byte*>(_cq_ring);
+			_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+			_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+			_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+			_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+			_sqe_tail = std::atomic_ref<unsigned>(*_sq_tail).load(std::memory_order_relaxed);
+			return true;
+		}
+
+		// a cleared entry to fill in, the caller makes sure there is room
+		io_uring_sqe& next_sqe() noexcept {
+			unsigned const i = _sqe_tail & _sq_mask;
+			_sq_array[i] = i;
+			io_uring_sqe& sqe = _sqes[i];
+			sqe = {};
+			++_sqe_tail;
+			++_n_to_submit;
+			return sqe;
+		}
+
+		// submits the new entries and waits for a completion
+		std::error_code submit_and_wait() noexcept {
+			std::atomic_ref<unsigned>(*_sq_tail).store(_sqe_tail, std::memory_order_release);
+			for(;;) {
+				long const ret = ::syscall(__NR_io_uring_enter, _fd, _n_to_submit, 1U, IORING_ENTER_GETEVENTS, nullptr, 0);
+				if(ret >= 0) {
+					_n_to_submit -= static_cast<unsigned>(ret);
+					return {};
+				}
+				// out of resources for the moment
+				if(errno == EAGAIN || errno == EBUSY)
+					std::this_thread::yield();
+				else if(errno != EINTR)
+					return std::error_code(errno, std::generic_category());
+			}
+		}
+
+		// calls f with the result and user data of every completion so far
+		template<typename F>
+		void for_each_completion(F&& f) {
+			std::atomic_ref<unsigned> head(*_cq_head);
+			unsigned const tail = std::atomic_ref<unsigned>(*_cq_tail).load(std::memory_order_acquire);
+			for(unsigned i = head.load(std::memory_order_relaxed); i != tail; ++i) {
+				io_uring_cqe const& cqe = _cqes[i & _cq_mask];
+				std::int32_t const res = cqe.res;
+				std::uint64_t const user_data = cqe.user_data;
+				head.store(i + 1, std::memory_order_release);
+				f(res, user_data);
+			}
+		}
+
+	private:
+		bool supports(std::initializer_list<unsigned> ops) const noexcept {
+			constexpr unsigned n_probe_ops = 256;
+			std::unique_ptr<std::byte[]> buffer(new(std::nothrow) std::byte[sizeof(io_uring_probe) + n_probe_ops * sizeof(io_uring_probe_op)] {});
+			if(!buffer)
+				return false;
+			auto* const probe = reinterpret_cast<io_uring_probe*>(buffer.get());
+			if(::syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PROBE, probe, n_probe_ops) < 0)
+				return false;
+			for(unsigned op : ops) {
+				if(op > probe->last_op || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0)
+					return false;
+			}
+			return true;
+		}
+
+		void* map(std::size_t size, std::uint64_t offset) const noexcept {
+			void* const p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, static_cast<off_t>(offset));
+			return p == MAP_FAILED ? nullptr : p;
+		}
+
+		int _fd = -1;
+		void* _sq_ring = nullptr;
+		void* _cq_ring = nullptr;
+		std::size_t _sq_ring_size = 0;
+		std::size_t _cq_ring_size = 0;
+		io_uring_sqe* _sqes = nullptr;
+		std::size_t _sqes_size = 0;
+
+		unsigned* _sq_tail = nullptr;
+		unsigned* _sq_array = nullptr;
+		unsigned _sq_mask = 0;
+		unsigned _sqe_tail = 0;
+		unsigned _n_to_submit = 0;
+		unsigned* _cq_head = nullptr;
+		unsigned* _cq_tail = nullptr;
+		unsigned _cq_mask = 0;
+		io_uring_cqe* _cqes = nullptr;
+	};
+
+	// A file being loaded through the ring, it has one request in flight at
+	// a time, so the ring never has more entries than files.
+	struct UringFile {
+		// wait_for_bytes is the only step without a request
+		enum class Step { open, stat, wait_for_bytes, read, close };
+
+		Step step = Step::open;
+		int fd = -1;
+		struct statx stx;
+		LoadedFile file;
+		std::size_t size = 0; // from statx, file.size is what was read so far
+	};
+
+#endif
+
+}
+
+struct BatchFileLoader::State {
+	std::vector<std::filesystem::path> paths;
+	FileLoaderBackend backend;
+	std::size_t max_files_in_flight;
+	std::size_t max_bytes_in_flight;
+	std::size_t max_file_size;
+
+	std::mutex mutex;
+	std::condition_variable file_loaded;
+	std::condition_variable slot_freed;
+	std::condition_variable bytes_freed;
+	std::deque<LoadedFile> loaded;
+	std::size_t n_free_slots;   // for files that are read or wait in loaded
+	std::size_t bytes_in_flight = 0;
+	std::vector<std::size_t> reserved_bytes; // per path, given back by next()
+	std::size_t n_returned = 0;
+	bool stopping = false;
+
+	std::atomic<std::size_t> next_pread_index { 0 };
+	std::vector<std::thread> threads;
+
+	// Blocks until another file may be loaded, false when the loader is
+	// destroyed meanwhile.
+	bool acquire_slot() {
+		std::unique_lock lock(mutex);
+		slot_freed.wait(lock, [this] { return stopping || n_free_slots != 0; });
+		if(stopping)
+			return false;
+		--n_free_slots;
+		return true;
+	}
+
+	bool try_acquire_slot() {
+		std::lock_guard lock(mutex);
+		if(stopping || n_free_slots == 0)
+			return false;
+		--n_free_slots;
+		return true;
+	}
+
+	bool fits(std::size_t size) const noexcept {
+		return bytes_in_flight == 0
+		    || (bytes_in_flight < max_bytes_in_flight && size <= max_bytes_in_flight - bytes_in_flight);
+	}
+
+	// Blocks until size more bytes may be read for the file at index, false
+	// when the loader is destroyed meanwhile.
+	bool reserve_bytes(std::size_t index, std::size_t size) {
+		std::unique_lock lock(mutex);
+		bytes_freed.wait(lock, [&] { return stopping || fits(size); });
+		if(stopping)
+			return false;
+		bytes_in_flight += size;
+		reserved_bytes[index] = size;
+		return true;
+	}
+
+	bool try_reserve_bytes(std::size_t index, std::size_t size) {
+		std::lock_guard lock(mutex);
+		if(stopping || !fits(size))
+			return false;
+		bytes_in_flight += size;
+		reserved_bytes[index] = size;
+		return true;
+	}
+
+	void release_slot() {
+		{
+			std::lock_guard lock(mutex);
+			++n_free_slots;
+		}
+		slot_freed.notify_one();
+	}
+
+	void add_loaded(LoadedFile file) {
+		{
+			std::lock_guard lock(mutex);
+			loaded.push_back(std::move(file));
+		}
+		file_loaded.notify_one();
+	}
+
+	void run_pread() {
+		while(acquire_slot()) {
+			std::size_t const i = next_pread_index.fetch_add(1, std::memory_order_relaxed);
+			if(i >= paths.size()) {
+				release_slot();
+				return;
+			}
+			add_loaded(read_whole_file(paths[i], i, max_file_size, [&](std::size_t size) { return reserve_bytes(i, size); }));
+		}
+	}
+
+#if OM_HAS_IO_URING
+
+	void run_io_uring(IoUring& ring) {
+		std::vector<UringFile> files(max_files_in_flight);
+		std::vector<std::size_t> idle_files(max_files_in_flight);
+		for(std::size_t i = 0; i < max_files_in_flight; ++i) {
+			idle_files[i] = max_files_in_flight - 1 - i;
+		}
+		// opened files whose size didn't fit the byte budget yet, oldest first
+		std::deque<std::size_t> waiting_files;
+		std::size_t next_index = 0;
+
+		auto const prepare = [&](std::size_t slot) {
+			UringFile& f = files[slot];
+			io_uring_sqe& sqe = ring.next_sqe();
+			sqe.user_data = slot;
+			switch(f.step) {
+			case UringFile::Step::open:
+				sqe.opcode = IORING_OP_OPENAT;
+				sqe.fd = AT_FDCWD;
+				sqe.addr = reinterpret_cast<std::uint64_t>(paths[f.file.index].c_str());
+				sqe.open_flags = O_RDONLY | O_CLOEXEC;
+				break;
+			case UringFile::Step::stat:
+				sqe.opcode = IORING_OP_STATX;
+				sqe.fd = f.fd;
+				sqe.addr = reinterpret_cast<std::uint64_t>("");
+				sqe.len = STATX_TYPE | STATX_SIZE;
+				sqe.off = reinterpret_cast<std::uint64_t>(&f.stx);
+				sqe.statx_flags = AT_EMPTY_PATH;
+				break;
+			case UringFile::Step::read:
+				sqe.opcode = IORING_OP_READ;
+				sqe.fd = f.fd;
+				sqe.addr = reinterpret_cast<std::uint64_t>(f.file.data.get() + f.file.size);
+				sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(f.size - f.file.size, 1U << 30));
+				sqe.off = f.file.size;
+				break;
+			case UringFile::Step::close:
+				sqe.opcode = IORING_OP_CLOSE;
+				sqe.fd = f.fd;
+				break;
+			case UringFile::Step::wait_for_bytes:
+				break;
+			}
+		};
+
+		auto const fail = [&](UringFile& f, std::error_code error) {
+			f.file.error = error;
+			f.file.data.reset();
+			f.file.size = 0;
+		};
+
+		// once the bytes of f are reserved
+		auto const start_read = [&](UringFile& f) {
+			f.file.data = allocate_file_data(f.size);
+			if(f.file.data) {
+				f.step = UringFile::Step::read;
+			} else {
+				fail(f, std::make_error_code(std::errc::not_enough_memory));
+				f.step = UringFile::Step::close;
+			}
+		};
+
+		// the next request of a file, false when it is done
+		auto const advance = [&](UringFile& f, std::int32_t res) {
+			switch(f.step) {
+			case UringFile::Step::open:
+				if(res < 0) {
+					fail(f, std::error_code(-res, std::generic_category()));
+					return false;
+				}
+				f.fd = res;
+				f.step = UringFile::Step::stat;
+				return true;
+			case UringFile::Step::stat:
+				f.step = UringFile::Step::close;
+				if(res < 0) {
+					fail(f, std::error_code(-res, std::generic_category()));
+				} else if(!S_ISREG(f.stx.stx_mode)) {
+					fail(f, std::make_error_code(std::errc::not_supported));
+				} else if(f.stx.stx_size > max_file_size) {
+					fail(f, std::make_error_code(std::errc::file_too_large));
+				} else if(f.stx.stx_size != 0) {
+					f.size = static_cast<std::size_t>(f.stx.stx_size);
+					if(try_reserve_bytes(f.file.index, f.size))
+						start_read(f);
+					else
+						f.step = UringFile::Step::wait_for_bytes;
+				}
+				return true;
+			case UringFile::Step::wait_for_bytes:
+				return true;
+			case UringFile::Step::read:
+				if(res == -EINTR || res == -EAGAIN)
+					return true;
+				if(res < 0) {
+					fail(f, std::error_code(-res, std::generic_category()));
+					f.step = UringFile::Step::close;
+				} else if(res == 0) {
+					f.step = UringFile::Step::close; // the file got shorter
+				} else {
+					f.file.size += static_cast<std::size_t>(res);
+					if(f.file.size == f.size)
+						f.step = UringFile::Step::close;
+				}
+				return true;
+			case UringFile::Step::close:
+				return false;
+			}
+			return false;
+		};
+
+		std::size_t n_active = 0; // files with a request in the ring
+		for(;;) {
+			while(!waiting_files.empty()) {
+				// only block for bytes when there is nothing else to wait for
+				UringFile& f = files[waiting_files.front()];
+				if(n_active == 0 ? !reserve_bytes(f.file.index, f.size) : !try_reserve_bytes(f.file.index, f.size))
+					break;
+				start_read(f);
+				prepare(waiting_files.front());
+				waiting_files.pop_front();
+				++n_active;
+			}
+			// no new files while earlier ones wait, they would take the bytes
+			while(waiting_files.empty() && next_index < paths.size() && !idle_files.empty()) {
+				// only block for a slot when there is nothing else to wait for
+				if(n_active == 0 ? !acquire_slot() : !try_acquire_slot())
+					break;
+				std::size_t const slot = idle_files.back();
+				idle_files.pop_back();
+				UringFile& f = files[slot];
+				f.step = UringFile::Step::open;
+				f.fd = -1;
+				f.size = 0;
+				f.file = {};
+				f.file.index = next_index++;
+				prepare(slot);
+				++n_active;
+			}
+			if(n_active == 0) {
+				// done, files only still wait if the loader is destroyed
+				for(std::size_t slot : waiting_files) {
+					::close(files[slot].fd);
+				}
+				return;
+			}
+
+			if(std::error_code error = ring.submit_and_wait()) {
+				for(std::size_t slot : waiting_files) {
+					::close(files[slot].fd);
+				}
+				// The requests in flight can't be waited for, their buffers
+				// are leaked rather than freed while the kernel may still
+				// write to them. All files not loaded yet fail.
+				for(std::size_t slot = 0; slot < files.size(); ++slot) {
+					if(std::find(idle_files.begin(), idle_files.end(), slot) != idle_files.end())
+						continue;
+					LoadedFile file;
+					file.index = files[slot].file.index;
+					file.error = error;
+					static_cast<void>(files[slot].file.data.release());
+					add_loaded(std::move(file));
+				}
+				for(std::size_t i = next_index; i < paths.size(); ++i) {
+					LoadedFile file;
+					file.index = i;
+					file.error = error;
+					add_loaded(std::move(file));
+				}
+				return;
+			}
+			ring.for_each_completion([&](std::int32_t res, std::uint64_t user_data) {
+				std::size_t const slot = static_cast<std::size_t>(user_data);
+				UringFile& f = files[slot];
+				if(!advance(f, res)) {
+					add_loaded(std::move(f.file));
+					idle_files.push_back(slot);
+					--n_active;
+				} else if(f.step == UringFile::Step::wait_for_bytes) {
+					waiting_files.push_back(slot);
+					--n_active;
+				} else {
+					prepare(slot);
+				}
+			});
+		}
+	}
+
+#endif
+};
+
+BatchFileLoader::BatchFileLoader(std::vector<std::filesystem::path> paths, BatchFileLoaderOptions const& options) :
+	_state { std::make_unique<State>() } {
+	State& s = *_state;
+	s.paths = std::move(paths);
+	s.max_files_in_flight = std::clamp<std::size_t>(options.max_files_in_flight, 1, 4096);
+	s.max_bytes_in_flight = options.max_bytes_in_flight;
+	s.max_file_size = options.max_file_size;
+	s.n_free_slots = s.max_files_in_flight;
+	s.reserved_bytes.resize(s.paths.size());
+	if(s.paths.empty()) {
+		s.backend = options.backend == FileLoaderBackend::automatic ? FileLoaderBackend::pread : options.backend;
+		return;
+	}
+
+#if OM_HAS_IO_URING
+	if(options.backend != FileLoaderBackend::pread) {
+		auto ring = std::make_unique<IoUring>();
+		if(ring->open(static_cast<unsigned>(s.max_files_in_flight))) {
+			s.backend = FileLoaderBackend::io_uring;
+			s.threads.emplace_back([&s, ring = std::move(ring)] { s.run_io_uring(*ring); });
+			return;
+		}
+	}
+#endif
+
+	s.backend = FileLoaderBackend::pread;
+	std::size_t const n_threads = std::min(s.max_files_in_flight, s.paths.size());
+	for(std::size_t i = 0; i < n_threads; ++i) {
+		s.threads.emplace_back([&s] { s.run_pread(); });
+	}
+}
+
+BatchFileLoader::~BatchFileLoader() {
+	{
+		std::lock_guard lock(_state->mutex);
+		_state->stopping = true;
+	}
+	_state->slot_freed.notify_all();
+	_state->bytes_freed.notify_all();
+	for(std::thread& thread : _state->threads) {
+		thread.join();
+	}
+}
+
+std::optional<LoadedFile> BatchFileLoader::next() {
+	State& s = *_state;
+	std::unique_lock lock(s.mutex);
+	s.file_loaded.wait(lock, [&s] { return !s.loaded.empty() || s.n_returned == s.paths.size(); });
+	if(s.loaded.empty())
+		return std::nullopt;
+	LoadedFile file = std::move(s.loaded.front());
+	s.loaded.pop_front();
+	++s.n_returned;
+	++s.n_free_slots;
+	std::size_t const freed_bytes = s.reserved_bytes[file.index];
+	s.bytes_in_flight -= freed_bytes;
+	bool const all_returned = s.n_returned == s.paths.size();
+	lock.unlock();
+	s.slot_freed.notify_one();
+	// they wait for different sizes
+	if(freed_bytes != 0)
+		s.bytes_freed.notify_all();
+	// wake the other callers so they see that there is nothing left
+	if(all_returned)
+		s.file_loaded.notify_all();
+	return file;
+}
+
+FileLoaderBackend BatchFileLoader::backend() const noexcept {
+	return _state->backend;
+}
+
+}
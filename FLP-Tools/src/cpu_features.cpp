@@ -0,0 +1,45 @@
+#include "flp_cpu_features.h"
+
+#if OM_ARCH_X86 && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace Om {
+
+namespace {
+
+	CPUFeatures detect_cpu_features() noexcept {
+		CPUFeatures features;
+#if OM_ARCH_X86 && defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, 0);
+		int const max_leaf = regs[0];
+		if(max_leaf < 1)
+			return features;
+		__cpuid(regs, 1);
+		features.ssse3 = (regs[2] & (1 << 9)) != 0;
+		bool const osxsave = (regs[2] & (1 << 27)) != 0;
+		bool const avx = (regs[2] & (1 << 28)) != 0;
+		if(max_leaf >= 7 && osxsave && avx) {
+			// xmm and ymm state enabled by the OS
+			bool const ymm_enabled = (_xgetbv(0) & 0x6) == 0x6;
+			__cpuidex(regs, 7, 0);
+			features.avx2 = ymm_enabled && (regs[1] & (1 << 5)) != 0;
+		}
+#elif OM_ARCH_X86
+		__builtin_cpu_init();
+		features.ssse3 = __builtin_cpu_supports("ssse3");
+		features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+		return features;
+	}
+
+}
+
+CPUFeatures const& cpu_features() noexcept {
+	static CPUFeatures const features = detect_cpu_features();
+	return features;
+}
+
+}
@@ -0,0 +1,319 @@
+#include "flp_diff.h"
+#include "flp_hash.h"
+
+#include <algorithm>     // min, max
+#include <array>         // array
+#include <cstddef>       // ptrdiff_t
+#include <cstring>       // memcpy
+#include <limits>        // numeric_limits
+
+
+namespace Om {
+
+namespace {
+
+	using Index = std::ptrdiff_t;
+
+	// Finds the split point of a[xoff, xlim) and b[yoff, ylim) following the
+	// middle snake of Myers' linear space refinement, see GNU diffseq.h.
+	// fd and bd are indexed by diagonal x - y.
+	class MyersDiff {
+	public:
+		MyersDiff(std::span<std::uint64_t const> a, std::span<std::uint64_t const> b) :
+			_a { a },
+			_b { b },
+			_fd_storage(a.size() + b.size() + 3) {
+			_fd = _fd_storage.data() + b.size() + 1;
+			_bd_storage.resize(_fd_storage.size());
+			_bd = _bd_storage.data() + b.size() + 1;
+			// Beyond about sqrt(N + M) steps a good split is taken instead of
+			// the best. GNU diff uses at least 4096, that is seconds for
+			// projects with many scattered changes.
+			_too_expensive = 1;
+			for(std::size_t n = a.size() + b.size() + 3; n != 0; n >>= 2) {
+				_too_expensive <<= 1;
+			}
+			_too_expensive = std::max<Index>(_too_expensive, 256);
+		}
+
+		std::vector<FLPDiffHunk> run() {
+			compare(0, static_cast<Index>(_a.size()), 0, static_cast<Index>(_b.size()));
+			return std::move(_hunks);
+		}
+
+	private:
+		struct Split {
+			Index x;
+			Index y;
+		};
+
+		void compare(Index xoff, Index xlim, Index yoff, Index ylim) {
+			// common prefix and suffix
+			while(xoff < xlim && yoff < ylim && _a[xoff] == _b[yoff]) {
+				++xoff;
+				++yoff;
+			}
+			while(xoff < xlim && yoff < ylim && _a[xlim - 1] == _b[ylim - 1]) {
+				--xlim;
+				--ylim;
+			}
+
+			if(xoff == xlim || yoff == ylim) {
+				if(xoff != xlim || yoff != ylim)
+					add_hunk(xoff, xlim, yoff, ylim);
+				return;
+			}
+			Split const split = find_split(xoff, xlim, yoff, ylim);
+			compare(xoff, split.x, yoff, split.y);
+			compare(split.x, xlim, split.y, ylim);
+		}
+
+		void add_hunk(Index xoff, Index xlim, Index yoff, Index ylim) {
+			auto const a_begin = static_cast<std::uint32_t>(xoff);
+			auto const a_end = static_cast<std::uint32_t>(xlim);
+			auto const b_begin = static_cast<std::uint32_t>(yoff);
+			auto const b_end = static_cast<std::uint32_t>(ylim);
+			if(!_hunks.empty() && _hunks.back().a_end == a_begin && _hunks.back().b_end == b_begin) {
+				_hunks.back().a_end = a_end;
+				_hunks.back().b_end = b_end;
+			} else {
+				_hunks.push_back({ a_begin, a_end, b_begin, b_end });
+			}
+		}
+
+		Split find_split(Index xoff, Index xlim, Index yoff, Index ylim) {
+			Index* const fd = _fd;
+			Index* const bd = _bd;
+			Index const dmin = xoff - ylim;
+			Index const dmax = xlim - yoff;
+			Index const fmid = xoff - yoff;
+			Index const bmid = xlim - ylim;
+			Index fmin = fmid;
+			Index fmax = fmid;
+			Index bmin = bmid;
+			Index bmax = bmid;
+			bool const odd = ((fmid - bmid) & 1) != 0;
+
+			fd[fmid] = xoff;
+			bd[bmid] = xlim;
+
+			for(Index c = 1;; ++c) {
+				// forward, one step further on every diagonal in reach
+				if(fmin > dmin)
+					fd[--fmin - 1] = -1;
+				else
+					++fmin;
+				if(fmax < dmax)
+					fd[++fmax + 1] = -1;
+				else
+					--fmax;
+				for(Index d = fmax; d >= fmin; d -= 2) {
+					Index const tlo = fd[d - 1];
+					Index const thi = fd[d + 1];
+					Index x = tlo >= thi ? tlo + 1 : thi;
+					Index y = x - d;
+					while(x < xlim && y < ylim && _a[x] == _b[y]) {
+						++x;
+						++y;
+					}
+					fd[d] = x;
+					if(odd && bmin <= d && d <= bmax && bd[d] <= x)
+						return { x, y };
+				}
+
+				// backward
+				if(bmin > dmin)
+					bd[--bmin - 1] = std::numeric_limits<Index>::max();
+				else
+					++bmin;
+				if(bmax < dmax)
+					bd[++bmax + 1] = std::numeric_limits<Index>::max();
+				else
+					--bmax;
+				for(Index d = bmax; d >= bmin; d -= 2) {
+					Index const tlo = bd[d - 1];
+					Index const thi = bd[d + 1];
+					Index x = tlo < thi ? tlo : thi - 1;
+					Index y = x - d;
+					while(xoff < x && yoff < y && _a[x - 1] == _b[y - 1]) {
+						--x;
+						--y;
+					}
+					bd[d] = x;
+					if(!odd && fmin <= d && d <= fmax && x <= fd[d])
+						return { x, y };
+				}
+
+				if(c >= _too_expensive)
+					return best_split(xoff, xlim, yoff, ylim, fmin, fmax, bmin, bmax);
+			}
+		}
+
+		// the forward or backward path that got furthest
+		Split best_split(Index xoff, Index xlim, Index yoff, Index ylim,
+		                 Index fmin, Index fmax, Index bmin, Index bmax) const {
+			Index fxybest = -1;
+			Index fxbest = 0;
+			for(Index d = fmax; d >= fmin; d -= 2) {
+				Index x = std::min(_fd[d], xlim);
+				Index y = x - d;
+				if(ylim < y) {
+					x = ylim + d;
+					y = ylim;
+				}
+				if(fxybest < x + y) {
+					fxybest = x + y;
+					fxbest = x;
+				}
+			}
+			Index bxybest = std::numeric_limits<Index>::max();
+			Index bxbest = 0;
+			for(Index d = bmax; d >= bmin; d -= 2) {
+				Index x = std::max(xoff, _bd[d]);
+				Index y = x - d;
+				if(y < yoff) {
+					x = yoff + d;
+					y = yoff;
+				}
+				if(x + y < bxybest) {
+					bxybest = x + y;
+					bxbest = x;
+				}
+			}
+			if((xlim + ylim) - bxybest < fxybest - (xoff + yoff))
+				return { fxbest, fxybest - fxbest };
+			return { bxbest, bxybest - bxbest };
+		}
+
+		std::span<std::uint64_t const> _a;
+		std::span<std::uint64_t const> _b;
+		std::vector<Index> _fd_storage;
+		std::vector<Index> _bd_storage;
+		Index* _fd;
+		Index* _bd;
+		Index _too_expensive;
+		std::vector<FLPDiffHunk> _hunks;
+	};
+
+	std::size_t record_size(FLPEventType type) noexcept {
+		switch(type) {
+		case FLPEventType::FLP_PatNoteRecChan:
+			return sizeof(FLPPatternNoteRecord);
+		case FLPEventType::FLP_PLRecChan:
+			return sizeof(FLPPlaylistClipRecord);
+		default:
+			return 0;
+		}
+	}
+
+	std::vector<FLPRecordDiff> diff_records(FLPEventView const& a, FLPEventView const& b, std::size_t size) {
+		std::vector<std::uint64_t> const a_hashes = hash_records(a.data, size);
+		std::vector<std::uint64_t> const b_hashes = hash_records(b.data, size);
+		std::vector<FLPRecordDiff> records;
+		// records have no identity, the n-th removed one of a hunk changed
+		// into the n-th inserted one
+		for(FLPDiffHunk const& hunk : diff_sequences(a_hashes, b_hashes)) {
+			std::uint32_t const n_a = hunk.a_end - hunk.a_begin;
+			std::uint32_t const n_b = hunk.b_end - hunk.b_begin;
+			std::uint32_t const n_changed = std::min(n_a, n_b);
+			for(std::uint32_t i = 0; i < n_changed; ++i) {
+				records.push_back({ FLPDiffKind::changed, hunk.a_begin + i, hunk.b_begin + i });
+			}
+			for(std::uint32_t i = n_changed; i < n_a; ++i) {
+				records.push_back({ FLPDiffKind::removed, hunk.a_begin + i, 0 });
+			}
+			for(std::uint32_t i = n_changed; i < n_b; ++i) {
+				records.push_back({ FLPDiffKind::inserted, 0, hunk.b_begin + i });
+			}
+		}
+		return records;
+	}
+
+}
+
+std::vector<FLPDiffHunk> diff_sequences(std::span<std::uint64_t const> a, std::span<std::uint64_t const> b) {
+	return MyersDiff(a, b).run();
+}
+
+std::uint64_t hash_event(FLPEventView const& e) noexcept {
+	auto const id = static_cast<std::uint8_t>(e.type);
+	if(id / 64 == 3)
+		return hash64(e.data, id);
+	std::byte value[5] { static_cast<std::byte>(id) };
+	switch(id / 64) {
+	case 0:
+		std::memcpy(value + 1, &e.u8, sizeof(e.u8));
+		break;
+	case 1:
+		std::memcpy(value + 1, &e.i16, sizeof(e.i16));
+		break;
+	default:
+		std::memcpy(value + 1, &e.i32, sizeof(e.i32));
+		break;
+	}
+	return hash64(value);
+}
+
+std::vector<std::uint64_t> hash_records(std::span<std::byte const> data, std::size_t record_size) {
+	std::vector<std::uint64_t> hashes;
+	hashes.reserve((data.size() + record_size - 1) / record_size);
+	for(std::size_t offset = 0; offset < data.size(); offset += record_size) {
+		hashes.push_back(hash64(data.subspan(offset, std::min(record_size, data.size() - offset))));
+	}
+	return hashes;
+}
+
+std::vector<FLPEventDiff> diff_events(std::span<FLPEventView const> a, std::span<FLPEventView const> b) {
+	std::vector<std::uint64_t> a_hashes(a.size());
+	std::vector<std::uint64_t> b_hashes(b.size());
+	for(std::size_t i = 0; i < a.size(); ++i) {
+		a_hashes[i] = hash_event(a[i]);
+	}
+	for(std::size_t i = 0; i < b.size(); ++i) {
+		b_hashes[i] = hash_event(b[i]);
+	}
+
+	std::vector<FLPEventDiff> diffs;
+	// positions of the inserted events of a hunk per type, consumed in order
+	std::array<std::vector<std::uint32_t>, 256> inserted_by_type;
+	std::array<std::size_t, 256> next_of_type {};
+	for(FLPDiffHunk const& hunk : diff_sequences(a_hashes, b_hashes)) {
+		for(std::uint32_t j = hunk.b_begin; j < hunk.b_end; ++j) {
+			inserted_by_type[static_cast<std::uint8_t>(b[j].type)].push_back(j);
+		}
+
+		std::uint32_t j = hunk.b_begin; // inserted events before j are reported
+		for(std::uint32_t i = hunk.a_begin; i < hunk.a_end; ++i) {
+			auto const type = static_cast<std::uint8_t>(a[i].type);
+			std::vector<std::uint32_t> const& candidates = inserted_by_type[type];
+			std::size_t& next = next_of_type[type];
+			while(next < candidates.size() && candidates[next] < j) {
+				++next;
+			}
+			if(next == candidates.size()) {
+				diffs.push_back({ FLPDiffKind::removed, i, 0, {} });
+				continue;
+			}
+			std::uint32_t const k = candidates[next++];
+			for(; j < k; ++j) {
+				diffs.push_back({ FLPDiffKind::inserted, 0, j, {} });
+			}
+			FLPEventDiff& changed = diffs.emplace_back(FLPEventDiff { FLPDiffKind::changed, i, k, {} });
+			if(std::size_t const size = record_size(a[i].type))
+				changed.records = diff_records(a[i], b[k], size);
+			j = k + 1;
+		}
+		for(; j < hunk.b_end; ++j) {
+			diffs.push_back({ FLPDiffKind::inserted, 0, j, {} });
+		}
+
+		for(std::uint32_t k = hunk.b_begin; k < hunk.b_end; ++k) {
+			auto const type = static_cast<std::uint8_t>(b[k].type);
+			inserted_by_type[type].clear();
+			next_of_type[type] = 0;
+		}
+	}
+	return diffs;
+}
+
+}
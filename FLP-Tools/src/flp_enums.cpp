@@ -249,3 +249,11 @@ static constexpr char const* const event_names[256] = {
 char const* Om::flp_event_name(std::uint8_t event_id) noexcept {
 	return event_names[event_id];
 };
+
+std::optional<FLPEventType> Om::flp_event_type_from_name(std::string_view name) noexcept {
+	for(int id = 0; id < 256; ++id) {
+		if(event_names[id] != nullptr && name == event_names[id])
+			return static_cast<FLPEventType>(id);
+	}
+	return std::nullopt;
+}
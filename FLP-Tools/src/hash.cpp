@@ -0,0 +1,130 @@
+#include "flp_hash.h"
+
+#include <array>         // array
+#include <cstring>       // memcpy
+
+
+namespace Om {
+
+namespace {
+
+	constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87U;
+	constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FU;
+	constexpr std::uint64_t prime3 = 0x165667B19E3779F9U;
+	constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63U;
+	constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5U;
+
+	constexpr std::uint64_t rotl(std::uint64_t x, int r) noexcept {
+		return (x << r) | (x >> (64 - r));
+	}
+
+	// little endian like the rest of the format
+	template<typename T>
+	T read(unsigned char const* p) noexcept {
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		return value;
+	}
+
+	constexpr std::uint64_t round(std::uint64_t acc, std::uint64_t input) noexcept {
+		return rotl(acc + input * prime2, 31) * prime1;
+	}
+
+	constexpr std::uint64_t merge_round(std::uint64_t acc, std::uint64_t value) noexcept {
+		return (acc ^ round(0, value)) * prime1 + prime4;
+	}
+
+	// crc_tables[k][b] is the CRC of byte b followed by k zero bytes, so
+	// eight bytes are folded in at once ("slicing by 8")
+	constexpr std::array<std::array<std::uint32_t, 256>, 8> make_crc_tables() noexcept {
+		std::array<std::array<std::uint32_t, 256>, 8> tables {};
+		for(std::uint32_t b = 0; b < 256; ++b) {
+			std::uint32_t crc = b;
+			for(int bit = 0; bit < 8; ++bit) {
+				crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));
+			}
+			tables[0][b] = crc;
+		}
+		for(std::size_t k = 1; k < 8; ++k) {
+			for(std::uint32_t b = 0; b < 256; ++b) {
+				std::uint32_t const previous = tables[k - 1][b];
+				tables[k][b] = (previous >> 8) ^ tables[0][previous & 0xFF];
+			}
+		}
+		return tables;
+	}
+
+	constexpr auto crc_tables = make_crc_tables();
+
+}
+
+std::uint64_t hash64(std::span<std::byte const> data, std::uint64_t seed) noexcept {
+	auto const* p = reinterpret_cast<unsigned char const*>(data.data());
+	auto const* const end = p + data.size();
+
+	std::uint64_t h;
+	if(data.size() >= 32) {
+		// four independent lanes over 32 byte stripes
+		std::uint64_t v1 = seed + prime1 + prime2;
+		std::uint64_t v2 = seed + prime2;
+		std::uint64_t v3 = seed;
+		std::uint64_t v4 = seed - prime1;
+		do {
+			v1 = round(v1, read<std::uint64_t>(p));
+			v2 = round(v2, read<std::uint64_t>(p + 8));
+			v3 = round(v3, read<std::uint64_t>(p + 16));
+			v4 = round(v4, read<std::uint64_t>(p + 24));
+			p += 32;
+		} while(end - p >= 32);
+		h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+		h = merge_round(h, v1);
+		h = merge_round(h, v2);
+		h = merge_round(h, v3);
+		h = merge_round(h, v4);
+	} else {
+		h = seed + prime5;
+	}
+	h += data.size();
+
+	for(; end - p >= 8; p += 8) {
+		h ^= round(0, read<std::uint64_t>(p));
+		h = rotl(h, 27) * prime1 + prime4;
+	}
+	if(end - p >= 4) {
+		h ^= read<std::uint32_t>(p) * prime1;
+		h = rotl(h, 23) * prime2 + prime3;
+		p += 4;
+	}
+	for(; p != end; ++p) {
+		h ^= *p * prime5;
+		h = rotl(h, 11) * prime1;
+	}
+
+	h ^= h >> 33;
+	h *= prime2;
+	h ^= h >> 29;
+	h *= prime3;
+	h ^= h >> 32;
+	return h;
+}
+
+std::uint32_t crc32(std::span<std::byte const> data, std::uint32_t crc) noexcept {
+	auto const* p = reinterpret_cast<unsigned char const*>(data.data());
+	auto const* const end = p + data.size();
+
+	crc = ~crc;
+	for(; end - p >= 8; p += 8) {
+		std::uint32_t const low = read<std::uint32_t>(p) ^ crc;
+		std::uint32_t const high = read<std::uint32_t>(p + 4);
+		crc = crc_tables[7][low & 0xFF] ^ crc_tables[6][(low >> 8) & 0xFF]
+		      ^ crc_tables[5][(low >> 16) & 0xFF] ^ crc_tables[4][low >> 24]
+		      ^ crc_tables[3][high & 0xFF] ^ crc_tables[2][(high >> 8) & 0xFF]
+		      ^ crc_tables[1][(high >> 16) & 0xFF] ^ crc_tables[0][high >> 24];
+	}
+	for(; p != end; ++p) {
+		crc = (crc >> 8) ^ crc_tables[0][(crc ^ *p) & 0xFF];
+	}
+	return ~crc;
+}
+
+}
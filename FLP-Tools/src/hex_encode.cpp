@@ -0,0 +1,198 @@
+#include "flp_hex.h"
+#include "flp_cpu_features.h"
+
+#include <array>         // array
+#include <cassert>       // assert
+#include <cstdint>       // int8_t, uint8_t
+#include <cstring>       // memcpy
+
+#if OM_ARCH_X86
+#include <immintrin.h>
+#endif
+
+
+namespace Om {
+
+namespace {
+
+	constexpr char hex_digits[] = "0123456789ABCDEF";
+
+	// both digits of every byte value
+	constexpr std::array<char, 512> make_hex_pairs() noexcept {
+		std::array<char, 512> pairs {};
+		for(int i = 0; i < 256; ++i) {
+			pairs[2 * i] = hex_digits[i >> 4];
+			pairs[2 * i + 1] = hex_digits[i & 0x0F];
+		}
+		return pairs;
+	}
+
+	constexpr std::array<char, 512> hex_pairs = make_hex_pairs();
+
+	// Kernels write "XX " for each of the n bytes and return the end of the output.
+	using HexKernel = char* (*)(std::byte const* data, std::size_t n, char* out);
+
+	char* hex_encode_triples_scalar(std::byte const* data, std::size_t n, char* out) noexcept {
+		for(std::size_t i = 0; i < n; ++i) {
+			std::memcpy(out, &hex_pairs[2 * static_cast<std::uint8_t>(data[i])], 2);
+			out[2] = ' ';
+			out += 3;
+		}
+		return out;
+	}
+
+#if OM_ARCH_X86
+	// Every 16 output chars are produced by one byte shuffle from the
+	// interleaved digits of 8 input bytes starting at the first byte that
+	// the chars belong to. The shuffle only depends on the position of the
+	// first char within its "XX " group, the phase.
+	struct alignas(16) SpreadMask {
+		std::int8_t shuffle[16];
+		char spaces[16];
+	};
+
+	constexpr SpreadMask make_spread_mask(int phase) noexcept {
+		SpreadMask mask {};
+		for(int j = 0; j < 16; ++j) {
+			int const c = phase + j;
+			if(c % 3 == 2) {
+				mask.shuffle[j] = -128; // zero, the space is or'ed in
+				mask.spaces[j] = ' ';
+			} else {
+				mask.shuffle[j] = static_cast<std::int8_t>(2 * (c / 3) + c % 3);
+				mask.spaces[j] = 0;
+			}
+		}
+		return mask;
+	}
+
+	constexpr SpreadMask spread_masks[3] = {
+		make_spread_mask(0),
+		make_spread_mask(1),
+		make_spread_mask(2)
+	};
+
+	OM_TARGET("ssse3")
+	inline __m128i hex_pairs_ssse3(std::byte const* data) noexcept {
+		__m128i const lut = _mm_loadu_si128(reinterpret_cast<__m128i const*>(hex_digits));
+		__m128i const nibble_mask = _mm_set1_epi8(0x0F);
+		__m128i const v = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(data));
+		__m128i const hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask));
+		__m128i const lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble_mask));
+		return _mm_unpacklo_epi8(hi, lo);
+	}
+
+	OM_TARGET("ssse3")
+	inline void spread_ssse3(std::byte const* data, SpreadMask const& mask, char* out) noexcept {
+		__m128i const pairs = hex_pairs_ssse3(data);
+		__m128i const shuffle = _mm_load_si128(reinterpret_cast<__m128i const*>(mask.shuffle));
+		__m128i const spaces = _mm_load_si128(reinterpret_cast<__m128i const*>(mask.spaces));
+		__m128i const chars = _mm_or_si128(_mm_shuffle_epi8(pairs, shuffle), spaces);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+	}
+
+	OM_TARGET("ssse3")
+	char* hex_encode_triples_ssse3(std::byte const* data, std::size_t n, char* out) noexcept {
+		// 16 bytes to 48 chars, the last 8 byte load starts at byte 10
+		std::size_t i = 0;
+		for(; n - i >= 18; i += 16) {
+			spread_ssse3(data + i, spread_masks[0], out);
+			spread_ssse3(data + i + 5, spread_masks[1], out + 16);
+			spread_ssse3(data + i + 10, spread_masks[2], out + 32);
+			out += 48;
+		}
+		return hex_encode_triples_scalar(data + i, n - i, out);
+	}
+
+	OM_TARGET("avx2")
+	inline void spread_avx2(std::byte const* data_lo, std::byte const* data_hi,
+	                        SpreadMask const& mask_lo, SpreadMask const& mask_hi, char* out) noexcept {
+		__m256i const lut = _mm256_broadcastsi128_si256(
+			_mm_loadu_si128(reinterpret_cast<__m128i const*>(hex_digits)));
+		__m256i const nibble_mask = _mm256_set1_epi8(0x0F);
+		__m256i const v = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(data_lo))),
+			_mm_loadl_epi64(reinterpret_cast<__m128i const*>(data_hi)), 1);
+		__m256i const hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble_mask));
+		__m256i const lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble_mask));
+		__m256i const pairs = _mm256_unpacklo_epi8(hi, lo);
+		__m256i const shuffle = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(mask_lo.shuffle))),
+			_mm_load_si128(reinterpret_cast<__m128i const*>(mask_hi.shuffle)), 1);
+		__m256i const spaces = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_load_si128(reinterpret_cast<__m128i const*>(mask_lo.spaces))),
+			_mm_load_si128(reinterpret_cast<__m128i const*>(mask_hi.spaces)), 1);
+		__m256i const chars = _mm256_or_si256(_mm256_shuffle_epi8(pairs, shuffle), spaces);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+	}
+
+	OM_TARGET("avx2")
+	char* hex_encode_triples_avx2(std::byte const* data, std::size_t n, char* out) noexcept {
+		// 32 bytes to 96 chars, the last 8 byte load starts at byte 26
+		std::size_t i = 0;
+		for(; n - i >= 34; i += 32) {
+			std::byte const* p = data + i;
+			spread_avx2(p, p + 5, spread_masks[0], spread_masks[1], out);
+			spread_avx2(p + 10, p + 16, spread_masks[2], spread_masks[0], out + 32);
+			spread_avx2(p + 21, p + 26, spread_masks[1], spread_masks[2], out + 64);
+			out += 96;
+		}
+		return hex_encode_triples_ssse3(data + i, n - i, out);
+	}
+#endif
+
+	HexKernel select_hex_kernel([[maybe_unused]] CPUFeatures const& features) noexcept {
+#if OM_ARCH_X86
+		if(features.avx2)
+			return hex_encode_triples_avx2;
+		if(features.ssse3)
+			return hex_encode_triples_ssse3;
+#endif
+		return hex_encode_triples_scalar;
+	}
+
+	inline char hex_spaced_char(std::byte const* data, std::size_t c) noexcept {
+		auto const b = static_cast<std::uint8_t>(data[c / 3]);
+		switch(c % 3) {
+		case 0:
+			return hex_digits[b >> 4];
+		case 1:
+			return hex_digits[b & 0x0F];
+		default:
+			return ' ';
+		}
+	}
+
+	void encode_spaced(HexKernel kernel, std::span<std::byte const> data, std::size_t first_char,
+	                   std::size_t n_chars, char* out) noexcept {
+		assert(first_char + n_chars <= hex_spaced_length(data.size()));
+		std::byte const* const bytes = data.data();
+		char* const end = out + n_chars;
+		std::size_t c = first_char;
+		// finish a group that was started by the previous piece
+		while(c % 3 != 0 && out != end) {
+			*out++ = hex_spaced_char(bytes, c++);
+		}
+		// the last group has no space, it is always written by the loop below
+		std::size_t const n_groups = static_cast<std::size_t>(end - out) / 3;
+		out = kernel(bytes + c / 3, n_groups, out);
+		c += n_groups * 3;
+		while(out != end) {
+			*out++ = hex_spaced_char(bytes, c++);
+		}
+	}
+
+}
+
+void hex_encode_spaced(std::span<std::byte const> data, std::size_t first_char,
+                       std::size_t n_chars, char* out) noexcept {
+	static HexKernel const kernel = select_hex_kernel(cpu_features());
+	encode_spaced(kernel, data, first_char, n_chars, out);
+}
+
+void hex_encode_spaced(std::span<std::byte const> data, std::size_t first_char,
+                       std::size_t n_chars, char* out, CPUFeatures const& features) noexcept {
+	encode_spaced(select_hex_kernel(features), data, first_char, n_chars, out);
+}
+
+}
@@ -0,0 +1,362 @@
+#include "flp_index.h"
+#include "flp_utf_conversions.h"
+
+#include <algorithm>     // sort, unique, lower_bound, partition_point
+#include <charconv>      // from_chars
+#include <cstring>       // memcpy, memcmp
+#include <limits>        // numeric_limits
+#include <numeric>       // iota
+#include <stdexcept>     // runtime_error, length_error
+#include <system_error>  // system_error
+
+
+namespace Om {
+
+namespace {
+
+	constexpr std::string_view field_names[flp_index_n_fields] = {
+		"plugin",
+		"plugin_name",
+		"sample",
+		"sample_path",
+		"author",
+		"genre",
+		"version"
+	};
+
+	constexpr unsigned char fold(char c) noexcept {
+		auto const u = static_cast<unsigned char>(c);
+		return u >= 'A' && u <= 'Z' ? static_cast<unsigned char>(u + ('a' - 'A')) : u;
+	}
+
+	constexpr std::uint64_t align8(std::uint64_t n) noexcept {
+		return (n + 7) & ~std::uint64_t(7);
+	}
+
+	void write_varint(std::uint32_t value, std::vector<std::byte>* out) {
+		while(value >= 0x80) {
+			out->push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		out->push_back(static_cast<std::byte>(value));
+	}
+
+	// the part after the last slash or backslash, samples are stored with
+	// the separators of the machine that saved the project
+	std::string_view file_name(std::string_view path) noexcept {
+		std::size_t const slash = path.find_last_of("/\\");
+		return slash == std::string_view::npos ? path : path.substr(slash + 1);
+	}
+
+	[[noreturn]]
+	void invalid_index() {
+		throw std::runtime_error { "Invalid index file!" };
+	}
+
+	class IndexErrorCategory final : public std::error_category {
+	public:
+		char const* name() const noexcept override {
+			return "flp_index";
+		}
+
+		std::string message(int) const override {
+			return "Invalid index file";
+		}
+	};
+
+	std::error_code invalid_index_error() noexcept {
+		static IndexErrorCategory const category;
+		return { 1, category };
+	}
+
+}
+
+std::string_view index_field_name(FLPIndexField field) noexcept {
+	return field_names[static_cast<std::size_t>(field)];
+}
+
+std::optional<FLPIndexField> index_field_from_name(std::string_view name) noexcept {
+	for(std::size_t i = 0; i < flp_index_n_fields; ++i) {
+		if(field_names[i] == name)
+			return static_cast<FLPIndexField>(i);
+	}
+	return std::nullopt;
+}
+
+FLPEventMask FLPIndexTermCollector::event_mask() noexcept {
+	return FLPEventMask()
+		.set(FLPEventType::FLP_Version)
+		.set(FLPEventType::FLP_Text_DefPluginName)
+		.set(FLPEventType::FLP_Text_PluginName)
+		.set(FLPEventType::FLP_Text_SampleFileName)
+		.set(FLPEventType::FLP_Text_Author)
+		.set(FLPEventType::FLP_Text_Genre);
+}
+
+void FLPIndexTermCollector::add_term(FLPIndexField field, FLPEventView const& e) {
+	std::string text;
+	// FLP_Version is never UTF-16
+	if(_major_version >= 12 && e.type != FLPEventType::FLP_Version) {
+		auto const* str = reinterpret_cast<char16_t const*>(e.data.data());
+		std::size_t len = e.data.size() / 2;
+		if(len > 0 && load_utf16_unit(str + len - 1) == u'\0')
+			--len;
+		if(std::error_code err = utf16_to_utf8(std::u16string_view(str, len), &text))
+			throw std::system_error(err);
+	} else {
+		text.assign(reinterpret_cast<char const*>(e.data.data()), e.data.size());
+		if(!text.empty() && text.back() == '\0')
+			text.pop_back();
+	}
+	if(text.empty())
+		return;
+
+	if(field == FLPIndexField::sample_path) {
+		std::string_view const name = file_name(text);
+		if(!name.empty())
+			_terms.push_back({ FLPIndexField::sample, std::string(name) });
+	}
+	_terms.push_back({ field, std::move(text) });
+}
+
+void FLPIndexTermCollector::add_event(FLPEventView const& e) {
+	switch(e.type) {
+	case FLPEventType::FLP_Version:
+	{
+		// an empty version adds no term
+		std::size_t const n_terms = _terms.size();
+		add_term(FLPIndexField::version, e);
+		if(_terms.size() != n_terms) {
+			std::string const& version = _terms.back().text;
+			std::from_chars(version.data(), version.data() + version.size(), _major_version);
+		}
+		break;
+	}
+	case FLPEventType::FLP_Text_DefPluginName:
+		add_term(FLPIndexField::plugin, e);
+		break;
+	case FLPEventType::FLP_Text_PluginName:
+		add_term(FLPIndexField::plugin_name, e);
+		break;
+	case FLPEventType::FLP_Text_SampleFileName:
+		add_term(FLPIndexField::sample_path, e);
+		break;
+	case FLPEventType::FLP_Text_Author:
+		add_term(FLPIndexField::author, e);
+		break;
+	case FLPEventType::FLP_Text_Genre:
+		add_term(FLPIndexField::genre, e);
+		break;
+	default:
+		break;
+	}
+}
+
+std::vector<FLPIndexTerm> FLPIndexTermCollector::finish() {
+	std::sort(_terms.begin(), _terms.end(), [](FLPIndexTerm const& a, FLPIndexTerm const& b) {
+		return a.field != b.field ? a.field < b.field : a.text < b.text;
+	});
+	_terms.erase(std::unique(_terms.begin(), _terms.end()), _terms.end());
+	return std::move(_terms);
+}
+
+int compare_index_text(std::string_view a, std::string_view b) noexcept {
+	std::size_t const n = std::min(a.size(), b.size());
+	for(std::size_t i = 0; i < n; ++i) {
+		unsigned char const ca = fold(a[i]);
+		unsigned char const cb = fold(b[i]);
+		if(ca != cb)
+			return ca < cb ? -1 : 1;
+	}
+	return a.size() < b.size() ? -1 : a.size() > b.size() ? 1 : 0;
+}
+
+std::uint32_t FLPIndexWriter::add_string(std::string_view str) {
+	if(_strings.size() + str.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("FLP index strings too large");
+	auto const offset = static_cast<std::uint32_t>(_strings.size());
+	_strings.append(str);
+	return offset;
+}
+
+std::uint32_t FLPIndexWriter::add_document(std::string_view path, std::span<FLPIndexTerm const> terms) {
+	auto const document = static_cast<std::uint32_t>(_documents.size());
+	_documents.push_back({ add_string(path), static_cast<std::uint32_t>(path.size()) });
+	for(FLPIndexTerm const& term : terms) {
+		auto& lookup = _term_lookup[static_cast<std::size_t>(term.field)];
+		auto [it, is_new] = lookup.try_emplace(term.text, static_cast<std::uint32_t>(_terms.size()));
+		if(is_new) {
+			_terms.push_back({ term.field, add_string(term.text), static_cast<std::uint32_t>(term.text.size()), {} });
+		}
+		std::vector<std::uint32_t>& documents = _terms[it->second].documents;
+		// terms may repeat within a document
+		if(documents.empty() || documents.back() != document)
+			documents.push_back(document);
+	}
+	return document;
+}
+
+std::vector<std::byte> FLPIndexWriter::serialize() const {
+	auto text = [&](Term const& t) {
+		return std::string_view(_strings).substr(t.text_offset, t.text_length);
+	};
+
+	// lookups ignore case, the exact text only orders terms that differ in case
+	std::vector<std::uint32_t> order(_terms.size());
+	std::iota(order.begin(), order.end(), std::uint32_t(0));
+	std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+		Term const& ta = _terms[a];
+		Term const& tb = _terms[b];
+		if(ta.field != tb.field)
+			return ta.field < tb.field;
+		if(int const c = compare_index_text(text(ta), text(tb)))
+			return c < 0;
+		return text(ta) < text(tb);
+	});
+
+	std::vector<FLPIndexTermEntry> entries;
+	entries.reserve(order.size());
+	std::vector<std::byte> postings;
+	for(std::uint32_t i : order) {
+		Term const& t = _terms[i];
+		FLPIndexTermEntry entry {};
+		entry.field = t.field;
+		entry.text_offset = t.text_offset;
+		entry.text_length = t.text_length;
+		entry.n_documents = static_cast<std::uint32_t>(t.documents.size());
+		entry.postings_offset = postings.size();
+		std::uint32_t previous = 0;
+		for(std::uint32_t document : t.documents) {
+			write_varint(document - previous, &postings);
+			previous = document;
+		}
+		entries.push_back(entry);
+	}
+
+	FLPIndexHeader header {};
+	std::memcpy(header.magic, detail::flp_index_magic, sizeof(header.magic));
+	header.format_version = flp_index_format_version;
+	header.n_documents = static_cast<std::uint32_t>(_documents.size());
+	header.n_terms = static_cast<std::uint32_t>(entries.size());
+	header.documents_offset = align8(sizeof(FLPIndexHeader));
+	header.terms_offset = align8(header.documents_offset + _documents.size() * sizeof(FLPIndexDocument));
+	header.postings_offset = align8(header.terms_offset + entries.size() * sizeof(FLPIndexTermEntry));
+	header.strings_offset = align8(header.postings_offset + postings.size());
+	header.file_size = header.strings_offset + _strings.size();
+
+	std::vector<std::byte> out(header.file_size);
+	auto put = [&](std::uint64_t offset, void const* data, std::size_t size) {
+		if(size != 0)
+			std::memcpy(out.data() + offset, data, size);
+	};
+	put(0, &header, sizeof(header));
+	put(header.documents_offset, _documents.data(), _documents.size() * sizeof(FLPIndexDocument));
+	put(header.terms_offset, entries.data(), entries.size() * sizeof(FLPIndexTermEntry));
+	put(header.postings_offset, postings.data(), postings.size());
+	put(header.strings_offset, _strings.data(), _strings.size());
+	return out;
+}
+
+std::error_code FLPIndex::open(std::filesystem::path const& path) {
+	*this = {};
+	if(std::error_code err = _file.open(path))
+		return err;
+
+	auto invalid = [this] {
+		*this = {};
+		return invalid_index_error();
+	};
+
+	std::span<std::byte const> const data = _file.data();
+	FLPIndexHeader header;
+	if(data.size() < sizeof(header))
+		return invalid();
+	std::memcpy(&header, data.data(), sizeof(header));
+	if(std::memcmp(header.magic, detail::flp_index_magic, sizeof(header.magic)) != 0
+	   || header.format_version != flp_index_format_version
+	   || header.file_size != data.size())
+		return invalid();
+
+	// sections have to be in order, aligned and inside the file
+	auto is_section = [&](std::uint64_t offset, std::uint64_t end) {
+		return offset % 8 == 0 && offset <= end && end <= data.size();
+	};
+	auto section = [&](std::uint64_t offset, std::uint64_t end) {
+		return data.subspan(static_cast<std::size_t>(offset), static_cast<std::size_t>(end - offset));
+	};
+	std::uint64_t const documents_end = header.documents_offset + std::uint64_t(header.n_documents) * sizeof(FLPIndexDocument);
+	std::uint64_t const terms_end = header.terms_offset + std::uint64_t(header.n_terms) * sizeof(FLPIndexTermEntry);
+	if(header.documents_offset < sizeof(header) || header.terms_offset < documents_end || header.postings_offset < terms_end
+	   || !is_section(header.documents_offset, documents_end)
+	   || !is_section(header.terms_offset, terms_end)
+	   || !is_section(header.postings_offset, header.strings_offset)
+	   || !is_section(header.strings_offset, header.file_size))
+		return invalid();
+	std::span<std::byte const> const documents = section(header.documents_offset, documents_end);
+	std::span<std::byte const> const terms = section(header.terms_offset, terms_end);
+	_postings = section(header.postings_offset, header.strings_offset);
+	std::span<std::byte const> const strings = section(header.strings_offset, header.file_size);
+
+	_documents = { reinterpret_cast<FLPIndexDocument const*>(documents.data()), header.n_documents };
+	_terms = { reinterpret_cast<FLPIndexTermEntry const*>(terms.data()), header.n_terms };
+	_strings = { reinterpret_cast<char const*>(strings.data()), strings.size() };
+
+	auto is_string = [&](std::uint32_t offset, std::uint32_t length) {
+		return offset <= _strings.size() && length <= _strings.size() - offset;
+	};
+	for(FLPIndexDocument const& d : _documents) {
+		if(!is_string(d.path_offset, d.path_length))
+			return invalid();
+	}
+	for(FLPIndexTermEntry const& t : _terms) {
+		if(static_cast<std::size_t>(t.field) >= flp_index_n_fields || t.postings_offset > _postings.size()
+		   || !is_string(t.text_offset, t.text_length))
+			return invalid();
+	}
+	return {};
+}
+
+std::span<FLPIndexTermEntry const> FLPIndex::terms(FLPIndexField field) const noexcept {
+	auto const begin = std::partition_point(_terms.begin(), _terms.end(), [&](FLPIndexTermEntry const& t) {
+		return t.field < field;
+	});
+	auto const end = std::partition_point(begin, _terms.end(), [&](FLPIndexTermEntry const& t) {
+		return t.field == field;
+	});
+	return { begin, end };
+}
+
+std::span<FLPIndexTermEntry const> FLPIndex::find(FLPIndexField field, std::string_view text, bool is_prefix) const noexcept {
+	std::span<FLPIndexTermEntry const> const field_terms = terms(field);
+	auto const begin = std::partition_point(field_terms.begin(), field_terms.end(), [&](FLPIndexTermEntry const& t) {
+		return compare_index_text(this->text(t), text) < 0;
+	});
+	auto const end = std::partition_point(begin, field_terms.end(), [&](FLPIndexTermEntry const& t) {
+		std::string_view const term_text = this->text(t);
+		return compare_index_text(is_prefix ? term_text.substr(0, text.size()) : term_text, text) == 0;
+	});
+	return { begin, end };
+}
+
+void FLPIndex::postings(FLPIndexTermEntry const& term, std::vector<std::uint32_t>* documents) const {
+	auto const* p = reinterpret_cast<unsigned char const*>(_postings.data()) + term.postings_offset;
+	auto const* const end = reinterpret_cast<unsigned char const*>(_postings.data()) + _postings.size();
+	std::uint32_t document = 0;
+	for(std::uint32_t i = 0; i < term.n_documents; ++i) {
+		std::uint32_t delta = 0;
+		for(unsigned shift = 0;; shift += 7) {
+			if(p == end || shift >= 32)
+				invalid_index();
+			unsigned char const byte = *p++;
+			delta |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+			if((byte & 0x80) == 0)
+				break;
+		}
+		document += delta;
+		if(document >= _documents.size())
+			invalid_index();
+		documents->push_back(document);
+	}
+}
+
+}
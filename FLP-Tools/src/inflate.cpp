@@ -0,0 +1,396 @@
+#include "flp_inflate.h"
+
+#include <algorithm>     // min, fill
+#include <array>         // array
+#include <cstring>       // memcpy
+
+
+namespace Om {
+
+namespace {
+
+	constexpr std::size_t window_size = std::size_t(1) << 16; // twice the largest distance
+	constexpr std::size_t window_mask = window_size - 1;
+	constexpr std::size_t max_match_length = 258;
+	constexpr unsigned max_code_length = 15;
+
+	constexpr unsigned literal_primary_bits = 10;
+	constexpr unsigned distance_primary_bits = 8;
+	constexpr unsigned code_length_primary_bits = 7;
+
+	// Table entries hold the symbol in the low 16 bits and the code length
+	// in bits 16 to 23. Codes longer than the primary bits continue in a
+	// subtable, their primary entry has subtable_flag set, the subtable's
+	// offset in the low bits and its index bits in bits 16 to 23. An entry
+	// of 0 is a code that isn't used.
+	constexpr std::uint32_t subtable_flag = 0x80000000U;
+
+	constexpr std::uint16_t length_base[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+	};
+	constexpr std::uint8_t length_extra_bits[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+	};
+	constexpr std::uint16_t distance_base[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+	};
+	constexpr std::uint8_t distance_extra_bits[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+	};
+	// order in which the code length code's lengths are stored
+	constexpr std::uint8_t code_length_order[19] = {
+		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+	};
+
+	// deflate sends Huffman codes starting with their most significant bit
+	constexpr std::uint32_t reverse_bits(std::uint32_t code, unsigned n) noexcept {
+		std::uint32_t reversed = 0;
+		for(unsigned i = 0; i < n; ++i) {
+			reversed = (reversed << 1) | (code & 1);
+			code >>= 1;
+		}
+		return reversed;
+	}
+
+	// Builds the lookup table of the canonical code with the given code
+	// lengths. Incomplete codes are accepted, their unused entries stay 0.
+	// Returns false if the lengths are over-subscribed.
+	bool build_table(std::span<std::uint8_t const> lengths, unsigned primary_bits, detail::HuffmanTable* table) {
+		std::array<std::uint32_t, max_code_length + 1> count {};
+		for(std::uint8_t length : lengths) {
+			++count[length];
+		}
+		count[0] = 0;
+
+		int left = 1;
+		unsigned max_length = 0;
+		for(unsigned length = 1; length <= max_code_length; ++length) {
+			left = (left << 1) - static_cast<int>(count[length]);
+			if(left < 0)
+				return false;
+			if(count[length] != 0)
+				max_length = length;
+		}
+
+		std::array<std::uint32_t, max_code_length + 1> next_code {};
+		std::uint32_t code = 0;
+		for(unsigned length = 1; length <= max_code_length; ++length) {
+			code = (code + count[length - 1]) << 1;
+			next_code[length] = code;
+		}
+
+		unsigned const subtable_bits = max_length > primary_bits ? max_length - primary_bits : 0;
+		std::size_t const primary_size = std::size_t(1) << primary_bits;
+		table->primary_bits = primary_bits;
+		table->entries.assign(primary_size, 0);
+		for(std::size_t symbol = 0; symbol < lengths.size(); ++symbol) {
+			unsigned const length = lengths[symbol];
+			if(length == 0)
+				continue;
+			std::uint32_t const reversed = reverse_bits(next_code[length]++, length);
+			std::uint32_t const entry = static_cast<std::uint32_t>(symbol) | (length << 16);
+			if(length <= primary_bits) {
+				for(std::size_t i = reversed; i < primary_size; i += std::size_t(1) << length) {
+					table->entries[i] = entry;
+				}
+				continue;
+			}
+
+			std::uint32_t& primary_entry = table->entries[reversed & (primary_size - 1)];
+			if(primary_entry == 0) {
+				primary_entry = subtable_flag | (subtable_bits << 16) | static_cast<std::uint32_t>(table->entries.size());
+				// may reallocate, primary_entry isn't used after this
+				table->entries.resize(table->entries.size() + (std::size_t(1) << subtable_bits), 0);
+			}
+			std::size_t const offset = table->entries[reversed & (primary_size - 1)] & 0xFFFFU;
+			unsigned const rest_length = length - primary_bits;
+			for(std::size_t i = reversed >> primary_bits; i < (std::size_t(1) << subtable_bits); i += std::size_t(1) << rest_length) {
+				table->entries[offset + i] = entry;
+			}
+		}
+		return true;
+	}
+
+}
+
+Inflater::Inflater(std::span<std::byte const> input) :
+	_in { input.data() },
+	_in_end { input.data() + input.size() },
+	_window { std::make_unique<std::byte[]>(window_size) } {
+}
+
+std::size_t Inflater::read(std::span<std::byte> out) {
+	std::size_t done = 0;
+	while(done < out.size()) {
+		if(_read_position == _write_position) {
+			decode();
+			if(_read_position == _write_position)
+				break;
+		}
+		std::size_t const offset = static_cast<std::size_t>(_read_position & window_mask);
+		std::size_t const n = std::min({
+			out.size() - done,
+			static_cast<std::size_t>(_write_position - _read_position),
+			window_size - offset
+		});
+		std::memcpy(out.data() + done, _window.get() + offset, n);
+		_read_position += n;
+		done += n;
+	}
+	return done;
+}
+
+void Inflater::decode() {
+	while(window_size - (_write_position - _read_position) >= max_match_length) {
+		switch(_state) {
+		case State::block_header:
+			if(!read_block_header())
+				_state = State::error;
+			break;
+		case State::stored:
+			decode_stored();
+			break;
+		case State::huffman:
+			decode_huffman();
+			break;
+		case State::done:
+		case State::error:
+			return;
+		}
+	}
+}
+
+bool Inflater::read_block_header() {
+	refill_bits();
+	_is_final_block = take_bits(1) != 0;
+	switch(take_bits(2)) {
+	case 0:
+	{
+		// the length follows at the next byte boundary, give the whole
+		// bytes in the bit buffer back to the input
+		take_bits(_n_bits & 7);
+		if(input_overrun())
+			return false;
+		_in -= _n_bits / 8 - _n_padding_bytes;
+		_bits = 0;
+		_n_bits = 0;
+		_n_padding_bytes = 0;
+		if(_in_end - _in < 4)
+			return false;
+		std::uint16_t length;
+		std::uint16_t inverted_length;
+		std::memcpy(&length, _in, 2);
+		std::memcpy(&inverted_length, _in + 2, 2);
+		_in += 4;
+		if(length != static_cast<std::uint16_t>(~inverted_length))
+			return false;
+		_stored_remaining = length;
+		_state = State::stored;
+		return true;
+	}
+	case 1:
+		if(!_has_fixed_tables) {
+			std::array<std::uint8_t, 288> literal_lengths;
+			std::fill(literal_lengths.begin(), literal_lengths.begin() + 144, std::uint8_t(8));
+			std::fill(literal_lengths.begin() + 144, literal_lengths.begin() + 256, std::uint8_t(9));
+			std::fill(literal_lengths.begin() + 256, literal_lengths.begin() + 280, std::uint8_t(7));
+			std::fill(literal_lengths.begin() + 280, literal_lengths.end(), std::uint8_t(8));
+			std::array<std::uint8_t, 30> distance_lengths;
+			distance_lengths.fill(5);
+			build_table(literal_lengths, literal_primary_bits, &_literal_table);
+			build_table(distance_lengths, distance_primary_bits, &_distance_table);
+			_has_fixed_tables = true;
+		}
+		_state = State::huffman;
+		return !input_overrun();
+	case 2:
+		_has_fixed_tables = false;
+		if(!read_dynamic_tables())
+			return false;
+		_state = State::huffman;
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool Inflater::read_dynamic_tables() {
+	refill_bits();
+	unsigned const n_literal_codes = take_bits(5) + 257;
+	unsigned const n_distance_codes = take_bits(5) + 1;
+	unsigned const n_code_length_codes = take_bits(4) + 4;
+	if(n_literal_codes > 286 || n_distance_codes > 30)
+		return false;
+
+	std::array<std::uint8_t, 19> code_length_lengths {};
+	for(unsigned i = 0; i < n_code_length_codes; ++i) {
+		refill_bits();
+		code_length_lengths[code_length_order[i]] = static_cast<std::uint8_t>(take_bits(3));
+	}
+	detail::HuffmanTable code_length_table;
+	if(!build_table(code_length_lengths, code_length_primary_bits, &code_length_table))
+		return false;
+
+	std::array<std::uint8_t, 286 + 30> lengths {};
+	unsigned const n_lengths = n_literal_codes + n_distance_codes;
+	for(unsigned i = 0; i < n_lengths;) {
+		refill_bits();
+		int const symbol = decode_symbol(code_length_table);
+		if(symbol < 0)
+			return false;
+		if(symbol < 16) {
+			lengths[i++] = static_cast<std::uint8_t>(symbol);
+			continue;
+		}
+		std::uint8_t value = 0;
+		unsigned repeat = 0;
+		if(symbol == 16) {
+			if(i == 0)
+				return false;
+			value = lengths[i - 1];
+			repeat = 3 + take_bits(2);
+		} else if(symbol == 17) {
+			repeat = 3 + take_bits(3);
+		} else {
+			repeat = 11 + take_bits(7);
+		}
+		if(i + repeat > n_lengths)
+			return false;
+		std::fill_n(lengths.begin() + i, repeat, value);
+		i += repeat;
+	}
+	if(input_overrun() || lengths[256] == 0)
+		return false;
+
+	std::span<std::uint8_t const> const all_lengths(lengths.data(), n_lengths);
+	return build_table(all_lengths.first(n_literal_codes), literal_primary_bits, &_literal_table)
+	       && build_table(all_lengths.subspan(n_literal_codes), distance_primary_bits, &_distance_table);
+}
+
+void Inflater::decode_stored() {
+	std::size_t const space = window_size - static_cast<std::size_t>(_write_position - _read_position);
+	std::size_t const offset = static_cast<std::size_t>(_write_position & window_mask);
+	std::size_t const n = std::min({
+		static_cast<std::size_t>(_stored_remaining),
+		static_cast<std::size_t>(_in_end - _in),
+		space,
+		window_size - offset
+	});
+	if(n == 0 && _stored_remaining != 0) {
+		// truncated
+		_state = State::error;
+		return;
+	}
+	std::memcpy(_window.get() + offset, _in, n);
+	_in += n;
+	_write_position += n;
+	_stored_remaining -= static_cast<std::uint32_t>(n);
+	if(_stored_remaining == 0)
+		_state = _is_final_block ? State::done : State::block_header;
+}
+
+void Inflater::decode_huffman() {
+	std::byte* const window = _window.get();
+	while(window_size - (_write_position - _read_position) >= max_match_length) {
+		// enough bits for a length and a distance code with their extra bits
+		refill_bits();
+		int const symbol = decode_symbol(_literal_table);
+		if(symbol < 256) {
+			if(symbol < 0 || input_overrun()) {
+				_state = State::error;
+				return;
+			}
+			window[_write_position++ & window_mask] = static_cast<std::byte>(symbol);
+			continue;
+		}
+		if(symbol == 256) {
+			_state = _is_final_block ? State::done : State::block_header;
+			if(input_overrun())
+				_state = State::error;
+			return;
+		}
+		std::size_t const length_index = static_cast<std::size_t>(symbol - 257);
+		if(length_index >= std::size(length_base)) {
+			_state = State::error;
+			return;
+		}
+		std::size_t const length = length_base[length_index] + take_bits(length_extra_bits[length_index]);
+		int const distance_symbol = decode_symbol(_distance_table);
+		if(distance_symbol < 0 || distance_symbol >= static_cast<int>(std::size(distance_base))) {
+			_state = State::error;
+			return;
+		}
+		std::size_t const distance = distance_base[distance_symbol] + take_bits(distance_extra_bits[distance_symbol]);
+		if(distance > _write_position || input_overrun()) {
+			_state = State::error;
+			return;
+		}
+
+		std::size_t const to = static_cast<std::size_t>(_write_position & window_mask);
+		std::size_t const from = static_cast<std::size_t>((_write_position - distance) & window_mask);
+		if(distance >= length && to + length <= window_size && from + length <= window_size) {
+			std::memcpy(window + to, window + from, length);
+		} else {
+			// overlapping copies repeat the last distance bytes
+			for(std::size_t i = 0; i < length; ++i) {
+				window[(to + i) & window_mask] = window[(from + i) & window_mask];
+			}
+		}
+		_write_position += length;
+	}
+}
+
+void Inflater::refill_bits() noexcept {
+	if(_in_end - _in >= 8) {
+		// Loads 8 bytes and keeps the whole ones that fit. Bits above
+		// _n_bits are the following input, the next refill writes the same
+		// values over them.
+		std::uint64_t word;
+		std::memcpy(&word, _in, sizeof(word)); // little endian
+		_bits |= word << _n_bits;
+		_in += (63 - _n_bits) >> 3;
+		_n_bits |= 56;
+		return;
+	}
+	while(_n_bits <= 56) {
+		if(_in < _in_end) {
+			_bits |= std::uint64_t(static_cast<std::uint8_t>(*_in++)) << _n_bits;
+		} else {
+			++_n_padding_bytes;
+		}
+		_n_bits += 8;
+	}
+}
+
+std::uint32_t Inflater::take_bits(unsigned n) noexcept {
+	auto const value = static_cast<std::uint32_t>(_bits & ((std::uint64_t(1) << n) - 1));
+	_bits >>= n;
+	_n_bits -= n;
+	return value;
+}
+
+int Inflater::decode_symbol(detail::HuffmanTable const& table) noexcept {
+	std::uint32_t entry = table.entries[_bits & ((std::uint64_t(1) << table.primary_bits) - 1)];
+	if(entry & subtable_flag) {
+		unsigned const subtable_bits = (entry >> 16) & 0xFFU;
+		std::size_t const index = (_bits >> table.primary_bits) & ((std::uint64_t(1) << subtable_bits) - 1);
+		entry = table.entries[(entry & 0xFFFFU) + index];
+	}
+	unsigned const length = (entry >> 16) & 0xFFU;
+	if(length == 0)
+		return -1;
+	_bits >>= length;
+	_n_bits -= length;
+	return static_cast<int>(entry & 0xFFFFU);
+}
+
+bool Inflater::input_overrun() const noexcept {
+	// some of the padding zeros were used as input
+	return _n_padding_bytes * 8 > _n_bits;
+}
+
+}
@@ -0,0 +1,141 @@
+#include "flp_mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <cstdint>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+
+namespace Om {
+
+#ifdef _WIN32
+
+std::error_code MappedFile::open(std::filesystem::path const& path) noexcept {
+	close();
+
+	HANDLE const file = ::CreateFileW(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr
+	);
+	if(file == INVALID_HANDLE_VALUE) {
+		return { std::error_code(::GetLastError(), std::system_category()) };
+	}
+
+	LARGE_INTEGER file_size;
+	if(!::GetFileSizeEx(file, &file_size)) {
+		std::error_code err(::GetLastError(), std::system_category());
+		::CloseHandle(file);
+		return err;
+	}
+	if(file_size.QuadPart == 0) {
+		::CloseHandle(file);
+		return {};
+	}
+	if(static_cast<unsigned long long>(file_size.QuadPart) > SIZE_MAX) {
+		::CloseHandle(file);
+		return std::make_error_code(std::errc::file_too_large);
+	}
+
+	HANDLE const mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(mapping == nullptr) {
+		std::error_code err(::GetLastError(), std::system_category());
+		::CloseHandle(file);
+		return err;
+	}
+
+	void const* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	std::error_code err;
+	if(view == nullptr) {
+		err = std::error_code(::GetLastError(), std::system_category());
+	}
+	// the view keeps the mapping alive
+	::CloseHandle(mapping);
+	::CloseHandle(file);
+	if(err) {
+		return err;
+	}
+
+	_data = view;
+	_size = static_cast<std::size_t>(file_size.QuadPart);
+	return {};
+}
+
+void MappedFile::close() noexcept {
+	if(_data) {
+		BOOL const ret = ::UnmapViewOfFile(_data);
+		static_cast<void>(ret);
+		_data = nullptr;
+	}
+	_size = 0;
+}
+
+#else
+
+std::error_code MappedFile::open(std::filesystem::path const& path) noexcept {
+	close();
+
+	int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd == -1) {
+		return { std::error_code(errno, std::generic_category()) };
+	}
+
+	struct stat st;
+	if(::fstat(fd, &st) != 0) {
+		std::error_code err(errno, std::generic_category());
+		::close(fd);
+		return err;
+	}
+	if(!S_ISREG(st.st_mode)) {
+		::close(fd);
+		return std::make_error_code(std::errc::not_supported);
+	}
+	if(st.st_size == 0) {
+		::close(fd);
+		return {};
+	}
+
+	std::size_t const size = static_cast<std::size_t>(st.st_size);
+	void* const view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	std::error_code err;
+	if(view == MAP_FAILED) {
+		err = std::error_code(errno, std::generic_category());
+	}
+	// the mapping stays valid after the descriptor is closed
+	::close(fd);
+	if(err) {
+		return err;
+	}
+
+	// events are decoded front to back
+	::madvise(view, size, MADV_SEQUENTIAL);
+
+	_data = view;
+	_size = size;
+	return {};
+}
+
+void MappedFile::close() noexcept {
+	if(_data) {
+		int const ret = ::munmap(const_cast<void*>(_data), _size);
+		static_cast<void>(ret);
+		_data = nullptr;
+	}
+	_size = 0;
+}
+
+#endif
+
+}
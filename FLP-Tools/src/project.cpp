@@ -0,0 +1,277 @@
+#include "flp_project.h"
+#include "flp_utf_conversions.h"
+
+#include <charconv>      // from_chars
+#include <cstring>       // memcpy
+#include <limits>        // numeric_limits
+#include <stdexcept>     // length_error
+#include <system_error>  // system_error
+
+
+namespace Om {
+
+namespace {
+
+	void check_pool_size(std::size_t size) {
+		if(size > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("FLP string pool too large");
+	}
+
+	template<typename T>
+	void grow_to(std::vector<T>& v, std::size_t size, T value) {
+		if(v.size() < size)
+			v.resize(size, value);
+	}
+
+	// fixed size records are copied out, payloads aren't aligned
+	template<typename Record, typename F>
+	void for_each_record(std::span<std::byte const> data, F f) {
+		std::size_t const n_records = data.size() / sizeof(Record);
+		for(std::size_t i = 0; i < n_records; ++i) {
+			Record record;
+			std::memcpy(&record, data.data() + i * sizeof(Record), sizeof(Record));
+			f(record);
+		}
+	}
+
+}
+
+FLPStringRef FLPStringPool::add(std::string_view str) {
+	check_pool_size(_chars.size() + str.size());
+	FLPStringRef const ref { static_cast<std::uint32_t>(_chars.size()), static_cast<std::uint32_t>(str.size()) };
+	_chars.append(str);
+	return ref;
+}
+
+FLPStringRef FLPStringPool::add_utf16(std::u16string_view str) {
+	// transcoded right into the pool
+	std::size_t const offset = _chars.size();
+	check_pool_size(offset + utf8_max_length(str.size()));
+	_chars.resize(offset + utf8_max_length(str.size()));
+	std::size_t n_chars = 0;
+	std::error_code const err = utf16_to_utf8(str, _chars.data() + offset, &n_chars);
+	_chars.resize(offset + n_chars);
+	if(err)
+		throw std::system_error(err);
+	return { static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(n_chars) };
+}
+
+FLPProjectBuilder::FLPProjectBuilder(FLPFileHeader const& header) {
+	_project.header = header;
+}
+
+FLPStringRef FLPProjectBuilder::add_string(FLPEventView const& e) {
+	// FLP_Version is never UTF-16
+	if(_major_version >= 12 && e.type != FLPEventType::FLP_Version) {
+		auto const* str = reinterpret_cast<char16_t const*>(e.data.data());
+		std::size_t len = e.data.size() / 2;
+		if(len > 0 && load_utf16_unit(str + len - 1) == u'\0')
+			--len;
+		return _project.strings.add_utf16(std::u16string_view(str, len));
+	}
+	auto const* str = reinterpret_cast<char const*>(e.data.data());
+	std::size_t len = e.data.size();
+	if(len > 0 && str[len - 1] == '\0')
+		--len;
+	return _project.strings.add(std::string_view(str, len));
+}
+
+FLPHandle FLPProjectBuilder::channel_handle(std::uint16_t index) {
+	grow_to(_channel_by_index, std::size_t(index) + 1, flp_no_handle);
+	FLPHandle& handle = _channel_by_index[index];
+	if(handle == flp_no_handle) {
+		FLPChannelTable& channels = _project.channels;
+		handle = static_cast<FLPHandle>(channels.size());
+		channels.index.push_back(index);
+		channels.type.push_back(0);
+		channels.name.push_back({});
+		channels.plugin.push_back({});
+		channels.sample_path.push_back({});
+		channels.mixer_insert.push_back(-1);
+	}
+	return handle;
+}
+
+FLPHandle FLPProjectBuilder::pattern_handle(std::uint16_t id) {
+	grow_to(_pattern_by_id, std::size_t(id) + 1, flp_no_handle);
+	FLPHandle& handle = _pattern_by_id[id];
+	if(handle == flp_no_handle) {
+		FLPPatternTable& patterns = _project.patterns;
+		handle = static_cast<FLPHandle>(patterns.size());
+		patterns.id.push_back(id);
+		patterns.name.push_back({});
+		patterns.color.push_back(0);
+		patterns.n_notes.push_back(0);
+	}
+	return handle;
+}
+
+// inserts are numbered by their position, each one ends with FLP_FXOutChanNum
+FLPHandle FLPProjectBuilder::current_insert() {
+	_section = Section::mixer;
+	FLPInsertTable& inserts = _project.inserts;
+	std::size_t const size = std::size_t(_insert) + 1;
+	grow_to(inserts.name, size, FLPStringRef {});
+	grow_to(inserts.color, size, std::uint32_t(0));
+	grow_to(inserts.input, size, std::int32_t(-1));
+	grow_to(inserts.output, size, std::int32_t(-1));
+	return _insert;
+}
+
+void FLPProjectBuilder::add_event(FLPEventView const& e) {
+	FLPProject& p = _project;
+	switch(e.type) {
+	case FLPEventType::FLP_Version:
+	{
+		p.version = add_string(e);
+		std::string_view const version = p.string(p.version);
+		std::from_chars(version.data(), version.data() + version.size(), _major_version);
+		break;
+	}
+	case FLPEventType::FLP_Text_Title:
+		p.title = add_string(e);
+		break;
+	case FLPEventType::FLP_Text_Author:
+		p.author = add_string(e);
+		break;
+	case FLPEventType::FLP_Text_Genre:
+		p.genre = add_string(e);
+		break;
+	case FLPEventType::FLP_FineTempo:
+		p.tempo = static_cast<std::uint32_t>(e.i32);
+		_has_fine_tempo = true;
+		break;
+	case FLPEventType::FLP_Tempo:
+		if(!_has_fine_tempo)
+			p.tempo = static_cast<std::uint32_t>(static_cast<std::uint16_t>(e.i16)) * 1000;
+		break;
+
+	// channels
+	case FLPEventType::FLP_NewChan:
+		_section = Section::channel;
+		_channel = channel_handle(static_cast<std::uint16_t>(e.i16));
+		break;
+	case FLPEventType::FLP_ChanType:
+		if(_section == Section::channel)
+			p.channels.type[_channel] = e.u8;
+		break;
+	case FLPEventType::FLP_TargetFXTrack:
+		if(_section == Section::channel)
+			p.channels.mixer_insert[_channel] = e.u8;
+		break;
+	case FLPEventType::FLP_Text_ChanName:
+		if(_section == Section::channel)
+			p.channels.name[_channel] = add_string(e);
+		break;
+	case FLPEventType::FLP_Text_SampleFileName:
+		if(_section == Section::channel)
+			p.channels.sample_path[_channel] = add_string(e);
+		break;
+	// in the mixer these name the effect plugins
+	case FLPEventType::FLP_Text_PluginName:
+		if(_section == Section::channel)
+			p.channels.name[_channel] = add_string(e);
+		break;
+	case FLPEventType::FLP_Text_DefPluginName:
+		if(_section == Section::channel)
+			p.channels.plugin[_channel] = add_string(e);
+		break;
+
+	// patterns
+	case FLPEventType::FLP_NewPat:
+		_section = Section::pattern;
+		_pattern = pattern_handle(static_cast<std::uint16_t>(e.i16));
+		break;
+	case FLPEventType::FLP_Text_PatName:
+		if(_section == Section::pattern)
+			p.patterns.name[_pattern] = add_string(e);
+		break;
+	case FLPEventType::FLP_PatColor:
+		if(_section == Section::pattern)
+			p.patterns.color[_pattern] = static_cast<std::uint32_t>(e.i32);
+		break;
+	case FLPEventType::FLP_PatNoteRecChan:
+	{
+		if(_section != Section::pattern)
+			break;
+		FLPNoteTable& notes = p.notes;
+		for_each_record<FLPPatternNoteRecord>(e.data, [&](FLPPatternNoteRecord const& note) {
+			notes.pattern.push_back(_pattern);
+			notes.position.push_back(note.position);
+			notes.length.push_back(note.length);
+			notes.key.push_back(note.key);
+			notes.velocity.push_back(note.velocity);
+			notes.pan.push_back(note.pan);
+			notes.fine_pitch.push_back(note.fine_pitch);
+			_note_rack_channels.push_back(note.rack_channel);
+			++p.patterns.n_notes[_pattern];
+		});
+		break;
+	}
+
+	// mixer
+	case FLPEventType::FLP_FXParams:
+	case FLPEventType::FLP_FXRouting:
+		current_insert();
+		break;
+	case FLPEventType::FLP_Text_FXName:
+		p.inserts.name[current_insert()] = add_string(e);
+		break;
+	case FLPEventType::FLP_FXColor:
+		p.inserts.color[current_insert()] = static_cast<std::uint32_t>(e.i32);
+		break;
+	case FLPEventType::FLP_FXInChanNum:
+		p.inserts.input[current_insert()] = e.i32;
+		break;
+	case FLPEventType::FLP_FXOutChanNum:
+		p.inserts.output[current_insert()] = e.i32;
+		++_insert;
+		break;
+
+	// playlist
+	case FLPEventType::FLP_PLRecChan:
+	{
+		FLPPlaylistTable& playlist = p.playlist;
+		for_each_record<FLPPlaylistClipRecord>(e.data, [&](FLPPlaylistClipRecord const& clip) {
+			playlist.position.push_back(clip.position);
+			playlist.length.push_back(clip.duration);
+			// FL 20 counts tracks from the bottom
+			playlist.track.push_back(_major_version >= 20 && clip.lane_index <= 499
+				? static_cast<std::uint16_t>(499 - clip.lane_index) : clip.lane_index);
+			// sources above the pattern base are patterns, the others channels
+			bool const is_pattern = clip.source_index > clip.data0;
+			playlist.source_kind.push_back(is_pattern ? FLPPlaylistSource::pattern : FLPPlaylistSource::channel);
+			playlist.source.push_back(flp_no_handle);
+			playlist.muted.push_back((static_cast<std::uint8_t>(clip.flags) & 0x40) != 0);
+			_playlist_source_ids.push_back(is_pattern
+				? static_cast<std::uint16_t>(clip.source_index - clip.data0) : clip.source_index);
+		});
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+FLPProject FLPProjectBuilder::finish() {
+	auto lookup = [](std::vector<FLPHandle> const& handles, std::uint16_t id) {
+		return id < handles.size() ? handles[id] : flp_no_handle;
+	};
+
+	FLPNoteTable& notes = _project.notes;
+	notes.channel.resize(notes.size());
+	for(std::size_t i = 0; i < notes.size(); ++i) {
+		notes.channel[i] = lookup(_channel_by_index, _note_rack_channels[i]);
+	}
+
+	FLPPlaylistTable& playlist = _project.playlist;
+	for(std::size_t i = 0; i < playlist.size(); ++i) {
+		playlist.source[i] = playlist.source_kind[i] == FLPPlaylistSource::pattern
+			? lookup(_pattern_by_id, _playlist_source_ids[i])
+			: lookup(_channel_by_index, _playlist_source_ids[i]);
+	}
+
+	return std::move(_project);
+}
+
+}
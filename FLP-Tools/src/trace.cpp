@@ -0,0 +1,47 @@
+#include "flp_trace.h"
+
+#include <mutex>         // mutex, lock_guard
+#include <new>           // bad_alloc
+
+
+namespace Om {
+
+namespace {
+
+	std::mutex& registry_mutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	// buffers stay alive after their thread exited so that it can be joined
+	// before dumping, they are freed at exit
+	std::vector<std::unique_ptr<TraceBuffer>>& registry() {
+		static std::vector<std::unique_ptr<TraceBuffer>> buffers;
+		return buffers;
+	}
+}
+
+namespace detail {
+
+	TraceBuffer* register_trace_buffer() noexcept {
+		try {
+			std::lock_guard<std::mutex> lock(registry_mutex());
+			auto& buffers = registry();
+			buffers.push_back(std::make_unique<TraceBuffer>(static_cast<std::uint32_t>(buffers.size() + 1)));
+			return buffers.back().get();
+		} catch(std::bad_alloc const&) {
+			return nullptr;
+		}
+	}
+}
+
+std::vector<TraceBuffer const*> trace_buffers() {
+	std::lock_guard<std::mutex> lock(registry_mutex());
+	std::vector<TraceBuffer const*> buffers;
+	for(auto const& buffer : registry()) {
+		buffers.push_back(buffer.get());
+	}
+	return buffers;
+}
+
+}
@@ -1,50 +1,255 @@
 #include "flp_utf_conversions.h"
+#include "flp_cpu_features.h"
 
-#define WIN32_LEAN_AND_MEAN
-#define NOMINMAX
-#include <Windows.h>
+#include <cstdint>       // uint32_t, uint64_t
+#include <cstring>       // memcpy
+
+#if OM_ARCH_X86
+#include <immintrin.h>
+#endif
 
 
 namespace Om {
 
+namespace {
 
-std::error_code utf16_to_utf8(std::wstring_view strv16, std::string* out_strutf8) {
-	if(strv16.size() >= std::size_t(INT_MAX)) {
-		return std::make_error_code(std::errc::invalid_argument);
+	constexpr bool is_surrogate(char16_t c) noexcept {
+		return (c & 0xF800) == 0xD800;
 	}
-	wchar_t const* const wstr = strv16.data();
-	int const isize = static_cast<int>(strv16.size());
-	if(isize == 0) {
-		return {};
+
+	// code points below 0x10000 that are not surrogates
+	inline void encode_bmp(char16_t c, char*& out) noexcept {
+		if(c < 0x80) {
+			*out++ = static_cast<char>(c);
+		} else if(c < 0x800) {
+			out[0] = static_cast<char>(0xC0 | (c >> 6));
+			out[1] = static_cast<char>(0x80 | (c & 0x3F));
+			out += 2;
+		} else {
+			out[0] = static_cast<char>(0xE0 | (c >> 12));
+			out[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+			out[2] = static_cast<char>(0x80 | (c & 0x3F));
+			out += 3;
+		}
+	}
+
+	// encodes the code point that starts at in, returns false for an unpaired surrogate
+	inline bool encode_code_point(char16_t const*& in, char16_t const* end, char*& out) noexcept {
+		char16_t const c = load_utf16_unit(in);
+		if(!is_surrogate(c)) {
+			encode_bmp(c, out);
+			++in;
+			return true;
+		}
+		if(!is_utf16_high_surrogate(c) || end - in < 2)
+			return false;
+		char16_t const low = load_utf16_unit(in + 1);
+		if((low & 0xFC00) != 0xDC00)
+			return false;
+		std::uint32_t const cp = 0x10000 + ((std::uint32_t(c) - 0xD800) << 10) + (std::uint32_t(low) - 0xDC00);
+		out[0] = static_cast<char>(0xF0 | (cp >> 18));
+		out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+		out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+		out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+		out += 4;
+		in += 2;
+		return true;
+	}
+
+	// Kernels convert until end or the first unpaired surrogate and return
+	// where they stopped, *out is advanced past the chars written.
+	using UTF16Kernel = char16_t const* (*)(char16_t const* in, char16_t const* end, char** out);
+
+	char16_t const* utf16_to_utf8_scalar(char16_t const* in, char16_t const* end, char** out) noexcept {
+		char* o = *out;
+		while(in != end && encode_code_point(in, end, o)) {
+		}
+		*out = o;
+		return in;
+	}
+
+#if OM_ARCH_X86
+	// Blocks of ASCII are narrowed with one pack, blocks without surrogates
+	// skip the pair checks. Only blocks with surrogates take the slow path,
+	// a pair may continue into the next block there.
+
+	// SSE2 is part of x86-64 and the default for x86 builds
+	char16_t const* utf16_to_utf8_sse2(char16_t const* in, char16_t const* end, char** out) noexcept {
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const non_ascii_bits = _mm_set1_epi16(static_cast<short>(0xFF80));
+		__m128i const surrogate_mask = _mm_set1_epi16(static_cast<short>(0xF800));
+		__m128i const surrogate_bits = _mm_set1_epi16(static_cast<short>(0xD800));
+		char* o = *out;
+		while(end - in >= 8) {
+			__m128i const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+			if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, non_ascii_bits), zero)) == 0xFFFF) {
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(o), _mm_packus_epi16(v, v));
+				in += 8;
+				o += 8;
+			} else if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, surrogate_mask), surrogate_bits)) == 0) {
+				for(int i = 0; i < 8; ++i) {
+					encode_bmp(load_utf16_unit(in + i), o);
+				}
+				in += 8;
+			} else {
+				char16_t const* const block_end = in + 8;
+				while(in < block_end) {
+					if(!encode_code_point(in, end, o)) {
+						*out = o;
+						return in;
+					}
+				}
+			}
+		}
+		*out = o;
+		return utf16_to_utf8_scalar(in, end, out);
+	}
+
+	OM_TARGET("avx2")
+	char16_t const* utf16_to_utf8_avx2(char16_t const* in, char16_t const* end, char** out) noexcept {
+		__m256i const zero = _mm256_setzero_si256();
+		__m256i const non_ascii_bits = _mm256_set1_epi16(static_cast<short>(0xFF80));
+		__m256i const surrogate_mask = _mm256_set1_epi16(static_cast<short>(0xF800));
+		__m256i const surrogate_bits = _mm256_set1_epi16(static_cast<short>(0xD800));
+		char* o = *out;
+		while(end - in >= 16) {
+			__m256i const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in));
+			if(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(v, non_ascii_bits), zero)) == -1) {
+				__m128i const narrow = _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(o), narrow);
+				in += 16;
+				o += 16;
+			} else if(_mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_and_si256(v, surrogate_mask), surrogate_bits)) == 0) {
+				for(int i = 0; i < 16; ++i) {
+					encode_bmp(load_utf16_unit(in + i), o);
+				}
+				in += 16;
+			} else {
+				char16_t const* const block_end = in + 16;
+				while(in < block_end) {
+					if(!encode_code_point(in, end, o)) {
+						*out = o;
+						return in;
+					}
+				}
+			}
+		}
+		*out = o;
+		return utf16_to_utf8_sse2(in, end, out);
 	}
-	int const chars_needed = ::WideCharToMultiByte(
-		CP_UTF8,
-		WC_ERR_INVALID_CHARS,
-		wstr, isize,
-		nullptr, 0,
-		nullptr, nullptr
-	);
-	if(chars_needed == 0) {
-		return { std::error_code(::GetLastError(), std::system_category()) };
+#endif
+
+	UTF16Kernel select_utf16_kernel([[maybe_unused]] CPUFeatures const& features) noexcept {
+#if OM_ARCH_X86
+		if(features.avx2)
+			return utf16_to_utf8_avx2;
+		return utf16_to_utf8_sse2;
+#else
+		return utf16_to_utf8_scalar;
+#endif
 	}
 
-	std::string utf8_str(std::size_t(chars_needed), '\0');
+	std::error_code invalid_sequence() noexcept {
+		return std::make_error_code(std::errc::illegal_byte_sequence);
+	}
 
-	int const chars_written = ::WideCharToMultiByte(
-		CP_UTF8,
-		WC_ERR_INVALID_CHARS,
-		wstr, isize,
-		utf8_str.data(), chars_needed,
-		nullptr, nullptr
-	);
-	if(chars_written == 0 || chars_written != chars_needed) {
-		return { std::error_code(::GetLastError(), std::system_category()) };
+	std::error_code convert_utf16(UTF16Kernel kernel, std::u16string_view str16, char* out, std::size_t* n_written) noexcept {
+		char16_t const* const end = str16.data() + str16.size();
+		char* o = out;
+		char16_t const* const stop = kernel(str16.data(), end, &o);
+		*n_written = static_cast<std::size_t>(o - out);
+		if(stop != end)
+			return invalid_sequence();
+		return {};
 	}
 
-	utf8_str.resize(chars_written);
+}
+
+std::error_code utf16_to_utf8(std::u16string_view str16, char* out, std::size_t* n_written) noexcept {
+	static UTF16Kernel const kernel = select_utf16_kernel(cpu_features());
+	return convert_utf16(kernel, str16, out, n_written);
+}
+
+std::error_code utf16_to_utf8(std::u16string_view str16, char* out, std::size_t* n_written,
+                              CPUFeatures const& features) noexcept {
+	return convert_utf16(select_utf16_kernel(features), str16, out, n_written);
+}
 
+std::error_code utf16_to_utf8(std::u16string_view str16, std::string* out_strutf8) {
+	std::string utf8_str(utf8_max_length(str16.size()), '\0');
+	std::size_t n_written = 0;
+	if(std::error_code err = utf16_to_utf8(str16, utf8_str.data(), &n_written))
+		return err;
+	utf8_str.resize(n_written);
 	*out_strutf8 = std::move(utf8_str);
-	return std::error_code();
+	return {};
+}
+
+std::error_code utf8_to_utf16(std::string_view strutf8, std::u16string* out_str16) {
+	// never more code units than bytes
+	std::u16string utf16_str(strutf8.size(), u'\0');
+	auto const* p = reinterpret_cast<unsigned char const*>(strutf8.data());
+	auto const* const end = p + strutf8.size();
+	char16_t* o = utf16_str.data();
+	while(p != end) {
+		// ASCII eight bytes at a time
+		if(end - p >= 8) {
+			std::uint64_t word;
+			std::memcpy(&word, p, 8);
+			if((word & 0x8080808080808080U) == 0) {
+				for(int i = 0; i < 8; ++i) {
+					o[i] = p[i];
+				}
+				p += 8;
+				o += 8;
+				continue;
+			}
+		}
+		std::uint32_t cp = *p;
+		if(cp < 0x80) {
+			*o++ = static_cast<char16_t>(cp);
+			++p;
+			continue;
+		}
+		int n_bytes;
+		std::uint32_t min_cp;
+		if((cp & 0xE0) == 0xC0) {
+			n_bytes = 2;
+			cp &= 0x1F;
+			min_cp = 0x80;
+		} else if((cp & 0xF0) == 0xE0) {
+			n_bytes = 3;
+			cp &= 0x0F;
+			min_cp = 0x800;
+		} else if((cp & 0xF8) == 0xF0) {
+			n_bytes = 4;
+			cp &= 0x07;
+			min_cp = 0x10000;
+		} else {
+			return invalid_sequence();
+		}
+		if(end - p < n_bytes)
+			return invalid_sequence();
+		for(int i = 1; i < n_bytes; ++i) {
+			if((p[i] & 0xC0) != 0x80)
+				return invalid_sequence();
+			cp = (cp << 6) | (p[i] & 0x3F);
+		}
+		// overlong forms, surrogates and values beyond Unicode
+		if(cp < min_cp || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+			return invalid_sequence();
+		p += n_bytes;
+		if(cp >= 0x10000) {
+			cp -= 0x10000;
+			*o++ = static_cast<char16_t>(0xD800 + (cp >> 10));
+			*o++ = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+		} else {
+			*o++ = static_cast<char16_t>(cp);
+		}
+	}
+	utf16_str.resize(static_cast<std::size_t>(o - utf16_str.data()));
+	*out_str16 = std::move(utf16_str);
+	return {};
 }
 
 }
@@ -0,0 +1,226 @@
+#include "flp_zip.h"
+#include "flp_hash.h"
+#include "flp_trace.h"
+
+#include <algorithm>     // min, find_if
+#include <stdexcept>     // runtime_error
+#include <string_view>   // string_view
+#include <system_error>  // system_error
+
+
+namespace Om {
+
+namespace {
+
+	constexpr std::uint32_t local_header_signature = 0x04034B50;
+	constexpr std::uint32_t central_header_signature = 0x02014B50;
+	constexpr std::uint32_t end_of_directory_signature = 0x06054B50;
+	constexpr std::uint32_t zip64_end_of_directory_signature = 0x06064B50;
+	constexpr std::uint32_t zip64_locator_signature = 0x07064B50;
+	constexpr std::uint16_t zip64_extra_field_id = 0x0001;
+
+	constexpr std::size_t local_header_size = 30;
+	constexpr std::size_t central_header_size = 46;
+	constexpr std::size_t end_of_directory_size = 22;
+	constexpr std::size_t zip64_end_of_directory_size = 56;
+	constexpr std::size_t zip64_locator_size = 20;
+	constexpr std::size_t max_comment_size = 0xFFFF;
+
+	constexpr std::uint16_t flag_encrypted = 0x0001;
+	constexpr std::uint16_t method_stored = 0;
+	constexpr std::uint16_t method_deflate = 8;
+
+	// all fields are little endian
+	template<typename T>
+	T read(std::byte const* p) noexcept {
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		return value;
+	}
+
+	// Replaces the 32 bit fields set to 0xFFFFFFFF by their values in the
+	// zip64 extra field, which has them in this order.
+	bool read_zip64_extra_field(std::span<std::byte const> extra, ZipEntry* entry) {
+		while(extra.size() >= 4) {
+			auto const id = read<std::uint16_t>(extra.data());
+			auto const size = read<std::uint16_t>(extra.data() + 2);
+			if(extra.size() - 4 < size)
+				return false;
+			std::span<std::byte const> data = extra.subspan(4, size);
+			extra = extra.subspan(4 + std::size_t(size));
+			if(id != zip64_extra_field_id)
+				continue;
+			for(std::uint64_t* field : { &entry->uncompressed_size, &entry->compressed_size, &entry->local_header_offset }) {
+				if(*field != 0xFFFFFFFFU)
+					continue;
+				if(data.size() < 8)
+					return false;
+				*field = read<std::uint64_t>(data.data());
+				data = data.subspan(8);
+			}
+			return true;
+		}
+		return true;
+	}
+
+	// the .flp file of a loop package, macOS resource forks are skipped
+	bool is_project_entry(std::string const& name) {
+		constexpr std::string_view extension = ".flp";
+		if(name.size() < extension.size() || name.starts_with("__MACOSX/"))
+			return false;
+		for(std::size_t i = 0; i < extension.size(); ++i) {
+			char c = name[name.size() - extension.size() + i];
+			if(c >= 'A' && c <= 'Z')
+				c = static_cast<char>(c - 'A' + 'a');
+			if(c != extension[i])
+				return false;
+		}
+		return true;
+	}
+}
+
+std::optional<std::vector<ZipEntry>> read_zip_directory(std::span<std::byte const> archive) {
+	if(archive.size() < end_of_directory_size)
+		return std::nullopt;
+
+	// the end record is followed by a comment of up to 64 KiB
+	std::size_t end_offset = archive.size() - end_of_directory_size;
+	std::size_t const search_limit = end_offset > max_comment_size ? end_offset - max_comment_size : 0;
+	while(read<std::uint32_t>(archive.data() + end_offset) != end_of_directory_signature) {
+		if(end_offset == search_limit)
+			return std::nullopt;
+		--end_offset;
+	}
+	std::byte const* const end_record = archive.data() + end_offset;
+	std::uint64_t n_entries = read<std::uint16_t>(end_record + 10);
+	std::uint64_t directory_size = read<std::uint32_t>(end_record + 12);
+	std::uint64_t directory_offset = read<std::uint32_t>(end_record + 16);
+
+	if(n_entries == 0xFFFF || directory_size == 0xFFFFFFFFU || directory_offset == 0xFFFFFFFFU) {
+		if(end_offset < zip64_locator_size)
+			return std::nullopt;
+		std::byte const* const locator = end_record - zip64_locator_size;
+		if(read<std::uint32_t>(locator) != zip64_locator_signature)
+			return std::nullopt;
+		std::uint64_t const zip64_offset = read<std::uint64_t>(locator + 8);
+		if(zip64_offset > archive.size() || archive.size() - zip64_offset < zip64_end_of_directory_size)
+			return std::nullopt;
+		std::byte const* const zip64_record = archive.data() + zip64_offset;
+		if(read<std::uint32_t>(zip64_record) != zip64_end_of_directory_signature)
+			return std::nullopt;
+		n_entries = read<std::uint64_t>(zip64_record + 32);
+		directory_size = read<std::uint64_t>(zip64_record + 40);
+		directory_offset = read<std::uint64_t>(zip64_record + 48);
+	}
+
+	if(directory_offset > archive.size() || archive.size() - directory_offset < directory_size)
+		return std::nullopt;
+	std::span<std::byte const> directory = archive.subspan(static_cast<std::size_t>(directory_offset), static_cast<std::size_t>(directory_size));
+	// every entry takes at least a fixed size header
+	if(n_entries > directory.size() / central_header_size)
+		return std::nullopt;
+
+	std::vector<ZipEntry> entries;
+	entries.reserve(static_cast<std::size_t>(n_entries));
+	for(std::uint64_t i = 0; i < n_entries; ++i) {
+		if(directory.size() < central_header_size)
+			return std::nullopt;
+		std::byte const* const header = directory.data();
+		if(read<std::uint32_t>(header) != central_header_signature)
+			return std::nullopt;
+		std::size_t const name_size = read<std::uint16_t>(header + 28);
+		std::size_t const extra_size = read<std::uint16_t>(header + 30);
+		std::size_t const comment_size = read<std::uint16_t>(header + 32);
+		std::size_t const header_size = central_header_size + name_size + extra_size + comment_size;
+		if(directory.size() < header_size)
+			return std::nullopt;
+
+		ZipEntry& entry = entries.emplace_back();
+		entry.flags = read<std::uint16_t>(header + 8);
+		entry.method = read<std::uint16_t>(header + 10);
+		entry.crc32 = read<std::uint32_t>(header + 16);
+		entry.compressed_size = read<std::uint32_t>(header + 20);
+		entry.uncompressed_size = read<std::uint32_t>(header + 24);
+		entry.local_header_offset = read<std::uint32_t>(header + 42);
+		entry.name.assign(reinterpret_cast<char const*>(header + central_header_size), name_size);
+		if(!read_zip64_extra_field(directory.subspan(central_header_size + name_size, extra_size), &entry))
+			return std::nullopt;
+		directory = directory.subspan(header_size);
+	}
+	return entries;
+}
+
+std::optional<std::span<std::byte const>> zip_entry_data(std::span<std::byte const> archive, ZipEntry const& entry) {
+	if(entry.local_header_offset > archive.size() || archive.size() - entry.local_header_offset < local_header_size)
+		return std::nullopt;
+	std::byte const* const header = archive.data() + entry.local_header_offset;
+	if(read<std::uint32_t>(header) != local_header_signature)
+		return std::nullopt;
+	// the local name and extra field may differ from the central directory's
+	std::uint64_t const data_offset = entry.local_header_offset + local_header_size
+	                                  + read<std::uint16_t>(header + 26) + read<std::uint16_t>(header + 28);
+	if(data_offset > archive.size() || archive.size() - data_offset < entry.compressed_size)
+		return std::nullopt;
+	return archive.subspan(static_cast<std::size_t>(data_offset), static_cast<std::size_t>(entry.compressed_size));
+}
+
+ZipInFile::ZipInFile(std::filesystem::path const& path, std::size_t buffer_size) :
+	_buffer { std::make_unique<std::byte[]>(buffer_size) },
+	_buffer_size { buffer_size } {
+	assert(buffer_size >= 16);
+	_position = _buffer.get();
+	_end = _buffer.get();
+
+	if(std::error_code err = _archive.open(path))
+		throw std::system_error(err);
+	std::optional<std::vector<ZipEntry>> entries = read_zip_directory(_archive.data());
+	if(!entries)
+		throw std::runtime_error("Not a zip file!");
+
+	auto const it = std::find_if(entries->begin(), entries->end(), [](ZipEntry const& entry) {
+		return is_project_entry(entry.name);
+	});
+	if(it == entries->end())
+		throw std::runtime_error("No .flp file in the zip archive!");
+	_entry = std::move(*it);
+	if(_entry.flags & flag_encrypted)
+		throw std::runtime_error("Encrypted zip archives are not supported!");
+	if(_entry.method != method_stored && _entry.method != method_deflate)
+		throw std::runtime_error("Unsupported zip compression method!");
+
+	std::optional<std::span<std::byte const>> const data = zip_entry_data(_archive.data(), _entry);
+	if(!data)
+		throw std::runtime_error("Damaged zip archive!");
+	if(_entry.method == method_deflate)
+		_inflater.emplace(*data);
+	else
+		_stored = *data;
+}
+
+std::size_t ZipInFile::decode(std::byte* out, std::size_t size) {
+	OM_TRACE_SPAN("inflate", "io");
+	if(_error || _is_complete)
+		return 0;
+
+	std::size_t n = 0;
+	if(_inflater) {
+		n = _inflater->read({ out, size });
+		_is_complete = n < size || _inflater->finished();
+	} else {
+		n = std::min(size, _stored.size());
+		std::memcpy(out, _stored.data(), n);
+		_stored = _stored.subspan(n);
+		_is_complete = _stored.empty();
+	}
+	_crc32 = crc32({ out, n }, _crc32);
+	_n_decoded += n;
+
+	if(_n_decoded > _entry.uncompressed_size
+	   || (_is_complete && (_n_decoded != _entry.uncompressed_size || _crc32 != _entry.crc32 || (_inflater && _inflater->error())))) {
+		_error = true;
+		return 0;
+	}
+	return n;
+}
+
+}